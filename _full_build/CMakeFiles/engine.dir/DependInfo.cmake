@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/engine/Figure.cpp" "CMakeFiles/engine.dir/engine/Figure.cpp.o" "gcc" "CMakeFiles/engine.dir/engine/Figure.cpp.o.d"
+  "/root/repo/engine/Line2D.cpp" "CMakeFiles/engine.dir/engine/Line2D.cpp.o" "gcc" "CMakeFiles/engine.dir/engine/Line2D.cpp.o.d"
+  "/root/repo/engine/Scene.cc" "CMakeFiles/engine.dir/engine/Scene.cc.o" "gcc" "CMakeFiles/engine.dir/engine/Scene.cc.o.d"
+  "/root/repo/engine/ZBuffer.cpp" "CMakeFiles/engine.dir/engine/ZBuffer.cpp.o" "gcc" "CMakeFiles/engine.dir/engine/ZBuffer.cpp.o.d"
+  "/root/repo/engine/easy_image.cc" "CMakeFiles/engine.dir/engine/easy_image.cc.o" "gcc" "CMakeFiles/engine.dir/engine/easy_image.cc.o.d"
+  "/root/repo/engine/ini_configuration.cc" "CMakeFiles/engine.dir/engine/ini_configuration.cc.o" "gcc" "CMakeFiles/engine.dir/engine/ini_configuration.cc.o.d"
+  "/root/repo/engine/l_parser/l_parser.cc" "CMakeFiles/engine.dir/engine/l_parser/l_parser.cc.o" "gcc" "CMakeFiles/engine.dir/engine/l_parser/l_parser.cc.o.d"
+  "/root/repo/engine/vector/vector3d.cc" "CMakeFiles/engine.dir/engine/vector/vector3d.cc.o" "gcc" "CMakeFiles/engine.dir/engine/vector/vector3d.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
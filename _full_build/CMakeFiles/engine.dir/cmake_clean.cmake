@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/engine.dir/engine/Figure.cpp.o"
+  "CMakeFiles/engine.dir/engine/Figure.cpp.o.d"
+  "CMakeFiles/engine.dir/engine/Line2D.cpp.o"
+  "CMakeFiles/engine.dir/engine/Line2D.cpp.o.d"
+  "CMakeFiles/engine.dir/engine/Scene.cc.o"
+  "CMakeFiles/engine.dir/engine/Scene.cc.o.d"
+  "CMakeFiles/engine.dir/engine/ZBuffer.cpp.o"
+  "CMakeFiles/engine.dir/engine/ZBuffer.cpp.o.d"
+  "CMakeFiles/engine.dir/engine/easy_image.cc.o"
+  "CMakeFiles/engine.dir/engine/easy_image.cc.o.d"
+  "CMakeFiles/engine.dir/engine/ini_configuration.cc.o"
+  "CMakeFiles/engine.dir/engine/ini_configuration.cc.o.d"
+  "CMakeFiles/engine.dir/engine/l_parser/l_parser.cc.o"
+  "CMakeFiles/engine.dir/engine/l_parser/l_parser.cc.o.d"
+  "CMakeFiles/engine.dir/engine/vector/vector3d.cc.o"
+  "CMakeFiles/engine.dir/engine/vector/vector3d.cc.o.d"
+  "libengine.a"
+  "libengine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/engine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,69 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/simulation_bench.dir/src/benchMain.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/benchMain.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/Allocator.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/Allocator.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/Lane.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/Lane.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/LaneKernel.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/LaneKernel.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/Network.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/Network.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/Road.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/Road.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/RoadScheduler.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/RoadScheduler.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/TrafficSigns.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/TrafficSigns.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/Bus.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/Bus.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/Car.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/Car.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/IVehicle.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/IVehicle.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/Motorcycle.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/Motorcycle.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/Truck.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/datatypes/vehicles/Truck.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/exporters/ExportPipeline.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/exporters/ExportPipeline.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/exporters/NetworkExporter.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/exporters/NetworkExporter.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/exporters/ReplayExporter.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/exporters/ReplayExporter.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/exporters/SnapshotExporter.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/exporters/SnapshotExporter.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/exporters/TrajectoryExporter.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/exporters/TrajectoryExporter.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/exporters/VehicleExporter.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/exporters/VehicleExporter.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/NetworkParser.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/NetworkParser.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/RoadParser.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/RoadParser.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/SnapshotParser.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/SnapshotParser.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/TrafficSignParser.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/TrafficSignParser.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/TrajectoryParser.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/TrajectoryParser.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/VAbstractParser.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/VAbstractParser.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/VehicleParser.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/VehicleParser.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/tinyxml/tinystr.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/tinyxml/tinystr.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/tinyxml/tinyxml.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/tinyxml/tinyxml.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/tinyxml/tinyxmlerror.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/tinyxml/tinyxmlerror.cpp.o.d"
+  "CMakeFiles/simulation_bench.dir/src/parsers/tinyxml/tinyxmlparser.cpp.o"
+  "CMakeFiles/simulation_bench.dir/src/parsers/tinyxml/tinyxmlparser.cpp.o.d"
+  "simulation_bench"
+  "simulation_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simulation_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
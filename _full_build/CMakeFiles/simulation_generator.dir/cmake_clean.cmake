@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/simulation_generator.dir/src/generatorMain.cpp.o"
+  "CMakeFiles/simulation_generator.dir/src/generatorMain.cpp.o.d"
+  "simulation_generator"
+  "simulation_generator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simulation_generator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,49 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/datatypes/Allocator.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/Allocator.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/Allocator.cpp.o.d"
+  "/root/repo/src/datatypes/Lane.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/Lane.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/Lane.cpp.o.d"
+  "/root/repo/src/datatypes/LaneKernel.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/LaneKernel.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/LaneKernel.cpp.o.d"
+  "/root/repo/src/datatypes/Network.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/Network.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/Network.cpp.o.d"
+  "/root/repo/src/datatypes/Road.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/Road.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/Road.cpp.o.d"
+  "/root/repo/src/datatypes/RoadScheduler.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/RoadScheduler.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/RoadScheduler.cpp.o.d"
+  "/root/repo/src/datatypes/TrafficSigns.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/TrafficSigns.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/TrafficSigns.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/Bus.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/Bus.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/Bus.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/Car.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/Car.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/Car.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/IVehicle.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/IVehicle.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/IVehicle.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/Motorcycle.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/Motorcycle.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/Motorcycle.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/Truck.cpp" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/Truck.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/datatypes/vehicles/Truck.cpp.o.d"
+  "/root/repo/src/exporters/ExportPipeline.cpp" "CMakeFiles/simulation_headless.dir/src/exporters/ExportPipeline.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/exporters/ExportPipeline.cpp.o.d"
+  "/root/repo/src/exporters/NetworkExporter.cpp" "CMakeFiles/simulation_headless.dir/src/exporters/NetworkExporter.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/exporters/NetworkExporter.cpp.o.d"
+  "/root/repo/src/exporters/ReplayExporter.cpp" "CMakeFiles/simulation_headless.dir/src/exporters/ReplayExporter.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/exporters/ReplayExporter.cpp.o.d"
+  "/root/repo/src/exporters/SnapshotExporter.cpp" "CMakeFiles/simulation_headless.dir/src/exporters/SnapshotExporter.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/exporters/SnapshotExporter.cpp.o.d"
+  "/root/repo/src/exporters/TrajectoryExporter.cpp" "CMakeFiles/simulation_headless.dir/src/exporters/TrajectoryExporter.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/exporters/TrajectoryExporter.cpp.o.d"
+  "/root/repo/src/exporters/VehicleExporter.cpp" "CMakeFiles/simulation_headless.dir/src/exporters/VehicleExporter.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/exporters/VehicleExporter.cpp.o.d"
+  "/root/repo/src/headlessMain.cpp" "CMakeFiles/simulation_headless.dir/src/headlessMain.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/headlessMain.cpp.o.d"
+  "/root/repo/src/parsers/NetworkParser.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/NetworkParser.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/NetworkParser.cpp.o.d"
+  "/root/repo/src/parsers/RoadParser.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/RoadParser.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/RoadParser.cpp.o.d"
+  "/root/repo/src/parsers/SnapshotParser.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/SnapshotParser.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/SnapshotParser.cpp.o.d"
+  "/root/repo/src/parsers/TrafficSignParser.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/TrafficSignParser.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/TrafficSignParser.cpp.o.d"
+  "/root/repo/src/parsers/TrajectoryParser.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/TrajectoryParser.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/TrajectoryParser.cpp.o.d"
+  "/root/repo/src/parsers/VAbstractParser.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/VAbstractParser.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/VAbstractParser.cpp.o.d"
+  "/root/repo/src/parsers/VehicleParser.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/VehicleParser.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/VehicleParser.cpp.o.d"
+  "/root/repo/src/parsers/tinyxml/tinystr.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/tinyxml/tinystr.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/tinyxml/tinystr.cpp.o.d"
+  "/root/repo/src/parsers/tinyxml/tinyxml.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/tinyxml/tinyxml.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/tinyxml/tinyxml.cpp.o.d"
+  "/root/repo/src/parsers/tinyxml/tinyxmlerror.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/tinyxml/tinyxmlerror.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/tinyxml/tinyxmlerror.cpp.o.d"
+  "/root/repo/src/parsers/tinyxml/tinyxmlparser.cpp" "CMakeFiles/simulation_headless.dir/src/parsers/tinyxml/tinyxmlparser.cpp.o" "gcc" "CMakeFiles/simulation_headless.dir/src/parsers/tinyxml/tinyxmlparser.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_full_build/CMakeFiles/engine.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,68 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/datatypes/Allocator.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/Allocator.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/Allocator.cpp.o.d"
+  "/root/repo/src/datatypes/Lane.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/Lane.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/Lane.cpp.o.d"
+  "/root/repo/src/datatypes/LaneKernel.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/LaneKernel.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/LaneKernel.cpp.o.d"
+  "/root/repo/src/datatypes/Network.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/Network.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/Network.cpp.o.d"
+  "/root/repo/src/datatypes/Road.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/Road.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/Road.cpp.o.d"
+  "/root/repo/src/datatypes/RoadScheduler.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/RoadScheduler.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/RoadScheduler.cpp.o.d"
+  "/root/repo/src/datatypes/TrafficSigns.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/TrafficSigns.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/TrafficSigns.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/Bus.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Bus.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Bus.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/Car.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Car.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Car.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/IVehicle.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/IVehicle.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/IVehicle.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/Motorcycle.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Motorcycle.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Motorcycle.cpp.o.d"
+  "/root/repo/src/datatypes/vehicles/Truck.cpp" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Truck.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Truck.cpp.o.d"
+  "/root/repo/src/exporters/ExportPipeline.cpp" "CMakeFiles/simulation_tests.dir/src/exporters/ExportPipeline.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/exporters/ExportPipeline.cpp.o.d"
+  "/root/repo/src/exporters/NetworkExporter.cpp" "CMakeFiles/simulation_tests.dir/src/exporters/NetworkExporter.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/exporters/NetworkExporter.cpp.o.d"
+  "/root/repo/src/exporters/ReplayExporter.cpp" "CMakeFiles/simulation_tests.dir/src/exporters/ReplayExporter.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/exporters/ReplayExporter.cpp.o.d"
+  "/root/repo/src/exporters/SnapshotExporter.cpp" "CMakeFiles/simulation_tests.dir/src/exporters/SnapshotExporter.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/exporters/SnapshotExporter.cpp.o.d"
+  "/root/repo/src/exporters/TrajectoryExporter.cpp" "CMakeFiles/simulation_tests.dir/src/exporters/TrajectoryExporter.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/exporters/TrajectoryExporter.cpp.o.d"
+  "/root/repo/src/exporters/VehicleExporter.cpp" "CMakeFiles/simulation_tests.dir/src/exporters/VehicleExporter.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/exporters/VehicleExporter.cpp.o.d"
+  "/root/repo/src/parsers/NetworkParser.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/NetworkParser.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/NetworkParser.cpp.o.d"
+  "/root/repo/src/parsers/RoadParser.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/RoadParser.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/RoadParser.cpp.o.d"
+  "/root/repo/src/parsers/SnapshotParser.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/SnapshotParser.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/SnapshotParser.cpp.o.d"
+  "/root/repo/src/parsers/TrafficSignParser.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/TrafficSignParser.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/TrafficSignParser.cpp.o.d"
+  "/root/repo/src/parsers/TrajectoryParser.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/TrajectoryParser.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/TrajectoryParser.cpp.o.d"
+  "/root/repo/src/parsers/VAbstractParser.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/VAbstractParser.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/VAbstractParser.cpp.o.d"
+  "/root/repo/src/parsers/VehicleParser.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/VehicleParser.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/VehicleParser.cpp.o.d"
+  "/root/repo/src/parsers/tinyxml/tinystr.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinystr.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinystr.cpp.o.d"
+  "/root/repo/src/parsers/tinyxml/tinyxml.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxml.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxml.cpp.o.d"
+  "/root/repo/src/parsers/tinyxml/tinyxmlerror.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxmlerror.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxmlerror.cpp.o.d"
+  "/root/repo/src/parsers/tinyxml/tinyxmlparser.cpp" "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxmlparser.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxmlparser.cpp.o.d"
+  "/root/repo/src/testMain.cpp" "CMakeFiles/simulation_tests.dir/src/testMain.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/testMain.cpp.o.d"
+  "/root/repo/src/tests/AbstractParserTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/AbstractParserTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/AbstractParserTester.cpp.o.d"
+  "/root/repo/src/tests/AllocatorTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/AllocatorTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/AllocatorTester.cpp.o.d"
+  "/root/repo/src/tests/CarTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/CarTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/CarTester.cpp.o.d"
+  "/root/repo/src/tests/ExportPipelineTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/ExportPipelineTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/ExportPipelineTester.cpp.o.d"
+  "/root/repo/src/tests/LaneKernelTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/LaneKernelTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/LaneKernelTester.cpp.o.d"
+  "/root/repo/src/tests/MotorcycleTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/MotorcycleTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/MotorcycleTester.cpp.o.d"
+  "/root/repo/src/tests/NetworkExporterTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/NetworkExporterTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/NetworkExporterTester.cpp.o.d"
+  "/root/repo/src/tests/NetworkParserTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/NetworkParserTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/NetworkParserTester.cpp.o.d"
+  "/root/repo/src/tests/NetworkTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/NetworkTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/NetworkTester.cpp.o.d"
+  "/root/repo/src/tests/ReplayTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/ReplayTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/ReplayTester.cpp.o.d"
+  "/root/repo/src/tests/RoadParserTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/RoadParserTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/RoadParserTester.cpp.o.d"
+  "/root/repo/src/tests/RoadTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/RoadTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/RoadTester.cpp.o.d"
+  "/root/repo/src/tests/SnapshotTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/SnapshotTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/SnapshotTester.cpp.o.d"
+  "/root/repo/src/tests/TrafficSignParserTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/TrafficSignParserTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/TrafficSignParserTester.cpp.o.d"
+  "/root/repo/src/tests/TrafficSignTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/TrafficSignTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/TrafficSignTester.cpp.o.d"
+  "/root/repo/src/tests/TrajectoryTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/TrajectoryTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/TrajectoryTester.cpp.o.d"
+  "/root/repo/src/tests/TruckTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/TruckTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/TruckTester.cpp.o.d"
+  "/root/repo/src/tests/Utils.cpp" "CMakeFiles/simulation_tests.dir/src/tests/Utils.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/Utils.cpp.o.d"
+  "/root/repo/src/tests/VehicleParserTester.cpp" "CMakeFiles/simulation_tests.dir/src/tests/VehicleParserTester.cpp.o" "gcc" "CMakeFiles/simulation_tests.dir/src/tests/VehicleParserTester.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_full_build/CMakeFiles/engine.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,107 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/simulation_tests.dir/src/datatypes/Allocator.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/Allocator.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/Lane.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/Lane.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/LaneKernel.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/LaneKernel.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/Network.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/Network.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/Road.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/Road.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/RoadScheduler.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/RoadScheduler.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/TrafficSigns.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/TrafficSigns.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Bus.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Bus.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Car.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Car.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/IVehicle.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/IVehicle.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Motorcycle.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Motorcycle.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Truck.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/datatypes/vehicles/Truck.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/exporters/ExportPipeline.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/exporters/ExportPipeline.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/exporters/NetworkExporter.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/exporters/NetworkExporter.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/exporters/ReplayExporter.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/exporters/ReplayExporter.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/exporters/SnapshotExporter.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/exporters/SnapshotExporter.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/exporters/TrajectoryExporter.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/exporters/TrajectoryExporter.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/exporters/VehicleExporter.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/exporters/VehicleExporter.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/NetworkParser.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/NetworkParser.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/RoadParser.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/RoadParser.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/SnapshotParser.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/SnapshotParser.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/TrafficSignParser.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/TrafficSignParser.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/TrajectoryParser.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/TrajectoryParser.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/VAbstractParser.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/VAbstractParser.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/VehicleParser.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/VehicleParser.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinystr.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinystr.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxml.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxml.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxmlerror.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxmlerror.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxmlparser.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/parsers/tinyxml/tinyxmlparser.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/testMain.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/testMain.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/AbstractParserTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/AbstractParserTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/AllocatorTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/AllocatorTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/CarTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/CarTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/ExportPipelineTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/ExportPipelineTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/LaneKernelTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/LaneKernelTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/MotorcycleTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/MotorcycleTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/NetworkExporterTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/NetworkExporterTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/NetworkParserTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/NetworkParserTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/NetworkTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/NetworkTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/ReplayTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/ReplayTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/RoadParserTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/RoadParserTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/RoadTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/RoadTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/SnapshotTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/SnapshotTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/TrafficSignParserTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/TrafficSignParserTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/TrafficSignTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/TrafficSignTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/TrajectoryTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/TrajectoryTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/TruckTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/TruckTester.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/Utils.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/Utils.cpp.o.d"
+  "CMakeFiles/simulation_tests.dir/src/tests/VehicleParserTester.cpp.o"
+  "CMakeFiles/simulation_tests.dir/src/tests/VehicleParserTester.cpp.o.d"
+  "simulation_tests"
+  "simulation_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simulation_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
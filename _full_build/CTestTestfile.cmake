@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_full_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(simulation_tests "/root/repo/_full_build/simulation_tests")
+set_tests_properties(simulation_tests PROPERTIES  WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;98;add_test;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,21 @@
+#!/usr/bin/env bash
+# builds simulation_headless with every contract level and compares the mean tick time on one input file
+# usage: ./benchmark.sh <file.xml> [ticks] [extra simulation_headless options]
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <file.xml> [ticks] [options]"
+    exit 1
+fi
+file=$(realpath "$1")
+cd "$(dirname "$0")"
+ticks=${2:-1000}
+shift
+[ $# -gt 0 ] && shift
+
+for config in Debug:full Release:full Release:cheap Release:off; do
+    type=${config%:*}
+    contracts=${config#*:}
+    dir=benchmark/$type-$contracts
+    cmake -S . -B "$dir" -DCMAKE_BUILD_TYPE="$type" -DSIMULATION_CONTRACTS="$contracts" >/dev/null || exit 1
+    cmake --build "$dir" --target simulation_headless -- -j"$(nproc)" >/dev/null || exit 1
+    echo "$type, contracts $contracts: $("$dir"/simulation_headless "$file" -t "$ticks" "$@" 2>&1 | grep -E "tick time|Assertion")"
+done
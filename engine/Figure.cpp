@@ -602,39 +602,45 @@ img::EasyImage Figures::draw(unsigned int size, const Color &background, const P
         totalAmbient += light.ambient;
     }
     for (const auto &figure: figures) {
-        if (figure.isTextured()) {
-            std::ifstream fin(figure.getTexture());
-            assert(fin.is_open());
-            img::EasyImage texture;
-            fin >> texture;
-            fin.close();
-            for (const auto &triangle: figure.getFaces()) {
-                image.draw_textured_triangle(buffer,
-                                             figure.getPoints()[triangle.point_indexes[0]],
-                                             figure.getPoints()[triangle.point_indexes[1]],
-                                             figure.getPoints()[triangle.point_indexes[2]],
-                                             d, dx, dy,
-                                             texture,
-                                             figure.getReflectionCoefficient(),
-                                             point, inf, totalAmbient, eye, shadows,
-                                             figure.getP(), figure.getA(), figure.getB());
-            }
-        } else {
-            for (const auto &triangle: figure.getFaces()) {
-                image.draw_triangle(buffer,
-                                    figure.getPoints()[triangle.point_indexes[0]],
-                                    figure.getPoints()[triangle.point_indexes[1]],
-                                    figure.getPoints()[triangle.point_indexes[2]],
-                                    d, dx, dy,
-                                    figure.getAmbient(), figure.getDiffuse(), figure.getSpecular(),
-                                    figure.getReflectionCoefficient(),
-                                    point, inf, totalAmbient, eye, shadows);
-            }
-        }
+        drawFigure(image, buffer, figure, d, dx, dy, point, inf, totalAmbient, eye, shadows);
     }
     return image;
 }
 
+void Figures::drawFigure(img::EasyImage &image, ZBuffer &buffer, const Figure &figure, const double d, const double dx,
+                         const double dy, const PointLights &point, const InfLights &inf, const Color &totalAmbient,
+                         const Matrix &eye, const bool shadows) {
+    if (figure.isTextured()) {
+        std::ifstream fin(figure.getTexture());
+        assert(fin.is_open());
+        img::EasyImage texture;
+        fin >> texture;
+        fin.close();
+        for (const auto &triangle: figure.getFaces()) {
+            image.draw_textured_triangle(buffer,
+                                         figure.getPoints()[triangle.point_indexes[0]],
+                                         figure.getPoints()[triangle.point_indexes[1]],
+                                         figure.getPoints()[triangle.point_indexes[2]],
+                                         d, dx, dy,
+                                         texture,
+                                         figure.getReflectionCoefficient(),
+                                         point, inf, totalAmbient, eye, shadows,
+                                         figure.getP(), figure.getA(), figure.getB());
+        }
+    } else {
+        for (const auto &triangle: figure.getFaces()) {
+            image.draw_triangle(buffer,
+                                figure.getPoints()[triangle.point_indexes[0]],
+                                figure.getPoints()[triangle.point_indexes[1]],
+                                figure.getPoints()[triangle.point_indexes[2]],
+                                d, dx, dy,
+                                figure.getAmbient(), figure.getDiffuse(), figure.getSpecular(),
+                                figure.getReflectionCoefficient(),
+                                point, inf, totalAmbient, eye, shadows);
+        }
+    }
+}
+
 Figures &Figures::operator*=(const Matrix &matrix) {
     for (auto &figure: figures) {
         figure *= matrix;
@@ -736,15 +742,25 @@ std::tuple<double, double, double, double, double> Figures::calculateValues(cons
     auto yMin = DBL_MAX;
 
     for (const auto &figure: figures) {
-        for (const auto &point: figure.getPoints()) {
-            const double x = (point.x) / (-point.z);
-            const double y = (point.y) / (-point.z);
-            if (x > xMax) xMax = x;
-            if (x < xMin) xMin = x;
-            if (y > yMax) yMax = y;
-            if (y < yMin) yMin = y;
-        }
+        bounds(figure, xMin, xMax, yMin, yMax);
     }
+    return calculateValues(size, xMin, xMax, yMin, yMax);
+}
+
+void Figures::bounds(const Figure &figure, double &xMin, double &xMax, double &yMin, double &yMax) {
+    for (const auto &point: figure.getPoints()) {
+        const double x = (point.x) / (-point.z);
+        const double y = (point.y) / (-point.z);
+        if (x > xMax) xMax = x;
+        if (x < xMin) xMin = x;
+        if (y > yMax) yMax = y;
+        if (y < yMin) yMin = y;
+    }
+}
+
+std::tuple<double, double, double, double, double>
+Figures::calculateValues(const unsigned int size, const double xMin, const double xMax, const double yMin,
+                         const double yMax) {
     const double xRange = xMax - xMin;
     const double yRange = yMax - yMin;
     const double xImage = size * (xRange / (std::max(xRange, yRange)));
@@ -155,6 +155,16 @@ public:
 
     std::tuple<double, double, double, double, double> calculateValues(unsigned int size) const;
 
+    static void bounds(const Figure &figure, double &xMin, double &xMax, double &yMin, double &yMax);
+
+    static std::tuple<double, double, double, double, double>
+    calculateValues(unsigned int size, double xMin, double xMax, double yMin, double yMax);
+
+    static void
+    drawFigure(img::EasyImage &image, ZBuffer &buffer, const Figure &figure, double d, double dx, double dy,
+               const PointLights &point, const InfLights &inf, const Color &totalAmbient, const Matrix &eye,
+               bool shadows);
+
     img::EasyImage
     draw(unsigned int size, const Color &background, const PointLights &point, const InfLights &inf, const Matrix &eye,
          bool shadows) const;
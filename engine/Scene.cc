@@ -0,0 +1,204 @@
+//============================================================================
+// @name        : Scene.cc
+// @author      : Ward Gauderis, Thomas Dooms
+// @date        : 5/28/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Ward Gauderis - University of Antwerp
+// @description : Renders figures that are built in memory, without an ini file
+//============================================================================
+
+#include "Scene.h"
+#include "Figure.h"
+#include <cfloat>
+#include <fstream>
+#include <mutex>
+
+namespace cg {
+    struct Scene::Figures {
+        std::vector<Figure> figures;
+        Matrix eye;
+        double xMin = DBL_MAX;
+        double xMax = -DBL_MAX;
+        double yMin = DBL_MAX;
+        double yMax = -DBL_MAX;
+        bool behind = false;    // a point is at or behind the eye and can not be projected
+
+        // the image and z-buffer after these figures were drawn as the first scene of a render with these bounds
+        struct Layer {
+            double bounds[4];
+            img::EasyImage image;
+            ZBuffer buffer;
+        };
+        std::mutex mutex;
+        std::shared_ptr<const Layer> layer;
+
+        // the same steps as getFigure and draw3D take for a figure of an ini
+        void add(Figure &&figure, const Matrix &matrix, const Material &material) {
+            figure *= matrix;
+            figure.setColor(Color(material.ambient[0], material.ambient[1], material.ambient[2]),
+                            Color(material.diffuse[0], material.diffuse[1], material.diffuse[2]),
+                            Color(material.specular[0], material.specular[1], material.specular[2]),
+                            material.reflectionCoefficient);
+            figure.triangulate();
+            figure *= eye;
+            for (const auto &point: figure.getPoints()) {
+                if (point.z >= 0) behind = true;
+            }
+            ::Figures::bounds(figure, xMin, xMax, yMin, yMax);
+            figures.emplace_back(std::move(figure));
+            std::lock_guard<std::mutex> lock(mutex);
+            layer.reset();      // the layer does not hold the new figure, even if the bounds stay the same
+        }
+    };
+
+    Image::Image() : width(0), height(0) {}
+
+    Scene::Scene(const View &view) : view(view), figures(new Figures()) {
+        figures->eye = eyePoint(Vector3D::point(view.eye[0], view.eye[1], view.eye[2]));
+    }
+
+    Scene::~Scene() = default;
+
+    void Scene::addPolygons(const std::vector<double> &points, const std::vector<std::vector<int> > &faces,
+                            const Material &material) {
+        Figure figure;
+        for (unsigned int i = 0; i + 2 < points.size(); i += 3) {
+            figure.addPoint(Vector3D::point(points[i], points[i + 1], points[i + 2]));
+        }
+        for (const auto &face: faces) {
+            figure.addFace(face);
+        }
+        figures->add(std::move(figure), scaleFigure(1) * rotateX(0) * rotateY(0) * rotateZ(0) *
+                                        translate(Vector3D::point(0, 0, 0)), material);
+    }
+
+    void Scene::addCylinder(const int n, const double height, const double scale, const double x,
+                            const double (&center)[3], const Material &material) {
+        figures->add(Figure::cylinder(n, height, true),
+                     scaleFigure(scale) * rotateX(M_PI * x / 180) * rotateY(0) * rotateZ(0) *
+                     translate(Vector3D::point(center[0], center[1], center[2])), material);
+    }
+
+    void Scene::addSphere(const int n, const double scale, const double (&center)[3], const Material &material) {
+        figures->add(Figure::sphere(n), scaleFigure(scale) * rotateX(0) * rotateY(0) * rotateZ(0) *
+                                        translate(Vector3D::point(center[0], center[1], center[2])), material);
+    }
+
+    void Scene::clear() {
+        const Matrix eye = figures->eye;
+        figures.reset(new Figures());
+        figures->eye = eye;
+    }
+
+    bool Scene::empty() const {
+        return figures->figures.empty();
+    }
+
+    const View &Scene::getView() const {
+        return view;
+    }
+
+    bool render(const std::vector<const Scene *> &scenes, Image &image) {
+        double xMin = DBL_MAX;
+        double xMax = -DBL_MAX;
+        double yMin = DBL_MAX;
+        double yMax = -DBL_MAX;
+        for (const auto scene: scenes) {
+            if (scene->figures->behind) return false;
+            xMin = std::min(xMin, scene->figures->xMin);
+            xMax = std::max(xMax, scene->figures->xMax);
+            yMin = std::min(yMin, scene->figures->yMin);
+            yMax = std::max(yMax, scene->figures->yMax);
+        }
+        // the image would have no size, the engine can not generate it
+        if (not(xMax > xMin and yMax > yMin)) return false;
+
+        const View &view = scenes.front()->view;
+        const Matrix &eye = scenes.front()->figures->eye;
+        const auto values = ::Figures::calculateValues(view.size, xMin, xMax, yMin, yMax);
+        const double d = std::get<0>(values);
+        const double dx = std::get<1>(values);
+        const double dy = std::get<2>(values);
+        // the outer points are drawn at 97.5% of a side, after rounding a very small side has no room for them
+        if (std::get<3>(values) < 40 or std::get<4>(values) < 40) return false;
+        img::EasyImage easy;
+        ZBuffer buffer;
+
+        const PointLights points;
+        InfLights infs;
+        Color totalAmbient;
+        for (const auto &light: view.lights) {
+            infs.emplace_back(Color(light.ambient[0], light.ambient[1], light.ambient[2]),
+                              Color(light.diffuse[0], light.diffuse[1], light.diffuse[2]),
+                              Color(light.specular[0], light.specular[1], light.specular[2]),
+                              Vector3D::vector(light.direction[0], light.direction[1], light.direction[2]));
+            totalAmbient += infs.back().ambient;
+        }
+        infs *= eye;
+
+        // the first scene is drawn first, so with the same bounds it always leaves the same image behind
+        Scene::Figures &first = *scenes.front()->figures;
+        const double bounds[4] = {xMin, xMax, yMin, yMax};
+        std::shared_ptr<const Scene::Figures::Layer> layer;
+        {
+            std::lock_guard<std::mutex> lock(first.mutex);
+            layer = first.layer;
+        }
+        if (layer and std::equal(bounds, bounds + 4, layer->bounds)) {
+            easy = layer->image;
+            buffer = layer->buffer;
+        } else {
+            easy = img::EasyImage(static_cast<unsigned int>(round(std::get<3>(values))),
+                                  static_cast<unsigned int>(round(std::get<4>(values))));
+            buffer = ZBuffer(easy.get_width(), easy.get_height());
+            easy.clear(Color(view.background[0], view.background[1], view.background[2]));
+            for (const auto &figure: first.figures) {
+                ::Figures::drawFigure(easy, buffer, figure, d, dx, dy, points, infs, totalAmbient, eye, false);
+            }
+            if (scenes.size() > 1) {
+                Scene::Figures::Layer *drawn = new Scene::Figures::Layer{{xMin, xMax, yMin, yMax}, easy, buffer};
+                std::lock_guard<std::mutex> lock(first.mutex);
+                first.layer.reset(drawn);
+            }
+        }
+
+        for (unsigned int i = 1; i < scenes.size(); ++i) {
+            for (const auto &figure: scenes[i]->figures->figures) {
+                ::Figures::drawFigure(easy, buffer, figure, d, dx, dy, points, infs, totalAmbient, eye, false);
+            }
+        }
+
+        image.width = easy.get_width();
+        image.height = easy.get_height();
+        image.pixels.resize(3 * image.width * image.height);
+        uint8_t *pixel = image.pixels.data();
+        for (unsigned int y = image.height; y > 0; --y) {
+            for (unsigned int x = 0; x < image.width; ++x) {
+                const img::Color &color = easy(x, y - 1);
+                *pixel++ = color.red;
+                *pixel++ = color.green;
+                *pixel++ = color.blue;
+            }
+        }
+        return true;
+    }
+
+    bool writeBmp(const Image &image, const std::string &filename) {
+        img::EasyImage easy(image.width, image.height);
+        const uint8_t *pixel = image.pixels.data();
+        for (unsigned int y = image.height; y > 0; --y) {
+            for (unsigned int x = 0; x < image.width; ++x) {
+                easy(x, y - 1) = img::Color(pixel[0], pixel[1], pixel[2]);
+                pixel += 3;
+            }
+        }
+        std::ofstream file(filename, std::ios::binary);
+        if (not file.is_open()) return false;
+        try {
+            file << easy;
+        } catch (const std::exception &) {
+            return false;
+        }
+        return true;
+    }
+}
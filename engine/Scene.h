@@ -0,0 +1,121 @@
+//============================================================================
+// @name        : Scene.h
+// @author      : Ward Gauderis, Thomas Dooms
+// @date        : 5/28/19
+// @version     :
+// @copyright   : BA1 Informatica - Ward Gauderis - University of Antwerp
+// @description : Renders figures that are built in memory, without an ini file
+//============================================================================
+#ifndef ENGINE_CMAKE_SCENE_H
+#define ENGINE_CMAKE_SCENE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+
+/**
+ * This header only uses plain types so it can be included next to code that has its own Color or Face,
+ * the engine types stay in Scene.cc.
+ */
+namespace cg {
+    struct Material {
+        double ambient[3];
+        double diffuse[3];
+        double specular[3];
+        double reflectionCoefficient;
+    };
+
+    /**
+     * a light at infinity
+     */
+    struct Light {
+        double ambient[3];
+        double diffuse[3];
+        double specular[3];
+        double direction[3];
+    };
+
+    /**
+     * the settings of a "LightedZBuffering" ini without its figures
+     */
+    struct View {
+        unsigned int size;
+        double background[3];
+        double eye[3];
+        std::vector<Light> lights;
+    };
+
+    /**
+     * rgb pixels, the top row first
+     */
+    struct Image {
+        unsigned int width;
+        unsigned int height;
+        std::vector<uint8_t> pixels;
+
+        Image();
+    };
+
+    /**
+     * The figures are transformed to eye coordinates and triangulated when they are added, so a scene can be
+     * rendered many times without building it again. Figures are drawn in the order they are added.
+     */
+    class Scene {
+    public:
+        explicit Scene(const View &view);
+
+        ~Scene();
+
+        /**
+         * a "LineDrawing", points holds x, y and z of every point and every face holds indexes of points
+         */
+        void addPolygons(const std::vector<double> &points, const std::vector<std::vector<int> > &faces,
+                         const Material &material);
+
+        /**
+         * a "Cylinder" with faces that is scaled, rotated around x by rotateX degrees and moved to center
+         */
+        void addCylinder(int n, double height, double scale, double rotateX, const double (&center)[3],
+                         const Material &material);
+
+        /**
+         * a "Sphere" that is scaled and moved to center
+         */
+        void addSphere(int n, double scale, const double (&center)[3], const Material &material);
+
+        void clear();
+
+        bool empty() const;
+
+        const View &getView() const;
+
+    private:
+        Scene(const Scene &);
+
+        Scene &operator=(const Scene &);
+
+        friend bool render(const std::vector<const Scene *> &scenes, Image &image);
+
+        struct Figures;
+
+        View view;
+        std::unique_ptr<Figures> figures;
+    };
+
+    /**
+     * draws the scenes on top of each other with the view of the first one, the image is as big as all scenes
+     * together need. Returns false if there is nothing to draw or the engine can not draw it (a point behind the eye
+     * or a side of less than 40 pixels), the image is not changed then.
+     * When more scenes are given the first one keeps what it was drawn to, a next render with the same bounds starts
+     * from that instead of drawing it again. Scenes may be rendered on several threads at the same time.
+     */
+    bool render(const std::vector<const Scene *> &scenes, Image &image);
+
+    /**
+     * writes the image as an uncompressed bmp, returns false if the file could not be written
+     */
+    bool writeBmp(const Image &image, const std::string &filename);
+}
+
+#endif //ENGINE_CMAKE_SCENE_H
@@ -22,7 +22,9 @@
 #include <iostream>
 #include <cfloat>
 
+#ifndef le32toh
 #define le32toh(x) (x)
+#endif
 
 namespace {
     //structs borrowed from wikipedia's article on the BMP file format
@@ -8,8 +8,25 @@
 
 #include <assert.h>
 
+// SIMULATION_CONTRACTS chooses which contracts are checked:
+// 0 checks none, 1 only checks the preconditions and 2 checks everything (default).
+// Contracts that are not checked are still compiled, but their assertion is never evaluated.
+#ifndef SIMULATION_CONTRACTS
+#define SIMULATION_CONTRACTS 2
+#endif
+
+#if SIMULATION_CONTRACTS >= 1
 #define REQUIRE(assertion, what) \
 	if (!(assertion)) __assert (what, __FILE__, __LINE__)
+#else
+#define REQUIRE(assertion, what) \
+	if (false and !(assertion)) (void)(what)
+#endif
 
+#if SIMULATION_CONTRACTS >= 2
 #define ENSURE(assertion, what) \
 	if (!(assertion)) __assert (what, __FILE__, __LINE__)
+#else
+#define ENSURE(assertion, what) \
+	if (false and !(assertion)) (void)(what)
+#endif
@@ -0,0 +1,523 @@
+//============================================================================
+// @name        : benchMain.cpp
+// @author      : Thomas Dooms
+// @date        : 5/25/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : micro-benchmarks of the hot paths of the simulation on synthetic networks, printed as csv or json
+//============================================================================
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "datatypes/Network.h"
+#include "datatypes/vehicles/Car.h"
+#include "datatypes/vehicles/Bus.h"
+#include "datatypes/vehicles/Truck.h"
+#include "datatypes/vehicles/Motorcycle.h"
+#include "exporters/NetworkExporter.h"
+#include "exporters/VehicleExporter.h"
+#include "exporters/TrajectoryExporter.h"
+#include "DesignByContract.h"
+
+namespace
+{
+    struct BenchConfig
+    {
+        uint32_t fRoads;
+        uint32_t fLanes;
+        double fLength;         // meters per road
+        double fDensity;        // vehicles per km per lane
+        double fSigns;          // traffic lights, bus stops and zones per km, in turn
+        uint32_t fTicks;
+        uint32_t fWarmup;
+        uint32_t fSeed;
+    };
+
+    // the amount of operations (vehicle ticks or calls) and the time they took
+    struct BenchResult
+    {
+        std::string fName;
+        std::string fUnit;
+        uint64_t fOperations;
+        double fNanoseconds;
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    double elapsed(const Clock::time_point& kStart)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - kStart).count();
+    }
+
+    IVehicle* createVehicle(std::mt19937& generator, const std::string& kLicense, const double kPosition)
+    {
+        const uint32_t kKind = std::uniform_int_distribution<uint32_t>(0, 99)(generator);
+        if(kKind < 80) return new Car(kLicense, kPosition, 0);
+        if(kKind < 88) return new Truck(kLicense, kPosition, 0);
+        if(kKind < 95) return new Motorcycle(kLicense, kPosition, 0);
+        return new Bus(kLicense, kPosition, 0);
+    }
+
+    /**
+     * a chain of roads that are filled evenly, the signs are spread evenly over every road as well.
+     * The same config always gives the same network.
+     */
+    Network* createNetwork(const BenchConfig& kConfig)
+    {
+        std::mt19937 generator(kConfig.fSeed);
+        std::vector<Road*> roads(kConfig.fRoads);
+        Arena* signArena = new Arena;
+
+        const uint32_t kSigns = static_cast<uint32_t>(kConfig.fSigns * kConfig.fLength / 1000);
+        Road* next = NULL;
+        for(uint32_t i = kConfig.fRoads; i-- > 0;)
+        {
+            std::vector<const Zone*> zones(1, new (signArena) Zone(0, 120 / 3.6));
+            std::vector<const BusStop*> busStops;
+            std::vector<const TrafficLight*> trafficLights;
+            for(uint32_t j = 0; j < kSigns; j++)
+            {
+                const double kPosition = (j + 0.5) * kConfig.fLength / kSigns;
+                if(j % 3 == 0) trafficLights.push_back(new (signArena) TrafficLight(kPosition));
+                else if(j % 3 == 1) busStops.push_back(new (signArena) BusStop(kPosition));
+                else zones.push_back(new (signArena) Zone(kPosition, (j % 2 == 0 ? 70 : 120) / 3.6));
+            }
+
+            roads[i] = new Road("R" + std::to_string(i), next, kConfig.fLength, kConfig.fLanes, zones, busStops, trafficLights);
+            next = roads[i];
+        }
+
+        // vehicles are enqueued from the front of every lane to the back
+        const uint32_t kPerLane = static_cast<uint32_t>(kConfig.fDensity * kConfig.fLength / 1000);
+        uint32_t license = 0;
+        for(uint32_t i = 0; i < kConfig.fRoads; i++)
+        {
+            for(uint32_t j = 0; j < kConfig.fLanes; j++)
+            {
+                for(uint32_t k = 0; k < kPerLane; k++)
+                {
+                    const double kPosition = kConfig.fLength - (k + 0.5) * kConfig.fLength / kPerLane;
+                    roads[i]->enqueue(createVehicle(generator, "B" + std::to_string(license++), kPosition), j);
+                }
+            }
+        }
+        return new Network(roads, signArena);
+    }
+
+    uint64_t countVehicles(const Network* kNetwork)
+    {
+        uint64_t count = 0;
+        for(uint32_t i = 0; i < kNetwork->getRoads().size(); i++) count += kNetwork->getRoads()[i]->getNumVehicles();
+        return count;
+    }
+
+    Network* createWarmNetwork(const BenchConfig& kConfig, const bool kBuffered)
+    {
+        Network* network = createNetwork(kConfig);
+        network->setDoubleBuffered(kBuffered);
+        for(uint32_t i = 0; i < kConfig.fWarmup; i++) network->update();
+        return network;
+    }
+
+    BenchResult benchNetworkUpdate(const BenchConfig& kConfig, const bool kBuffered)
+    {
+        Network* network = createWarmNetwork(kConfig, kBuffered);
+        BenchResult result = {kBuffered ? "network_update_buffered" : "network_update", "vehicle_tick", 0, 0};
+
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            result.fOperations += countVehicles(network);
+            const Clock::time_point kStart = Clock::now();
+            network->update();
+            result.fNanoseconds += elapsed(kStart);
+        }
+        delete network;
+        return result;
+    }
+
+    // the vehicles that leave the network are deleted by the next network update or the destructor
+    BenchResult benchRoadUpdate(const BenchConfig& kConfig)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        const std::vector<Road*>& kRoads = network->getRoads();
+        BenchResult result = {"road_update", "vehicle_tick", 0, 0};
+
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            const uint32_t kEpoch = network->getEpoch() + i + 1;
+            for(uint32_t j = 0; j < kRoads.size(); j++) kRoads[j]->updateTrafficSigns();
+
+            result.fOperations += countVehicles(network);
+            const Clock::time_point kStart = Clock::now();
+            for(uint32_t j = 0; j < kRoads.size(); j++) kRoads[j]->updateVehicles(kEpoch);
+            result.fNanoseconds += elapsed(kStart);
+        }
+        delete network;
+        return result;
+    }
+
+    // only the moves are timed, the update of the roads afterwards stores the new state and dequeues the vehicles,
+    // the vehicles behind a vehicle see its state of the previous tick.
+    BenchResult benchVehicleMove(const BenchConfig& kConfig)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        const std::vector<Road*>& kRoads = network->getRoads();
+        BenchResult result = {"vehicle_move", "call", 0, 0};
+
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            const uint32_t kEpoch = network->getEpoch() + i + 1;
+            for(uint32_t j = 0; j < kRoads.size(); j++) kRoads[j]->updateTrafficSigns();
+
+            const Clock::time_point kStart = Clock::now();
+            for(uint32_t j = 0; j < kRoads.size(); j++)
+            {
+                for(uint32_t k = 0; k < kRoads[j]->getNumLanes(); k++)
+                {
+                    const Lane& kLane = kRoads[j]->getLane(k);
+                    for(uint32_t l = 0; l < kLane.size(); l++) kLane[l]->move(k, l, kRoads[j], kEpoch);
+                    result.fOperations += kLane.size();
+                }
+            }
+            result.fNanoseconds += elapsed(kStart);
+            for(uint32_t j = 0; j < kRoads.size(); j++) kRoads[j]->updateVehicles(kEpoch);
+        }
+        delete network;
+        return result;
+    }
+
+    // the lanes keep a copy of the position, velocity and acceleration of their vehicles, this is the cost of
+    // refreshing that copy for every vehicle, which the updates pay once per vehicle tick
+    BenchResult benchLaneStore(const BenchConfig& kConfig)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        const std::vector<Road*>& kRoads = network->getRoads();
+        BenchResult result = {"lane_store", "vehicle_tick", 0, 0};
+
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            result.fOperations += countVehicles(network);
+            const Clock::time_point kStart = Clock::now();
+            for(uint32_t j = 0; j < kRoads.size(); j++) kRoads[j]->commitVehicles();
+            result.fNanoseconds += elapsed(kStart);
+            network->update();
+        }
+        delete network;
+        return result;
+    }
+
+    BenchResult benchNextVehicle(const BenchConfig& kConfig)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        const std::vector<Road*>& kRoads = network->getRoads();
+        BenchResult result = {"road_next_vehicle", "call", 0, 0};
+
+        double sink = 0;    // keeps the compiler from removing the lookups
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            const Clock::time_point kStart = Clock::now();
+            for(uint32_t j = 0; j < kRoads.size(); j++)
+            {
+                for(uint32_t k = 0; k < kRoads[j]->getNumLanes(); k++)
+                {
+                    const uint32_t kSize = kRoads[j]->getLane(k).size();
+                    for(uint32_t l = 0; l < kSize; l++) sink += kRoads[j]->getNextVehicle(k, l).second;
+                    result.fOperations += kSize;
+                }
+            }
+            result.fNanoseconds += elapsed(kStart);
+            network->update();
+        }
+        if(sink < 0) std::cerr << sink;
+        delete network;
+        return result;
+    }
+
+    // every vehicle that is allowed to tries to overtake, like IVehicle does. The lanes are visited from left to right
+    // so the vehicles that changed lane are not visited again.
+    BenchResult benchChangeLane(const BenchConfig& kConfig)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        const std::vector<Road*>& kRoads = network->getRoads();
+        BenchResult result = {"road_change_lane", "call", 0, 0};
+
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            const Clock::time_point kStart = Clock::now();
+            for(uint32_t j = 0; j < kRoads.size(); j++)
+            {
+                for(uint32_t k = kRoads[j]->getNumLanes() - 1; k-- > 0;)
+                {
+                    const Lane& kLane = kRoads[j]->getLane(k);
+                    for(uint32_t l = 0; l < kLane.size(); l++)
+                    {
+                        IVehicle* const kVehicle = kLane[l];
+                        if((kLane.getFlags(l) & Lane::kGhost) or kVehicle->getMerging() or not kVehicle->getConstants().fCanChangeLane) continue;
+                        kVehicle->setMerging(kRoads[j]->changeLaneIfPossible(kVehicle, k, l, true));
+                        result.fOperations++;
+                    }
+                }
+            }
+            result.fNanoseconds += elapsed(kStart);
+            network->update();
+        }
+        delete network;
+        return result;
+    }
+
+    // every vehicle looks up its speed limit, traffic light and bus stop, from scratch or from its own cursors
+    BenchResult benchSignLookup(const BenchConfig& kConfig, const bool kCursors)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        const std::vector<Road*>& kRoads = network->getRoads();
+        BenchResult result = {kCursors ? "road_sign_lookup_cursor" : "road_sign_lookup", "call", 0, 0};
+
+        std::vector<uint32_t> cursors;
+        double sink = 0;
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            const Clock::time_point kStart = Clock::now();
+            uint32_t cursor = 0;
+            for(uint32_t j = 0; j < kRoads.size(); j++)
+            {
+                for(uint32_t k = 0; k < kRoads[j]->getNumLanes(); k++)
+                {
+                    const Lane& kLane = kRoads[j]->getLane(k);
+                    if(cursors.size() < cursor + 3 * kLane.size()) cursors.resize(cursor + 3 * kLane.size(), 0);
+                    for(uint32_t l = 0; l < kLane.size(); l++, cursor += 3)
+                    {
+                        const double kPosition = kLane.getPosition(l);
+                        if(kCursors)
+                        {
+                            sink += kRoads[j]->getSpeedLimit(kPosition, cursors[cursor]);
+                            sink += kRoads[j]->getTrafficLight(kPosition, cursors[cursor + 1]).first != NULL;
+                            sink += kRoads[j]->getBusStop(kPosition, cursors[cursor + 2]).first != NULL;
+                        }
+                        else
+                        {
+                            sink += kRoads[j]->getSpeedLimit(kPosition);
+                            sink += kRoads[j]->getTrafficLight(kPosition).first != NULL;
+                            sink += kRoads[j]->getBusStop(kPosition).first != NULL;
+                        }
+                    }
+                    result.fOperations += 3 * kLane.size();
+                }
+            }
+            result.fNanoseconds += elapsed(kStart);
+            network->update();
+        }
+        if(sink < 0) std::cerr << sink;
+        delete network;
+        return result;
+    }
+
+    // the impression output is written to std::cout as well, which is silenced during the benchmark
+    BenchResult benchNetworkExport(const BenchConfig& kConfig)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        BenchResult result = {"network_export", "vehicle_tick", 0, 0};
+
+        std::ostringstream silence;
+        std::streambuf* const kCout = std::cout.rdbuf(silence.rdbuf());
+        NetworkExporter::init(network, "bench_simple", "bench_impression");
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            network->update();
+            result.fOperations += countVehicles(network);
+            const Clock::time_point kStart = Clock::now();
+            NetworkExporter::addSection(network, network->getTicksPassed());
+            result.fNanoseconds += elapsed(kStart);
+            silence.str("");
+        }
+        NetworkExporter::finish();
+        std::cout.rdbuf(kCout);
+        delete network;
+        return result;
+    }
+
+    BenchResult benchTrajectoryExport(const BenchConfig& kConfig, const ETrajectoryEncoding kEncoding)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        BenchResult result = {kEncoding == kTrajectoryRaw ? "trajectory_export_raw" : "trajectory_export_delta", "vehicle_tick", 0, 0};
+
+        TrajectoryExporter::init(network, "bench_trajectory", kEncoding);
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            network->update();
+            result.fOperations += countVehicles(network);
+            const Clock::time_point kStart = Clock::now();
+            TrajectoryExporter::addSection(network, network->getTicksPassed());
+            result.fNanoseconds += elapsed(kStart);
+        }
+        TrajectoryExporter::finish();
+        delete network;
+        return result;
+    }
+
+    // every frame is rendered in process and written to outputfiles/cg.bmp
+    BenchResult benchCgExport(const BenchConfig& kConfig)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        BenchResult result = {"cg_export", "frame", 0, 0};
+
+        std::ostringstream silence;
+        std::streambuf* const kCout = std::cout.rdbuf(silence.rdbuf());
+        NetworkExporter::init(network, "bench_simple", "bench_impression");
+        std::cout.rdbuf(kCout);
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            network->update();
+            result.fOperations++;
+            const Clock::time_point kStart = Clock::now();
+            NetworkExporter::cgExport(network, 0);
+            result.fNanoseconds += elapsed(kStart);
+        }
+        NetworkExporter::finish();
+        delete network;
+        return result;
+    }
+
+    BenchResult benchVehicleExport(const BenchConfig& kConfig)
+    {
+        Network* network = createWarmNetwork(kConfig, false);
+        const std::vector<Road*>& kRoads = network->getRoads();
+        BenchResult result = {"vehicle_export", "call", 0, 0};
+
+        VehicleExporter::init("bench_statistics");
+        for(uint32_t i = 0; i < kConfig.fTicks; i++)
+        {
+            network->update();
+            const Clock::time_point kStart = Clock::now();
+            for(uint32_t j = 0; j < kRoads.size(); j++)
+            {
+                for(uint32_t k = 0; k < kRoads[j]->getNumLanes(); k++)
+                {
+                    const Lane& kLane = kRoads[j]->getLane(k);
+                    for(uint32_t l = 0; l < kLane.size(); l++) VehicleExporter::addSection(kLane[l]);
+                    result.fOperations += kLane.size();
+                }
+            }
+            result.fNanoseconds += elapsed(kStart);
+        }
+        VehicleExporter::finish();
+        delete network;
+        return result;
+    }
+
+    void print(const BenchResult& kResult, const BenchConfig& kConfig, const bool kJson)
+    {
+        const double kPerOperation = kResult.fOperations == 0 ? 0 : kResult.fNanoseconds / kResult.fOperations;
+        if(kJson)
+        {
+            std::cout << "{\"benchmark\": \"" << kResult.fName << "\", \"unit\": \"" << kResult.fUnit << "\", \"roads\": " << kConfig.fRoads
+                      << ", \"lanes\": " << kConfig.fLanes << ", \"length\": " << kConfig.fLength << ", \"density\": " << kConfig.fDensity
+                      << ", \"signs\": " << kConfig.fSigns << ", \"ticks\": " << kConfig.fTicks << ", \"seed\": " << kConfig.fSeed
+                      << ", \"contracts\": " << SIMULATION_CONTRACTS << ", \"operations\": " << kResult.fOperations
+                      << ", \"ns_per_operation\": " << kPerOperation << "}\n";
+        }
+        else
+        {
+            std::cout << kResult.fName << ',' << kResult.fUnit << ',' << kConfig.fRoads << ',' << kConfig.fLanes << ',' << kConfig.fLength << ','
+                      << kConfig.fDensity << ',' << kConfig.fSigns << ',' << kConfig.fTicks << ',' << kConfig.fSeed << ','
+                      << SIMULATION_CONTRACTS << ',' << kResult.fOperations << ',' << kPerOperation << '\n';
+        }
+    }
+}
+
+void usage(const char* name)
+{
+    std::cerr << "usage: " << name << " [-r roads] [-l lanes] [-m length] [-d density] [-s signs] [-t ticks] [-w warmup] [-x seed] [-b benchmark] [-f format]\n"
+              << "  -r roads     : amount of roads in the chain (default 10)\n"
+              << "  -l lanes     : amount of lanes of every road (default 2)\n"
+              << "  -m length    : length of every road in meters (default 2000)\n"
+              << "  -d density   : vehicles per km per lane at the start, at most 50 (default 20)\n"
+              << "  -s signs     : traffic lights, bus stops and zones per km, in turn (default 3)\n"
+              << "  -t ticks     : amount of measured ticks (default 100)\n"
+              << "  -w warmup    : amount of ticks simulated before measuring (default 20)\n"
+              << "  -x seed      : seed of the vehicle kinds (default 1)\n"
+              << "  -b benchmark : only run the benchmarks whose name contains this\n"
+              << "  -f format    : csv (default) or json, one result per line\n";
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig config = {10, 2, 2000, 20, 3, 100, 20, 1};
+    std::string filter;
+    std::string format = "csv";
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(i + 1 >= argc or std::strlen(argv[i]) != 2 or argv[i][0] != '-')
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        switch(argv[i][1])
+        {
+            case 'r': config.fRoads = std::atoi(argv[++i]); break;
+            case 'l': config.fLanes = std::atoi(argv[++i]); break;
+            case 'm': config.fLength = std::atof(argv[++i]); break;
+            case 'd': config.fDensity = std::atof(argv[++i]); break;
+            case 's': config.fSigns = std::atof(argv[++i]); break;
+            case 't': config.fTicks = std::atoi(argv[++i]); break;
+            case 'w': config.fWarmup = std::atoi(argv[++i]); break;
+            case 'x': config.fSeed = std::atoi(argv[++i]); break;
+            case 'b': filter = argv[++i]; break;
+            case 'f': format = argv[++i]; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if(config.fRoads < 1 or config.fLanes < 1 or config.fLanes >= 100 or config.fLength <= 0 or config.fTicks < 1)
+    {
+        std::cerr << "there must be at least one road, lane and tick, and less than 100 lanes\n";
+        return 1;
+    }
+    if(config.fDensity < 0 or config.fDensity > 50 or config.fSigns < 0)
+    {
+        std::cerr << "the density must be between 0 and 50 and the signs must be positive\n";
+        return 1;
+    }
+    if(format != "csv" and format != "json")
+    {
+        std::cerr << "format must be csv or json\n";
+        return 1;
+    }
+
+    typedef BenchResult (*Benchmark)(const BenchConfig&);
+    struct Entry { const char* fName; Benchmark fBenchmark; };
+    const Entry kBenchmarks[] =
+    {
+        {"network_update",          [](const BenchConfig& kConfig) { return benchNetworkUpdate(kConfig, false); }},
+        {"network_update_buffered", [](const BenchConfig& kConfig) { return benchNetworkUpdate(kConfig, true); }},
+        {"road_update",             benchRoadUpdate},
+        {"vehicle_move",            benchVehicleMove},
+        {"lane_store",              benchLaneStore},
+        {"road_next_vehicle",       benchNextVehicle},
+        {"road_change_lane",        benchChangeLane},
+        {"road_sign_lookup",        [](const BenchConfig& kConfig) { return benchSignLookup(kConfig, false); }},
+        {"road_sign_lookup_cursor", [](const BenchConfig& kConfig) { return benchSignLookup(kConfig, true); }},
+        {"network_export",          benchNetworkExport},
+        {"trajectory_export_raw",   [](const BenchConfig& kConfig) { return benchTrajectoryExport(kConfig, kTrajectoryRaw); }},
+        {"trajectory_export_delta", [](const BenchConfig& kConfig) { return benchTrajectoryExport(kConfig, kTrajectoryDelta); }},
+        {"vehicle_export",          benchVehicleExport},
+        {"cg_export",               benchCgExport},
+    };
+
+    const bool kJson = format == "json";
+    if(not kJson) std::cout << "benchmark,unit,roads,lanes,length,density,signs,ticks,seed,contracts,operations,ns_per_operation\n";
+    for(uint32_t i = 0; i < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); i++)
+    {
+        if(std::string(kBenchmarks[i].fName).find(filter) == std::string::npos) continue;
+        print(kBenchmarks[i].fBenchmark(config), config, kJson);
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+//============================================================================
+// @name        : Allocator.cpp
+// @author      : Thomas Dooms
+// @date        : 5/25/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : a pool for objects of one size and an arena for objects that are never freed
+//============================================================================
+
+#include <new>
+#include "Allocator.h"
+#include "../DesignByContract.h"
+
+namespace
+{
+    const std::size_t kAlignment = alignof(std::max_align_t);
+
+    std::size_t alignUp(std::size_t size)
+    {
+        return (size + kAlignment - 1) / kAlignment * kAlignment;
+    }
+}
+
+Pool::Pool(const std::size_t kBlockSize, const uint32_t kBlocksPerChunk)
+{
+    REQUIRE(kBlockSize > 0, "Pool cannot hand out empty blocks");
+    REQUIRE(kBlocksPerChunk > 0, "Chunk must hold at least one block");
+
+    fFree = NULL;
+    fBlockCount = (kBlockSize + sizeof(Block) - 1) / sizeof(Block);
+    fBlocksPerChunk = kBlocksPerChunk;
+    fUsed = 0;
+    fBlockSize = kBlockSize;
+
+    _initCheck = this;
+    ENSURE(this->properlyInitialized(), "Pool constructor must end in properlyInitialized state");
+}
+
+Pool::~Pool()
+{
+    REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling the destructor");
+    for(uint32_t i = 0; i < fChunks.size(); i++) delete[] fChunks[i];
+}
+
+bool Pool::properlyInitialized() const
+{
+    return _initCheck == this;
+}
+
+std::size_t Pool::getBlockSize() const
+{
+    REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling getBlockSize");
+    return fBlockSize;
+}
+
+uint32_t Pool::getNumUsed() const
+{
+    REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling getNumUsed");
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fUsed;
+}
+
+void* Pool::allocate()
+{
+    REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling allocate");
+    std::lock_guard<std::mutex> lock(fMutex);
+
+    if(fFree == NULL)
+    {
+        // thread a new chunk onto the free list, the first block of the chunk is handed out first
+        Block* chunk = new Block[fBlockCount * fBlocksPerChunk];
+        fChunks.push_back(chunk);
+        for(uint32_t i = fBlocksPerChunk; i-- > 0;)
+        {
+            chunk[i * fBlockCount].fNext = fFree;
+            fFree = &chunk[i * fBlockCount];
+        }
+    }
+
+    Block* block = fFree;
+    fFree = block->fNext;
+    fUsed++;
+    return block;
+}
+
+void Pool::deallocate(void* const kBlock)
+{
+    REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling deallocate");
+    if(kBlock == NULL) return;
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    REQUIRE(fUsed > 0, "Pool has no blocks to free");
+
+    Block* block = static_cast<Block*>(kBlock);
+    block->fNext = fFree;
+    fFree = block;
+    fUsed--;
+}
+
+Arena::Arena(const std::size_t kChunkSize)
+{
+    REQUIRE(kChunkSize > 0, "Chunk size must be greater than 0");
+
+    fChunkSize = alignUp(kChunkSize);
+    fOffset = fChunkSize;
+    fBytes = 0;
+
+    _initCheck = this;
+    ENSURE(this->properlyInitialized(), "Arena constructor must end in properlyInitialized state");
+}
+
+Arena::~Arena()
+{
+    REQUIRE(this->properlyInitialized(), "Arena was not initialized when calling the destructor");
+    for(uint32_t i = 0; i < fChunks.size(); i++) ::operator delete(fChunks[i]);
+}
+
+bool Arena::properlyInitialized() const
+{
+    return _initCheck == this;
+}
+
+std::size_t Arena::getNumBytes() const
+{
+    REQUIRE(this->properlyInitialized(), "Arena was not initialized when calling getNumBytes");
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fBytes;
+}
+
+void* Arena::allocate(const std::size_t kSize)
+{
+    REQUIRE(this->properlyInitialized(), "Arena was not initialized when calling allocate");
+    std::lock_guard<std::mutex> lock(fMutex);
+
+    const std::size_t kAligned = alignUp(kSize);
+    fBytes += kAligned;
+
+    // big objects get a chunk of their own, so the current chunk can still be used
+    if(kAligned > fChunkSize)
+    {
+        char* chunk = static_cast<char*>(::operator new(kAligned));
+        fChunks.insert(fChunks.end() - (fChunks.empty() ? 0 : 1), chunk);
+        return chunk;
+    }
+    if(fOffset + kAligned > fChunkSize)
+    {
+        fChunks.push_back(static_cast<char*>(::operator new(fChunkSize)));
+        fOffset = 0;
+    }
+
+    char* result = fChunks.back() + fOffset;
+    fOffset += kAligned;
+    return result;
+}
+
+void* ArenaAllocated::operator new(const std::size_t size, Arena* const arena)
+{
+    return arena == NULL ? ::operator new(size) : arena->allocate(size);
+}
+
+void ArenaAllocated::operator delete(void* const pointer, Arena* const arena)
+{
+    if(arena == NULL) ::operator delete(pointer);
+}
+
+void* ArenaAllocated::operator new(const std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void ArenaAllocated::operator delete(void* const pointer)
+{
+    ::operator delete(pointer);
+}
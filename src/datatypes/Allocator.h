@@ -0,0 +1,178 @@
+//============================================================================
+// @name        : Allocator.h
+// @author      : Thomas Dooms
+// @date        : 5/25/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : a pool for objects of one size and an arena for objects that are never freed
+//============================================================================
+
+#ifndef SIMULATION_ALLOCATOR_H
+#define SIMULATION_ALLOCATOR_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+/**
+ * hands out blocks of one size from big chunks, freed blocks are kept in a list and handed out first.
+ * Allocating and freeing is O(1) and the objects of one kind sit next to each other in memory.
+ * The chunks are only given back to the system when the pool is destroyed.
+ */
+class Pool
+{
+public:
+    /**
+     * REQUIRE(kBlockSize > 0, "Pool cannot hand out empty blocks");
+     * REQUIRE(kBlocksPerChunk > 0, "Chunk must hold at least one block");
+     *
+     * ENSURE(this->properlyInitialized(), "Pool constructor must end in properlyInitialized state");
+     */
+    Pool(std::size_t kBlockSize, uint32_t kBlocksPerChunk = 256);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling the destructor");
+     */
+    ~Pool();
+
+    bool properlyInitialized() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling getBlockSize");
+     */
+    std::size_t getBlockSize() const;
+
+    /**
+     * the amount of blocks that have been allocated and not freed yet
+     *
+     * REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling getNumUsed");
+     */
+    uint32_t getNumUsed() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling allocate");
+     * ENSURE(getNumUsed() == old.getNumUsed() + 1, "block was not handed out");
+     */
+    void* allocate();
+
+    /**
+     * kBlock must have been allocated by this pool
+     *
+     * REQUIRE(this->properlyInitialized(), "Pool was not initialized when calling deallocate");
+     * REQUIRE(getNumUsed() > 0, "Pool has no blocks to free");
+     */
+    void deallocate(void* kBlock);
+
+private:
+    union Block
+    {
+        Block* fNext;
+        std::max_align_t fAlign;
+    };
+
+    Pool(const Pool&);
+    Pool& operator=(const Pool&);
+
+    std::vector<Block*> fChunks;
+    Block* fFree;                   // list of the blocks that can be handed out
+    uint32_t fBlockCount;           // size of a block in units of Block
+    uint32_t fBlocksPerChunk;
+    uint32_t fUsed;
+    std::size_t fBlockSize;
+    mutable std::mutex fMutex;
+
+    const Pool* _initCheck;
+};
+
+/**
+ * base of the classes whose objects come from one pool per class: class T : public PoolAllocated<T>.
+ * Classes derived from T have another size and use the heap.
+ */
+template<class T>
+class PoolAllocated
+{
+public:
+    static void* operator new(std::size_t size)
+    {
+        if(size != sizeof(T)) return ::operator new(size);
+        return fgPool.allocate();
+    }
+
+    static void operator delete(void* pointer, std::size_t size)
+    {
+        if(size != sizeof(T)) ::operator delete(pointer);
+        else fgPool.deallocate(pointer);
+    }
+
+protected:
+    static Pool fgPool;
+};
+
+template<class T>
+Pool PoolAllocated<T>::fgPool(sizeof(T));
+
+/**
+ * hands out memory of any size from big chunks, the memory is only given back when the arena is destroyed.
+ * Used for objects that live as long as the network, such as the traffic signs.
+ */
+class Arena
+{
+public:
+    /**
+     * REQUIRE(kChunkSize > 0, "Chunk size must be greater than 0");
+     *
+     * ENSURE(this->properlyInitialized(), "Arena constructor must end in properlyInitialized state");
+     */
+    explicit Arena(std::size_t kChunkSize = 1 << 16);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Arena was not initialized when calling the destructor");
+     */
+    ~Arena();
+
+    bool properlyInitialized() const;
+
+    /**
+     * the amount of bytes that have been handed out
+     *
+     * REQUIRE(this->properlyInitialized(), "Arena was not initialized when calling getNumBytes");
+     */
+    std::size_t getNumBytes() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Arena was not initialized when calling allocate");
+     * ENSURE(getNumBytes() >= old.getNumBytes() + kSize, "memory was not handed out");
+     */
+    void* allocate(std::size_t kSize);
+
+private:
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    std::vector<char*> fChunks;
+    std::size_t fChunkSize;
+    std::size_t fOffset;            // first free byte in the last chunk
+    std::size_t fBytes;
+    mutable std::mutex fMutex;
+
+    const Arena* _initCheck;
+};
+
+/**
+ * base of the objects that can be allocated from an arena: new (arena) T(...) puts the object in the arena, which
+ * gives the memory back when it is destroyed. With a NULL arena, or a plain new, the object comes from the heap.
+ * An object from an arena must not be deleted.
+ */
+class ArenaAllocated
+{
+public:
+    static void* operator new(std::size_t size, Arena* arena);
+    static void operator delete(void* pointer, Arena* arena);      // only called when the constructor throws
+
+    static void* operator new(std::size_t size);
+    static void operator delete(void* pointer);
+};
+
+
+#endif //SIMULATION_ALLOCATOR_H
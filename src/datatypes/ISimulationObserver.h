@@ -0,0 +1,32 @@
+//============================================================================
+// @name        : ISimulationObserver.h
+// @author      : Thomas Dooms
+// @date        : 5/20/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : pure virtual class that drives a running simulation from outside (gui, batch runs)
+//============================================================================
+
+#ifndef SIMULATION_ISIMULATIONOBSERVER_H
+#define SIMULATION_ISIMULATIONOBSERVER_H
+
+class Network;
+
+class ISimulationObserver
+{
+public:
+    virtual ~ISimulationObserver() {}
+
+    /**
+     * called before every tick, the tick is skipped when this returns false (e.g. the simulation is paused)
+     */
+    virtual bool beforeTick(const Network* kNetwork) = 0;
+
+    /**
+     * called after every tick that has been simulated
+     */
+    virtual void afterTick(const Network* kNetwork) = 0;
+};
+
+
+#endif //SIMULATION_ISIMULATIONOBSERVER_H
@@ -0,0 +1,262 @@
+//============================================================================
+// @name        : Lane.cpp
+// @author      : Thomas Dooms
+// @date        : 5/21/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : the vehicles of a lane, ordered from front to back, with their hot state in contiguous arrays
+//============================================================================
+
+#include <algorithm>
+#include "Lane.h"
+#include "../DesignByContract.h"
+
+Lane::Lane()
+{
+    fHead = 0;
+    _initCheck = this;
+    ENSURE(this->properlyInitialized(), "Lane constructor must end in properlyInitialized state");
+}
+
+Lane::Lane(const Lane& kOther)
+    : fHead(kOther.fHead), fVehicles(kOther.fVehicles), fPositions(kOther.fPositions), fVelocities(kOther.fVelocities),
+      fAccelerations(kOther.fAccelerations), fConstants(kOther.fConstants), fFlags(kOther.fFlags)
+{
+    _initCheck = this;
+    ENSURE(this->properlyInitialized(), "Lane copy constructor must end in properlyInitialized state");
+}
+
+Lane& Lane::operator=(const Lane& kOther)
+{
+    fHead = kOther.fHead;
+    fVehicles = kOther.fVehicles;
+    fPositions = kOther.fPositions;
+    fVelocities = kOther.fVelocities;
+    fAccelerations = kOther.fAccelerations;
+    fConstants = kOther.fConstants;
+    fFlags = kOther.fFlags;
+    _initCheck = this;
+    return *this;
+}
+
+bool Lane::properlyInitialized() const
+{
+    return _initCheck == this;
+}
+
+//--------------------------------------------------------------------------------------------------//
+
+uint32_t Lane::size() const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling size");
+    return fVehicles.size() - fHead;
+}
+
+bool Lane::empty() const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling empty");
+    return fVehicles.size() == fHead;
+}
+
+IVehicle* Lane::operator[](const uint32_t kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling operator[]");
+    REQUIRE(kIndex < size(), "Index is out of range");
+    return fVehicles[fHead + kIndex];
+}
+
+IVehicle* Lane::front() const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling front");
+    REQUIRE(!empty(), "Lane cannot be empty when calling front");
+    return fVehicles[fHead];
+}
+
+IVehicle* Lane::back() const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling back");
+    REQUIRE(!empty(), "Lane cannot be empty when calling back");
+    return fVehicles.back();
+}
+
+//--------------------------------------------------------------------------------------------------//
+
+void Lane::pushBack(IVehicle* const kVehicle)
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling pushBack");
+    REQUIRE(kVehicle->properlyInitialized(), "Vehicle was not initialized when calling pushBack");
+    insert(size(), kVehicle);
+}
+
+void Lane::insert(const uint32_t kIndex, IVehicle* const kVehicle)
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling insert");
+    REQUIRE(kVehicle->properlyInitialized(), "Vehicle was not initialized when calling insert");
+    REQUIRE(kIndex <= size(), "Index is out of range");
+
+    if(kIndex == 0 and fHead > 0)       // reuse the room an erased vehicle left at the front
+    {
+        fHead--;
+        fVehicles[fHead] = kVehicle;
+        fConstants[fHead] = &kVehicle->getConstants();
+        fFlags[fHead] = 0;
+        store(0);
+        return;
+    }
+
+    const uint32_t kPosition = fHead + kIndex;
+    fVehicles.insert(fVehicles.begin() + kPosition, kVehicle);
+    fPositions.insert(fPositions.begin() + kPosition, 0);
+    fVelocities.insert(fVelocities.begin() + kPosition, 0);
+    fAccelerations.insert(fAccelerations.begin() + kPosition, 0);
+    fConstants.insert(fConstants.begin() + kPosition, &kVehicle->getConstants());
+    fFlags.insert(fFlags.begin() + kPosition, 0);
+    store(kIndex);
+}
+
+void Lane::erase(const uint32_t kIndex)
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling erase");
+    REQUIRE(kIndex < size(), "Index is out of range");
+
+    if(kIndex == 0)
+    {
+        fVehicles[fHead] = NULL;
+        fHead++;
+        compact();
+        return;
+    }
+
+    const uint32_t kPosition = fHead + kIndex;
+    fVehicles.erase(fVehicles.begin() + kPosition);
+    fPositions.erase(fPositions.begin() + kPosition);
+    fVelocities.erase(fVelocities.begin() + kPosition);
+    fAccelerations.erase(fAccelerations.begin() + kPosition);
+    fConstants.erase(fConstants.begin() + kPosition);
+    fFlags.erase(fFlags.begin() + kPosition);
+}
+
+uint32_t Lane::find(const IVehicle* const kVehicle) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling find");
+    for(uint32_t i = fHead; i < fVehicles.size(); i++) if(fVehicles[i] == kVehicle) return i - fHead;
+    return size();
+}
+
+uint32_t Lane::find(const IVehicle* const kVehicle, const uint32_t kHint) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling find");
+
+    const uint32_t kSize = size();
+    const uint32_t kStart = std::min(kHint, kSize);
+    for(uint32_t i = 0; kStart + i < kSize or i <= kStart; i++)
+    {
+        if(kStart + i < kSize and fVehicles[fHead + kStart + i] == kVehicle) return kStart + i;
+        if(i != 0 and i <= kStart and fVehicles[fHead + kStart - i] == kVehicle) return kStart - i;
+    }
+    return kSize;
+}
+
+uint32_t Lane::findBehind(const double kPosition) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling findBehind");
+
+    uint32_t low = 0;
+    uint32_t high = size();
+    while(low < high)
+    {
+        const uint32_t kMiddle = low + (high - low) / 2;
+        if(kPosition > fVehicles[fHead + kMiddle]->getPosition()) high = kMiddle;
+        else low = kMiddle + 1;
+    }
+    return low;
+}
+
+void Lane::store(const uint32_t kIndex)
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling store");
+    REQUIRE(kIndex < size(), "Index is out of range");
+
+    const uint32_t kPosition = fHead + kIndex;
+    const IVehicle* const kVehicle = fVehicles[kPosition];
+    fPositions[kPosition] = kVehicle->getPosition();
+    fVelocities[kPosition] = kVehicle->getVelocity();
+    fAccelerations[kPosition] = kVehicle->getAcceleration();
+    fFlags[kPosition] = (fFlags[kPosition] & kGhost) | (kVehicle->getStationed() ? kStationed : 0) | (kVehicle->getMerging() ? kMerging : 0);
+}
+
+void Lane::storeAll()
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling storeAll");
+    for(uint32_t i = 0; i < size(); i++) store(i);
+}
+
+void Lane::setGhost(const uint32_t kIndex)
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling setGhost");
+    REQUIRE(kIndex < size(), "Index is out of range");
+    fFlags[fHead + kIndex] |= kGhost;
+}
+
+//--------------------------------------------------------------------------------------------------//
+
+double Lane::getPosition(const uint32_t kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getPosition");
+    REQUIRE(kIndex < size(), "Index is out of range");
+    return fPositions[fHead + kIndex];
+}
+
+double Lane::getVelocity(const uint32_t kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getVelocity");
+    REQUIRE(kIndex < size(), "Index is out of range");
+    return fVelocities[fHead + kIndex];
+}
+
+double Lane::getAcceleration(const uint32_t kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getAcceleration");
+    REQUIRE(kIndex < size(), "Index is out of range");
+    return fAccelerations[fHead + kIndex];
+}
+
+const VehicleConstants& Lane::getConstants(const uint32_t kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getConstants");
+    REQUIRE(kIndex < size(), "Index is out of range");
+    return *fConstants[fHead + kIndex];
+}
+
+uint8_t Lane::getFlags(const uint32_t kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getFlags");
+    REQUIRE(kIndex < size(), "Index is out of range");
+    return fFlags[fHead + kIndex];
+}
+
+//--------------------------------------------------------------------------------------------------//
+
+void Lane::compact()
+{
+    if(fHead == fVehicles.size())       // the lane is empty, start over at the front
+    {
+        fHead = 0;
+        fVehicles.clear();
+        fPositions.clear();
+        fVelocities.clear();
+        fAccelerations.clear();
+        fConstants.clear();
+        fFlags.clear();
+        return;
+    }
+    if(fHead < 16 or 2 * fHead < fVehicles.size()) return;
+
+    fVehicles.erase(fVehicles.begin(), fVehicles.begin() + fHead);
+    fPositions.erase(fPositions.begin(), fPositions.begin() + fHead);
+    fVelocities.erase(fVelocities.begin(), fVelocities.begin() + fHead);
+    fAccelerations.erase(fAccelerations.begin(), fAccelerations.begin() + fHead);
+    fConstants.erase(fConstants.begin(), fConstants.begin() + fHead);
+    fFlags.erase(fFlags.begin(), fFlags.begin() + fHead);
+    fHead = 0;
+}
@@ -0,0 +1,195 @@
+//============================================================================
+// @name        : Lane.h
+// @author      : Thomas Dooms
+// @date        : 5/21/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : the vehicles of a lane, ordered from front to back, with their hot state in contiguous arrays
+//============================================================================
+
+#ifndef SIMULATION_LANE_H
+#define SIMULATION_LANE_H
+
+#include <stdint.h>
+#include <vector>
+#include "vehicles/IVehicle.h"
+
+class Lane
+{
+    friend class SnapshotParser;
+public:
+    enum EFlags {kStationed = 1, kMerging = 2, kGhost = 4};    // a ghost is the old lane entry of a merging vehicle
+
+    /**
+     * ENSURE(this->properlyInitialized(), "Lane constructor must end in properlyInitialized state");
+     */
+    Lane();
+
+    /**
+     * ENSURE(this->properlyInitialized(), "Lane copy constructor must end in properlyInitialized state");
+     */
+    Lane(const Lane& kOther);
+
+    Lane& operator=(const Lane& kOther);
+
+    bool properlyInitialized() const;
+
+    //--------------------------------------------------------------------------------------------------//
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling size");
+     */
+    uint32_t size() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling empty");
+     */
+    bool empty() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling operator[]");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    IVehicle* operator[](uint32_t kIndex) const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling front");
+     * REQUIRE(!empty(), "Lane cannot be empty when calling front");
+     */
+    IVehicle* front() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling back");
+     * REQUIRE(!empty(), "Lane cannot be empty when calling back");
+     */
+    IVehicle* back() const;
+
+    //--------------------------------------------------------------------------------------------------//
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling pushBack");
+     * REQUIRE(kVehicle->properlyInitialized(), "Vehicle was not initialized when calling pushBack");
+     */
+    void pushBack(IVehicle* kVehicle);
+
+    /**
+     * inserting at the front or the back of the lane is O(1)
+     *
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling insert");
+     * REQUIRE(kVehicle->properlyInitialized(), "Vehicle was not initialized when calling insert");
+     * REQUIRE(kIndex <= size(), "Index is out of range");
+     */
+    void insert(uint32_t kIndex, IVehicle* kVehicle);
+
+    /**
+     * erasing the front of the lane is O(1)
+     *
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling erase");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    void erase(uint32_t kIndex);
+
+    /**
+     * returns the index of the vehicle in this lane, or size() if it is not in this lane
+     *
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling find");
+     */
+    uint32_t find(const IVehicle* kVehicle) const;
+
+    /**
+     * the same as find, but the search starts at kHint and goes outward from there
+     *
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling find");
+     */
+    uint32_t find(const IVehicle* kVehicle, uint32_t kHint) const;
+
+    /**
+     * the index of the first vehicle that is behind kPosition, or size() if there is none.
+     * Uses binary search on the current positions of the vehicles, which are sorted from front to back.
+     *
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling findBehind");
+     */
+    uint32_t findBehind(double kPosition) const;
+
+    /**
+     * copies the current state of the vehicle at kIndex to the arrays, must be called after every move
+     *
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling store");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    void store(uint32_t kIndex);
+
+    /**
+     * copies the current state of every vehicle to the arrays
+     *
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling storeAll");
+     */
+    void storeAll();
+
+    /**
+     * marks the vehicle at kIndex as the entry a merging vehicle leaves behind, it is not moved from this lane
+     *
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling setGhost");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    void setGhost(uint32_t kIndex);
+
+    //--------------------------------------------------------------------------------------------------//
+    //          al de onderstaande functies lezen de toestand zoals die laatst opgeslagen is            //
+    //--------------------------------------------------------------------------------------------------//
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getPosition");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    double getPosition(uint32_t kIndex) const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getVelocity");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    double getVelocity(uint32_t kIndex) const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getAcceleration");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    double getAcceleration(uint32_t kIndex) const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getConstants");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    const VehicleConstants& getConstants(uint32_t kIndex) const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Lane was not initialized when calling getFlags");
+     * REQUIRE(kIndex < size(), "Index is out of range");
+     */
+    uint8_t getFlags(uint32_t kIndex) const;
+
+private:
+    /**
+     * removes the erased vehicles in front of fHead from the arrays once they take up half of them,
+     * so erasing at the front stays O(1) amortized
+     */
+    void compact();
+
+    // the vehicles of the lane are stored from fHead until the end of the arrays, the vehicles that leave
+    // the lane at the front only move fHead so the rest of the lane is not shifted.
+    uint32_t fHead;
+    std::vector<IVehicle*> fVehicles;
+
+    // a copy of the state of the vehicles, which IVehicle owns. It is only refreshed by store and storeAll, so
+    // during a buffered update the lanes still hold the previous tick while the vehicles compute the next one.
+    std::vector<double> fPositions;
+    std::vector<double> fVelocities;
+    std::vector<double> fAccelerations;
+    std::vector<const VehicleConstants*> fConstants;
+    std::vector<uint8_t> fFlags;
+
+    const Lane* _initCheck;
+};
+
+
+#endif //SIMULATION_LANE_H
@@ -0,0 +1,217 @@
+//============================================================================
+// @name        : LaneKernel.cpp
+// @author      : Thomas Dooms
+// @date        : 5/24/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : computes the car-following step of a whole lane at once, with SSE2 or AVX2 if possible
+//============================================================================
+
+#include <algorithm>
+#include "LaneKernel.h"
+#include "../DesignByContract.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMULATION_X86
+#include <immintrin.h>
+#endif
+
+// all kernels must give exactly the same bits as IVehicle, so the operations are done in the same order and
+// min / max take their operands in the same order as std::min and std::max do.
+namespace
+{
+    double clampScalar(double val, double min, double max){ return std::max(std::min(val, max), min); }
+
+    void followScalar(LaneBatch& batch, const uint32_t kBegin)
+    {
+        for(uint32_t i = kBegin; i < batch.size(); i++)
+        {
+            const double kPosition = batch.fPositions[i];
+            const double kVelocity = batch.fVelocities[i];
+            const double kLength = batch.fLeaderLengths[i];
+            const double kMinAcceleration = batch.fMinAccelerations[i];
+            const double kMaxAcceleration = batch.fMaxAccelerations[i];
+
+            double acceleration = kMaxAcceleration;
+            if(kLength > 0)
+            {
+                const double kLeaderVelocity = batch.fLeaderVelocities[i];
+                const double kIdeal = (kVelocity - kLeaderVelocity > -kMinAcceleration) ? 1.5 * kVelocity + kLength + 2 : 0.75 * kVelocity + kLength + 2;
+                const double kActual = batch.fLeaderPositions[i] - kLeaderVelocity - kLength - kPosition;
+                acceleration = 0.5 * (kActual - kIdeal);
+            }
+            acceleration = std::min(acceleration, batch.fSafeAccelerations[i]);
+
+            const double kMaxSpeed = std::min(batch.fSpeedLimits[i], batch.fMaxSpeeds[i]);
+            const double kMinSpeed = std::max(0.0, batch.fMinSpeeds[i]);
+            const double kClampedMax = clampScalar(kMaxSpeed - kVelocity, kMinAcceleration, kMaxAcceleration);
+            const double kClampedMin = clampScalar(kMinSpeed - kVelocity, kMinAcceleration, kMaxAcceleration);
+
+            batch.fAccelerations[i] = clampScalar(acceleration, kClampedMin, kClampedMax);
+            batch.fVelocities[i] = kVelocity + batch.fAccelerations[i];
+            batch.fPositions[i] = kPosition + batch.fVelocities[i];
+        }
+    }
+
+#ifdef SIMULATION_X86
+    uint32_t followSSE2(LaneBatch& batch)
+    {
+        const __m128d kZero = _mm_setzero_pd();
+        const __m128d kSign = _mm_set1_pd(-0.0);
+        const __m128d kHalf = _mm_set1_pd(0.5);
+        const __m128d kThreeQuarters = _mm_set1_pd(0.75);
+        const __m128d kOneAndHalf = _mm_set1_pd(1.5);
+        const __m128d kTwo = _mm_set1_pd(2);
+
+        uint32_t i = 0;
+        for(; i + 2 <= batch.size(); i += 2)
+        {
+            const __m128d kPosition = _mm_loadu_pd(&batch.fPositions[i]);
+            const __m128d kVelocity = _mm_loadu_pd(&batch.fVelocities[i]);
+            const __m128d kLeaderPosition = _mm_loadu_pd(&batch.fLeaderPositions[i]);
+            const __m128d kLeaderVelocity = _mm_loadu_pd(&batch.fLeaderVelocities[i]);
+            const __m128d kLength = _mm_loadu_pd(&batch.fLeaderLengths[i]);
+            const __m128d kMinAcceleration = _mm_loadu_pd(&batch.fMinAccelerations[i]);
+            const __m128d kMaxAcceleration = _mm_loadu_pd(&batch.fMaxAccelerations[i]);
+
+            const __m128d kFast = _mm_cmpgt_pd(_mm_sub_pd(kVelocity, kLeaderVelocity), _mm_xor_pd(kMinAcceleration, kSign));
+            const __m128d kIdealFast = _mm_add_pd(_mm_add_pd(_mm_mul_pd(kOneAndHalf, kVelocity), kLength), kTwo);
+            const __m128d kIdealSlow = _mm_add_pd(_mm_add_pd(_mm_mul_pd(kThreeQuarters, kVelocity), kLength), kTwo);
+            const __m128d kIdeal = _mm_or_pd(_mm_and_pd(kFast, kIdealFast), _mm_andnot_pd(kFast, kIdealSlow));
+            const __m128d kActual = _mm_sub_pd(_mm_sub_pd(_mm_sub_pd(kLeaderPosition, kLeaderVelocity), kLength), kPosition);
+            const __m128d kFollow = _mm_mul_pd(kHalf, _mm_sub_pd(kActual, kIdeal));
+
+            const __m128d kLeader = _mm_cmpgt_pd(kLength, kZero);
+            const __m128d kUnsafe = _mm_or_pd(_mm_and_pd(kLeader, kFollow), _mm_andnot_pd(kLeader, kMaxAcceleration));
+            const __m128d kAcceleration = _mm_min_pd(_mm_loadu_pd(&batch.fSafeAccelerations[i]), kUnsafe);
+
+            const __m128d kMaxSpeed = _mm_min_pd(_mm_loadu_pd(&batch.fMaxSpeeds[i]), _mm_loadu_pd(&batch.fSpeedLimits[i]));
+            const __m128d kMinSpeed = _mm_max_pd(_mm_loadu_pd(&batch.fMinSpeeds[i]), kZero);
+            const __m128d kClampedMax = _mm_max_pd(kMinAcceleration, _mm_min_pd(kMaxAcceleration, _mm_sub_pd(kMaxSpeed, kVelocity)));
+            const __m128d kClampedMin = _mm_max_pd(kMinAcceleration, _mm_min_pd(kMaxAcceleration, _mm_sub_pd(kMinSpeed, kVelocity)));
+
+            const __m128d kResult = _mm_max_pd(kClampedMin, _mm_min_pd(kClampedMax, kAcceleration));
+            const __m128d kNewVelocity = _mm_add_pd(kVelocity, kResult);
+            _mm_storeu_pd(&batch.fAccelerations[i], kResult);
+            _mm_storeu_pd(&batch.fVelocities[i], kNewVelocity);
+            _mm_storeu_pd(&batch.fPositions[i], _mm_add_pd(kPosition, kNewVelocity));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    uint32_t followAVX2(LaneBatch& batch)
+    {
+        const __m256d kZero = _mm256_setzero_pd();
+        const __m256d kSign = _mm256_set1_pd(-0.0);
+        const __m256d kHalf = _mm256_set1_pd(0.5);
+        const __m256d kThreeQuarters = _mm256_set1_pd(0.75);
+        const __m256d kOneAndHalf = _mm256_set1_pd(1.5);
+        const __m256d kTwo = _mm256_set1_pd(2);
+
+        uint32_t i = 0;
+        for(; i + 4 <= batch.size(); i += 4)
+        {
+            const __m256d kPosition = _mm256_loadu_pd(&batch.fPositions[i]);
+            const __m256d kVelocity = _mm256_loadu_pd(&batch.fVelocities[i]);
+            const __m256d kLeaderPosition = _mm256_loadu_pd(&batch.fLeaderPositions[i]);
+            const __m256d kLeaderVelocity = _mm256_loadu_pd(&batch.fLeaderVelocities[i]);
+            const __m256d kLength = _mm256_loadu_pd(&batch.fLeaderLengths[i]);
+            const __m256d kMinAcceleration = _mm256_loadu_pd(&batch.fMinAccelerations[i]);
+            const __m256d kMaxAcceleration = _mm256_loadu_pd(&batch.fMaxAccelerations[i]);
+
+            const __m256d kFast = _mm256_cmp_pd(_mm256_sub_pd(kVelocity, kLeaderVelocity), _mm256_xor_pd(kMinAcceleration, kSign), _CMP_GT_OQ);
+            const __m256d kIdealFast = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(kOneAndHalf, kVelocity), kLength), kTwo);
+            const __m256d kIdealSlow = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(kThreeQuarters, kVelocity), kLength), kTwo);
+            const __m256d kIdeal = _mm256_blendv_pd(kIdealSlow, kIdealFast, kFast);
+            const __m256d kActual = _mm256_sub_pd(_mm256_sub_pd(_mm256_sub_pd(kLeaderPosition, kLeaderVelocity), kLength), kPosition);
+            const __m256d kFollow = _mm256_mul_pd(kHalf, _mm256_sub_pd(kActual, kIdeal));
+
+            const __m256d kLeader = _mm256_cmp_pd(kLength, kZero, _CMP_GT_OQ);
+            const __m256d kUnsafe = _mm256_blendv_pd(kMaxAcceleration, kFollow, kLeader);
+            const __m256d kAcceleration = _mm256_min_pd(_mm256_loadu_pd(&batch.fSafeAccelerations[i]), kUnsafe);
+
+            const __m256d kMaxSpeed = _mm256_min_pd(_mm256_loadu_pd(&batch.fMaxSpeeds[i]), _mm256_loadu_pd(&batch.fSpeedLimits[i]));
+            const __m256d kMinSpeed = _mm256_max_pd(_mm256_loadu_pd(&batch.fMinSpeeds[i]), kZero);
+            const __m256d kClampedMax = _mm256_max_pd(kMinAcceleration, _mm256_min_pd(kMaxAcceleration, _mm256_sub_pd(kMaxSpeed, kVelocity)));
+            const __m256d kClampedMin = _mm256_max_pd(kMinAcceleration, _mm256_min_pd(kMaxAcceleration, _mm256_sub_pd(kMinSpeed, kVelocity)));
+
+            const __m256d kResult = _mm256_max_pd(kClampedMin, _mm256_min_pd(kClampedMax, kAcceleration));
+            const __m256d kNewVelocity = _mm256_add_pd(kVelocity, kResult);
+            _mm256_storeu_pd(&batch.fAccelerations[i], kResult);
+            _mm256_storeu_pd(&batch.fVelocities[i], kNewVelocity);
+            _mm256_storeu_pd(&batch.fPositions[i], _mm256_add_pd(kPosition, kNewVelocity));
+        }
+        return i;
+    }
+#endif
+
+    EInstructionSet detectInstructionSet()
+    {
+#ifdef SIMULATION_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) return kAVX2;
+        if(__builtin_cpu_supports("sse2")) return kSSE2;
+#endif
+        return kScalar;
+    }
+}
+
+uint32_t LaneBatch::size() const
+{
+    return fPositions.size();
+}
+
+void LaneBatch::clear()
+{
+    fPositions.clear();
+    fVelocities.clear();
+    fAccelerations.clear();
+    fLeaderPositions.clear();
+    fLeaderVelocities.clear();
+    fLeaderLengths.clear();
+    fSpeedLimits.clear();
+    fMinSpeeds.clear();
+    fMaxSpeeds.clear();
+    fMinAccelerations.clear();
+    fMaxAccelerations.clear();
+    fSafeAccelerations.clear();
+}
+
+void LaneBatch::push(const double kPosition, const double kVelocity, const double kLeaderPosition, const double kLeaderVelocity, const double kLeaderLength,
+                     const double kSpeedLimit, const double kMinSpeed, const double kMaxSpeed, const double kMinAcceleration, const double kMaxAcceleration,
+                     const double kSafeAcceleration)
+{
+    REQUIRE(kMaxAcceleration > kMinAcceleration, "vehicle constants are ill-formed");
+
+    fPositions.push_back(kPosition);
+    fVelocities.push_back(kVelocity);
+    fAccelerations.push_back(0);
+    fLeaderPositions.push_back(kLeaderPosition);
+    fLeaderVelocities.push_back(kLeaderVelocity);
+    fLeaderLengths.push_back(kLeaderLength);
+    fSpeedLimits.push_back(kSpeedLimit);
+    fMinSpeeds.push_back(kMinSpeed);
+    fMaxSpeeds.push_back(kMaxSpeed);
+    fMinAccelerations.push_back(kMinAcceleration);
+    fMaxAccelerations.push_back(kMaxAcceleration);
+    fSafeAccelerations.push_back(kSafeAcceleration);
+}
+
+EInstructionSet getInstructionSet()
+{
+    static const EInstructionSet kSet = detectInstructionSet();
+    return kSet;
+}
+
+void followLeaders(LaneBatch& batch, const EInstructionSet kSet)
+{
+    REQUIRE(kSet <= getInstructionSet(), "instruction set is not supported");
+
+    uint32_t done = 0;
+#ifdef SIMULATION_X86
+    if(kSet == kAVX2) done = followAVX2(batch);
+    else if(kSet == kSSE2) done = followSSE2(batch);
+#endif
+    followScalar(batch, done);       // the vehicles that do not fill a whole register
+}
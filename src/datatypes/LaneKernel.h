@@ -0,0 +1,68 @@
+//============================================================================
+// @name        : LaneKernel.h
+// @author      : Thomas Dooms
+// @date        : 5/24/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : computes the car-following step of a whole lane at once, with SSE2 or AVX2 if possible
+//============================================================================
+
+#ifndef SIMULATION_LANEKERNEL_H
+#define SIMULATION_LANEKERNEL_H
+
+#include <stdint.h>
+#include <vector>
+#include <limits>
+
+enum EKernelMode {kKernelOff, kKernelOn, kKernelValidate};
+
+enum EInstructionSet {kScalar, kSSE2, kAVX2};
+
+/**
+ * the vehicles of one lane that follow their leader without slowing down for a traffic sign,
+ * every array has one element per vehicle. A leader length of 0 means the vehicle has no leader.
+ * The safe acceleration is the upper bound of IVehicle::getSafeAcceleration, infinite if there is none.
+ */
+struct LaneBatch
+{
+    std::vector<double> fPositions;
+    std::vector<double> fVelocities;
+    std::vector<double> fAccelerations;
+
+    std::vector<double> fLeaderPositions;
+    std::vector<double> fLeaderVelocities;
+    std::vector<double> fLeaderLengths;
+
+    std::vector<double> fSpeedLimits;
+    std::vector<double> fMinSpeeds;
+    std::vector<double> fMaxSpeeds;
+    std::vector<double> fMinAccelerations;
+    std::vector<double> fMaxAccelerations;
+    std::vector<double> fSafeAccelerations;
+
+    uint32_t size() const;
+    void clear();
+
+    /**
+     * REQUIRE(kMaxAcceleration > kMinAcceleration, "vehicle constants are ill-formed");
+     */
+    void push(double kPosition, double kVelocity, double kLeaderPosition, double kLeaderVelocity, double kLeaderLength,
+              double kSpeedLimit, double kMinSpeed, double kMaxSpeed, double kMinAcceleration, double kMaxAcceleration,
+              double kSafeAcceleration = std::numeric_limits<double>::infinity());
+};
+
+/**
+ * the best instruction set this processor supports
+ */
+EInstructionSet getInstructionSet();
+
+/**
+ * computes the new acceleration, velocity and position of every vehicle in the batch, exactly the same as
+ * IVehicle::moveBuffered does for a vehicle that is not slowing down. The positions and velocities are overwritten.
+ *
+ * REQUIRE(kSet <= getInstructionSet(), "instruction set is not supported");
+ */
+void followLeaders(LaneBatch& batch, EInstructionSet kSet);
+
+
+#endif //SIMULATION_LANEKERNEL_H
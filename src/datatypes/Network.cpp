@@ -9,24 +9,47 @@
 #include <stdint.h>
 #include <sstream>
 #include <iostream>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
 #include "Network.h"
 #include "../exporters/NetworkExporter.h"
 #include "../DesignByContract.h"
 #include "../exporters/VehicleExporter.h"
+#include "../exporters/SnapshotExporter.h"
 
 const int Network::fgkMaxTicks = 1000;
 
-Network::Network(const std::vector<Road*>& roads)
+Network::Network(const std::vector<Road*>& roads, Arena* const signArena)
 {
     fTicksPassed = 0;
+    fEpoch = 0;
+    fMaxTicks = fgkMaxTicks;
+    fMaxTime = 0;
+    fSteadyTicks = 0;
+    fSteadyCount = 0;
+    fSteadyThreshold = 0;
+    fPrevStatistics = std::pair<double, double>(0, 0);
+    fStopReason = kRunning;
     fRoads = roads;
+    fSignArena = signArena;
+    fThreads = 1;
+    fScheduler = NULL;
+    fDoubleBuffered = false;
+    fKernelMode = kKernelOff;
+    fCheckpointInterval = 0;
+    for(uint32_t i = 0; i < 3; i++) fOutputSizes[i] = 0;
+    for(uint32_t i = 0; i < fRoads.size(); i++) fRoads[i]->setRetired(&fRetired);
     _initCheck = this;
     ENSURE(this->properlyInitialized(), "Vehicle constructor must end in properlyInitialized state");
 }
 
 Network::~Network()
 {
+    delete fScheduler;
+    for(uint32_t i = 0; i < fRetired.size(); i++) delete fRetired[i];
     for(uint32_t i = 0; i < fRoads.size(); i++) delete fRoads[i];
+    delete fSignArena;
 }
 
 bool Network::properlyInitialized() const
@@ -40,28 +63,179 @@ int Network::getTicksPassed() const
     return fTicksPassed;
 }
 
-void Network::startSimulation(Window* window, const std::string& simpleOutput, const std::string& impressionOutput, const bool debug)
+uint32_t Network::getEpoch() const
 {
-    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling startSimulation");
-    VehicleExporter::init("statistics");
-    NetworkExporter::init(this, simpleOutput, impressionOutput);
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getEpoch");
+    return fEpoch;
+}
+
+int Network::getMaxTicks() const
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getMaxTicks");
+    return fMaxTicks;
+}
+
+void Network::setMaxTicks(const int kMaxTicks)
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setMaxTicks");
+    REQUIRE(kMaxTicks >= 0, "Amount of ticks must be a positive integer");
+    fMaxTicks = kMaxTicks;
+    ENSURE(getMaxTicks() == kMaxTicks, "new max ticks not set when calling setMaxTicks");
+}
+
+double Network::getMaxTime() const
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getMaxTime");
+    return fMaxTime;
+}
+
+void Network::setMaxTime(const double kSeconds)
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setMaxTime");
+    REQUIRE(kSeconds >= 0, "Amount of seconds must be positive");
+    fMaxTime = kSeconds;
+    ENSURE(getMaxTime() == kSeconds, "new max time not set when calling setMaxTime");
+}
+
+void Network::setSteadyState(const uint32_t kTicks, const double kThreshold)
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setSteadyState");
+    REQUIRE(kThreshold >= 0, "Threshold must be positive");
+    fSteadyTicks = kTicks;
+    fSteadyThreshold = kThreshold;
+}
+
+Network::EStopReason Network::getStopReason() const
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getStopReason");
+    return fStopReason;
+}
+
+uint32_t Network::getThreads() const
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getThreads");
+    return fThreads;
+}
+
+void Network::setThreads(const uint32_t kThreads)
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setThreads");
+    REQUIRE(kThreads > 0, "Amount of threads must be greater than 0");
+
+    delete fScheduler;
+    fScheduler = NULL;
+    for(uint32_t i = 0; i < fRoads.size(); i++) fRoads[i]->setRetired(&fRetired);
 
-    while(fTicksPassed < fgkMaxTicks)
+    if(kThreads > 1) fScheduler = new RoadScheduler(fRoads, kThreads);
+    fThreads = kThreads;
+
+    ENSURE(getThreads() == kThreads, "new amount of threads not set when calling setThreads");
+}
+
+bool Network::isDoubleBuffered() const
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling isDoubleBuffered");
+    return fDoubleBuffered;
+}
+
+void Network::setDoubleBuffered(const bool kDoubleBuffered)
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setDoubleBuffered");
+
+    // the lanes only hold the state of the vehicles that have moved last tick, start from the actual state
+    if(kDoubleBuffered and not fDoubleBuffered)
     {
-        if(debug or checkWindow(window->getState()))
+        for(uint32_t i = 0; i < fRoads.size(); i++) fRoads[i]->commitVehicles();
+    }
+    fDoubleBuffered = kDoubleBuffered;
+
+    ENSURE(isDoubleBuffered() == kDoubleBuffered, "new mode not set when calling setDoubleBuffered");
+}
+
+EKernelMode Network::getKernelMode() const
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getKernelMode");
+    return fKernelMode;
+}
+
+void Network::setKernelMode(const EKernelMode kMode)
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setKernelMode");
+
+    for(uint32_t i = 0; i < fRoads.size(); i++) fRoads[i]->setKernelMode(kMode);
+    fKernelMode = kMode;
+
+    ENSURE(getKernelMode() == kMode, "new mode not set when calling setKernelMode");
+}
+
+uint64_t Network::getKernelMismatches() const
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getKernelMismatches");
+
+    uint64_t mismatches = 0;
+    for(uint32_t i = 0; i < fRoads.size(); i++) mismatches += fRoads[i]->getKernelMismatches();
+    return mismatches;
+}
+
+std::pair<double, double> Network::getStatistics() const
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getStatistics");
+    uint32_t amount = 0;
+    double velocity = 0;
+    double length = 0;
+
+    for(uint32_t i = 0; i < fRoads.size(); i++)
+    {
+        for(uint32_t j = 0; j < fRoads[i]->getNumLanes(); j++)
         {
-            if (!debug and window->getState() == Window::kNext) window->setCrState(Window::kPause);
+            const Lane& kLane = (*fRoads[i])[j];
+            for(uint32_t k = 0; k < kLane.size(); k++) velocity += kLane[k]->getVelocity();
+            amount += kLane.size();
+        }
+        length += fRoads[i]->getRoadLength() * fRoads[i]->getNumLanes();
+    }
+    if(amount == 0) return std::pair<double, double>(0, 0);
+    return std::pair<double, double>(velocity / amount, velocity / length);
+}
 
-            if(update()) break;
-            if(not debug) NetworkExporter::cgExport(this, 0);
-            if(not debug) window->updateSimpleOutput(NetworkExporter::addSection(this, fTicksPassed));
-            if(not debug) Window::processEvents();
+void Network::startSimulation(ISimulationObserver* const observer, const std::string& simpleOutput, const std::string& impressionOutput)
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling startSimulation");
+    VehicleExporter::init("statistics", fOutputSizes[0]);
+    NetworkExporter::init(this, simpleOutput, impressionOutput, std::pair<uint64_t, uint64_t>(fOutputSizes[1], fOutputSizes[2]));
+
+    const std::chrono::steady_clock::time_point kStart = std::chrono::steady_clock::now();
+
+    fStopReason = kRunning;
+    if(fTicksPassed == 0)           // a network that is restored from a checkpoint keeps the counters of its run
+    {
+        fSteadyCount = 0;
+        fPrevStatistics = getStatistics();
+    }
+
+    while(fStopReason == kRunning)
+    {
+        if(fTicksPassed >= fMaxTicks)
+        {
+            fStopReason = kMaxTicks;
+            break;
         }
-        if (!debug and window->getState() == Window::kPrint)
+        if(fMaxTime > 0)
         {
-            NetworkExporter::cgExport(this, fTicksPassed);
-            window->setCrState(Window::kPause);
+            const std::chrono::duration<double> kElapsed = std::chrono::steady_clock::now() - kStart;
+            if(kElapsed.count() >= fMaxTime)
+            {
+                fStopReason = kMaxTime;
+                break;
+            }
         }
+
+        if(observer != NULL and not observer->beforeTick(this)) continue;
+        if(update()) fStopReason = kEmpty;
+        else if(observer != NULL) observer->afterTick(this);
+
+        if(fStopReason == kRunning and checkSteadyState()) fStopReason = kSteadyState;
+        if(fStopReason == kRunning and fCheckpointInterval > 0 and fTicksPassed % fCheckpointInterval == 0) saveCheckpoint();
     }
 
     VehicleExporter::finish();
@@ -70,8 +244,57 @@ void Network::startSimulation(Window* window, const std::string& simpleOutput, c
     std::cout << "the simulation has ended after " << fTicksPassed << " ticks\n";
 }
 
+void Network::setCheckpoints(const uint32_t kInterval, const std::string& kPath)
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setCheckpoints");
+    REQUIRE(kInterval == 0 or !kPath.empty(), "Checkpoints need a path");
+    fCheckpointInterval = kInterval;
+    fCheckpointPath = kPath;
+}
+
+void Network::saveCheckpoint()
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling saveCheckpoint");
+
+    // the outputs are flushed first, a resumed run cuts them back to these sizes and continues them
+    fOutputSizes[0] = VehicleExporter::getSize();
+    const std::pair<uint64_t, uint64_t> kSizes = NetworkExporter::getSizes();
+    fOutputSizes[1] = kSizes.first;
+    fOutputSizes[2] = kSizes.second;
+
+    const std::string kTemporary = fCheckpointPath + ".tmp";
+    if(not SnapshotExporter::save(this, kTemporary) or std::rename(kTemporary.c_str(), fCheckpointPath.c_str()) != 0)
+    {
+        std::cerr << "Failed to write checkpoint " << fCheckpointPath << " after " << fTicksPassed << " ticks\n";
+    }
+}
+
+bool Network::checkSteadyState()
+{
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling checkSteadyState");
+    if(fSteadyTicks == 0) return false;
+
+    const std::pair<double, double> kStatistics = getStatistics();
+    const double kVelocityDiff = std::fabs(kStatistics.first  - fPrevStatistics.first ) / std::max(fPrevStatistics.first , 1e-9);
+    const double kFlowDiff     = std::fabs(kStatistics.second - fPrevStatistics.second) / std::max(fPrevStatistics.second, 1e-9);
+    fPrevStatistics = kStatistics;
+
+    if(kVelocityDiff <= fSteadyThreshold and kFlowDiff <= fSteadyThreshold) fSteadyCount++;
+    else fSteadyCount = 0;
+
+    return fSteadyCount >= fSteadyTicks;
+}
+
 bool Network::update()
 {
+    fEpoch++;                       // no vehicle has moved yet during this tick
+    if(fScheduler != NULL)
+    {
+        fTicksPassed++;
+        return fScheduler->update(fDoubleBuffered, fEpoch);
+    }
+    if(fDoubleBuffered) return updateBuffered();
+
     bool simulationDone = true;
 
     for(uint32_t i = 0; i < fRoads.size(); i++)
@@ -80,37 +303,47 @@ bool Network::update()
     }
     for(uint32_t i = 0; i < fRoads.size(); i++)
     {
-        fRoads[i]->updateVehicles();
+        fRoads[i]->updateVehicles(fEpoch);
     }
     for(uint32_t i = 0; i < fRoads.size(); i++)
     {
-        if(fRoads[i]->checkAndReset()) simulationDone = false;
+        if(!fRoads[i]->isEmpty()) simulationDone = false;
     }
+    for(uint32_t i = 0; i < fRetired.size(); i++) delete fRetired[i];
+    fRetired.clear();
 
     fTicksPassed++;
     return simulationDone;
 }
 
-bool Network::checkWindow(Window::EState state) const
+bool Network::updateBuffered()
 {
-    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling checkWindow");
-    switch(state)
+    REQUIRE(this->properlyInitialized(), "Network was not initialized when calling updateBuffered");
+
+    bool simulationDone = true;
+
+    for(uint32_t i = 0; i < fRoads.size(); i++)
     {
-        case Window::kPlay:
-            return true;
-        case Window::kNext:
-            return true;
-        case Window::kPause:
-            Window::delay(500);
-            return false;
-        case Window::kPrint:
-            return false;
-        case Window::kQuit:
-            exit(0);
-        default:
-            Window::delay(500);
-            return false;
+        fRoads[i]->updateTrafficSigns();
+    }
+    for(uint32_t i = 0; i < fRoads.size(); i++)
+    {
+        fRoads[i]->moveVehiclesBuffered(fEpoch);
+    }
+    for(uint32_t i = 0; i < fRoads.size(); i++)
+    {
+        fRoads[i]->finishVehiclesBuffered();
+    }
+    for(uint32_t i = 0; i < fRoads.size(); i++)                 // swap the buffers, the new state becomes the state the next tick reads
+    {
+        fRoads[i]->commitVehicles();
+        if(!fRoads[i]->isEmpty()) simulationDone = false;
     }
+    for(uint32_t i = 0; i < fRetired.size(); i++) delete fRetired[i];
+    fRetired.clear();
+
+    fTicksPassed++;
+    return simulationDone;
 }
 
 const std::vector<Road *> &Network::getRoads() const
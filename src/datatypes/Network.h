@@ -13,17 +13,25 @@
 #include <fstream>
 
 #include "Road.h"
-#include "../gui/gui.h"
+#include "RoadScheduler.h"
+#include "ISimulationObserver.h"
+class Arena;
 
 class Network {
 
 friend class NetworkExporter;
+friend class SnapshotExporter;
+friend class SnapshotParser;
 
 public:
+    enum EStopReason {kRunning, kEmpty, kMaxTicks, kMaxTime, kSteadyState};
+
     /**
+     * the network owns the roads and the arena the traffic signs of the roads were allocated from, NULL if they come
+     * from the heap. Both are deleted together with the network.
      * ENSURE(this->properlyInitialized(), "Network constructor must end in properlyInitialized state");
      */
-    Network(const std::vector<Road*>& roads);
+    Network(const std::vector<Road*>& roads, Arena* signArena = NULL);
     ~Network();
 
     bool properlyInitialized() const;
@@ -34,20 +42,132 @@ public:
     int getTicksPassed() const;
 
     /**
-     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling startSimulation");
-     * REQUIRE(amountOfTicks >= 0, "Amount of ticks must be a positive integer");
+     * the epoch of the last tick, the vehicles that have moved during it have moved in this epoch
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getEpoch");
      */
-    void startSimulation(Window* window, const std::string& simpleOutput, const std::string& impressionOutput, bool debug);
+    uint32_t getEpoch() const;
 
     /**
-     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling update");
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getMaxTicks");
      */
-    bool update();
+    int getMaxTicks() const;
 
     /**
-     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling checkWindow");
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setMaxTicks");
+     * REQUIRE(kMaxTicks >= 0, "Amount of ticks must be a positive integer");
+     * ENSURE(getMaxTicks() == kMaxTicks, "new max ticks not set when calling setMaxTicks");
      */
-    bool checkWindow(Window::EState state) const;
+    void setMaxTicks(int kMaxTicks);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getMaxTime");
+     */
+    double getMaxTime() const;
+
+    /**
+     * sets the wall clock budget of the simulation in seconds, 0 means there is no budget
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setMaxTime");
+     * REQUIRE(kSeconds >= 0, "Amount of seconds must be positive");
+     * ENSURE(getMaxTime() == kSeconds, "new max time not set when calling setMaxTime");
+     */
+    void setMaxTime(double kSeconds);
+
+    /**
+     * stops the simulation once the mean velocity and the flow change less than kThreshold (relative)
+     * for kTicks ticks in a row, 0 ticks disables this check
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setSteadyState");
+     * REQUIRE(kThreshold >= 0, "Threshold must be positive");
+     */
+    void setSteadyState(uint32_t kTicks, double kThreshold);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getStopReason");
+     */
+    EStopReason getStopReason() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getThreads");
+     */
+    uint32_t getThreads() const;
+
+    /**
+     * updates the independent parts of the network on kThreads threads, the result does not depend on kThreads
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setThreads");
+     * REQUIRE(kThreads > 0, "Amount of threads must be greater than 0");
+     * ENSURE(getThreads() == kThreads, "new amount of threads not set when calling setThreads");
+     */
+    void setThreads(uint32_t kThreads);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling isDoubleBuffered");
+     */
+    bool isDoubleBuffered() const;
+
+    /**
+     * in double-buffered mode every vehicle moves using the state of the previous tick of the other vehicles,
+     * so the order in which the roads and vehicles are updated does not matter. The default mode updates the
+     * vehicles from front to back, every vehicle sees the new state of the vehicle in front of it.
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setDoubleBuffered");
+     * ENSURE(isDoubleBuffered() == kDoubleBuffered, "new mode not set when calling setDoubleBuffered");
+     */
+    void setDoubleBuffered(bool kDoubleBuffered);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getKernelMode");
+     */
+    EKernelMode getKernelMode() const;
+
+    /**
+     * in double-buffered mode the vehicles that only follow their leader can be computed a whole lane at once,
+     * see Road::setKernelMode. The kernel is not used in the default mode, where every vehicle needs the new state
+     * of the vehicle in front of it.
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setKernelMode");
+     * ENSURE(getKernelMode() == kMode, "new mode not set when calling setKernelMode");
+     */
+    void setKernelMode(EKernelMode kMode);
+
+    /**
+     * the number of vehicles for which the lane kernel gave a different result in validate mode
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getKernelMismatches");
+     */
+    uint64_t getKernelMismatches() const;
+
+    /**
+     * returns the mean velocity of all vehicles and the flow (vehicles per second) of the network
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getStatistics");
+     */
+    std::pair<double, double> getStatistics() const;
+
+    /**
+     * saves a snapshot of the network to kPath every kInterval ticks while the simulation runs, 0 disables it.
+     * The snapshot is written next to kPath first and then renamed, so kPath always holds a complete checkpoint.
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling setCheckpoints");
+     * REQUIRE(kInterval == 0 or !kPath.empty(), "Checkpoints need a path");
+     */
+    void setCheckpoints(uint32_t kInterval, const std::string& kPath);
+
+    /**
+     * runs the simulation until the network is empty, the tick or time budget is spent or the network is steady,
+     * without an observer the ticks are simulated back to back. A network that was restored from a checkpoint
+     * continues the run: the steady state counters are kept and the outputs are continued from the checkpoint.
+     *
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling startSimulation");
+     */
+    void startSimulation(ISimulationObserver* observer, const std::string& simpleOutput, const std::string& impressionOutput);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling update");
+     */
+    bool update();
 
     /**
      * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling getRoads");
@@ -55,9 +175,45 @@ public:
     const std::vector<Road*>& getRoads() const;
 
 private:
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling checkSteadyState");
+     */
+    bool checkSteadyState();
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling saveCheckpoint");
+     */
+    void saveCheckpoint();
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Network was not initialized when calling updateBuffered");
+     */
+    bool updateBuffered();
+
     int fTicksPassed; // amount of ticks passed
+    uint32_t fEpoch;  // a vehicle has moved during this tick if it has moved in this epoch
+    int fMaxTicks;    // amount of ticks after which the simulation is stopped
+    double fMaxTime;  // amount of seconds after which the simulation is stopped
+
+    uint32_t fSteadyTicks;      // amount of steady ticks in a row after which the simulation is stopped
+    uint32_t fSteadyCount;      // amount of steady ticks in a row so far
+    double fSteadyThreshold;    // maximal relative change of a steady tick
+    std::pair<double, double> fPrevStatistics;
+
+    EStopReason fStopReason;
 
     std::vector<Road*> fRoads;
+    Arena* fSignArena;                  // memory of the traffic signs of the roads, NULL if they come from the heap
+
+    uint32_t fThreads;                  // amount of threads used to update the roads
+    RoadScheduler* fScheduler;          // only used when there is more than one thread
+    bool fDoubleBuffered;               // vehicles only read the state of the previous tick
+    EKernelMode fKernelMode;            // how the roads compute the vehicles that follow their leader
+    std::vector<IVehicle*> fRetired;    // vehicles that left the network this tick, they are deleted at the end of the tick
+
+    uint32_t fCheckpointInterval;       // amount of ticks between two checkpoints, 0 is no checkpoints
+    std::string fCheckpointPath;
+    uint64_t fOutputSizes[3];           // sizes of the statistics, simple and impression output at the last checkpoint
 
     static const int fgkMaxTicks;
 
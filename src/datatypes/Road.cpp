@@ -9,10 +9,25 @@
 #include <stdint.h>
 #include <algorithm>
 #include <iostream>
+#include <cstring>
 #include "Road.h"
 #include "../DesignByContract.h"
 #include "util.h"
 
+const uint32_t Road::fgkMergeTicks = 5;
+
+namespace
+{
+    // one batch per thread that is reused by every lane, so it stays in the cache
+    struct LaneScratch
+    {
+        LaneBatch fBatch;
+        std::vector<uint32_t> fIndices;     // the index in the lane of every vehicle in the batch
+        std::vector<double> fLimits;        // the speed limit of every vehicle in the lane, from the speed profile
+    };
+    thread_local LaneScratch scratch;
+}
+
 Road::Road(const std::string& kName, Road* const kNext, const double kLength, const uint32_t kLanes, const std::vector<const Zone*>& kZones, const std::vector<const BusStop*>& kBusStops, const std::vector<const TrafficLight*>& kTrafficLights)
 {
     REQUIRE(kLength > 0    , "Failed to construct road: length must be greater than 0"   );
@@ -23,18 +38,29 @@ Road::Road(const std::string& kName, Road* const kNext, const double kLength, co
 
     fName = kName;
     fNextRoad = kNext;
+    if(kNext != NULL) kNext->fPreviousRoads.push_back(this);
 
     fRoadLength = kLength;
     fLanes.resize(kLanes);
+    fNumVehicles = 0;
 
     fBusStops = kBusStops;
     fZones = kZones;
     fTrafficLights = kTrafficLights;
+    fSignVersion = 0;
 
-    fMergingVehicles = {};
+    fMergeWheel.resize(fgkMergeTicks + 1);
+    fMergeTick = 0;
+    fRetired = NULL;
+    fKernelMode = kKernelOff;
+    fKernelMismatches = 0;
+    fUpdating = false;
 
     _initCheck = this;
 
+    fProfileVersion = Zone::getVersion() - 1;
+    updateSpeedProfile();
+
     ENSURE(this->properlyInitialized(), "Road constructor must end in properlyInitialized state");
 }
 
@@ -42,7 +68,10 @@ Road::~Road()
 {
     for(uint32_t i = 0; i < fLanes.size(); i++)
     {
-        for(Iter iter = fLanes[i].begin(); iter < fLanes[i].end(); ++iter) delete *iter;
+        for(uint32_t j = 0; j < fLanes[i].size(); j++)
+        {
+            if(not (fLanes[i].getFlags(j) & Lane::kGhost)) delete fLanes[i][j];  // merging vehicles are deleted from their new lane
+        }
     }
 }
 
@@ -58,42 +87,170 @@ void Road::updateTrafficSigns()
     for(uint32_t i = 0; i < fBusStops     .size(); i++) fBusStops     [i]->update();
 }
 
-void Road::updateVehicles()
+void Road::updateVehicles(const uint32_t kEpoch)
 {
     REQUIRE(this->properlyInitialized(), "Road was not initialized when calling updateVehicles");
 
+    fUpdating = true;
     for(uint32_t i = 0; i < fLanes.size(); i++)
     {
         for(uint32_t j = 0; j < fLanes[i].size(); j++)
         {
-            fLanes[i][j]->move(i,j, this);
+            fLanes[i][j]->move(i,j, this, kEpoch);
+            fLanes[i].store(j);                                             // keep the lane arrays up to date for the vehicles behind
         }
     }
 
-    for(uint32_t i = 0; i < fMergingVehicles.size();)
+    updateMergingVehicles();
+    dequeueFinishedVehicles();
+    fUpdating = false;
+}
+
+void Road::moveVehiclesBuffered(const uint32_t kEpoch)
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling moveVehiclesBuffered");
+
+    for(uint32_t i = 0; i < fLanes.size(); i++)
     {
-        uint32_t& timer = std::get<0>(fMergingVehicles[i]);
-        if(++timer > 5)
+        if(fKernelMode != kKernelOff)
+        {
+            moveLaneBuffered(i, kEpoch);
+            continue;
+        }
+        for(uint32_t j = 0; j < fLanes[i].size(); j++)
         {
-            const uint32_t kLane = std::get<1>(fMergingVehicles[i]);
-            Iter iter = std::find(begin(fLanes[kLane]), end(fLanes[kLane]), std::get<2>(fMergingVehicles[i]));
-            (*iter)->setMerging(false);
-            fLanes[kLane].erase(iter);
-            fMergingVehicles.erase(fMergingVehicles.begin() + i);
+            if(fLanes[i].getFlags(j) & Lane::kGhost) continue;              // merging vehicles are moved from their new lane
+            fLanes[i][j]->moveBuffered(i, j, this, kEpoch);
         }
-        else i++;
     }
+}
 
-    dequeueFinishedVehicles();
+void Road::moveLaneBuffered(const uint32_t kLane, const uint32_t kEpoch)
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling moveLaneBuffered");
+    REQUIRE(laneExists(kLane), "Cannot move a non-existant lane");
+
+    const Lane& kState = fLanes[kLane];
+    LaneBatch& batch = scratch.fBatch;
+    std::vector<uint32_t>& indices = scratch.fIndices;
+    std::vector<double>& limits = scratch.fLimits;
+    batch.clear();
+    indices.clear();
+    getSpeedLimits(kLane, limits);
+
+    // the vehicles that slow down for a traffic sign are moved one by one, the others are gathered in the batch
+    for(uint32_t j = 0; j < kState.size(); j++)
+    {
+        if(kState.getFlags(j) & Lane::kGhost) continue;
+        IVehicle* vehicle = kState[j];
+
+        if(not vehicle->beginMoveBuffered(kLane, j, this, kEpoch)) continue;
+        if(vehicle->isSlowingDown())
+        {
+            vehicle->followBuffered(kLane, j, this, limits[j]);
+            continue;
+        }
+
+        const std::pair<const Lane*, double> kNextLane = (j == 0) ? getNextLane(kLane) : std::pair<const Lane*, double>(&kState, 0);
+        const VehicleConstants& kConstants = vehicle->getConstants();
+        if(kNextLane.first != NULL)
+        {
+            const uint32_t kLeader = (j == 0) ? kNextLane.first->size() - 1 : j - 1;
+            const double kLeaderPosition = kNextLane.first->getPosition(kLeader) + kNextLane.second;
+            batch.push(vehicle->getPosition(), vehicle->getVelocity(), kLeaderPosition, kNextLane.first->getVelocity(kLeader),
+                        kNextLane.first->getConstants(kLeader).fLength, limits[j], kConstants.fMinSpeed, kConstants.fMaxSpeed, kConstants.fMinAcceleration, kConstants.fMaxAcceleration,
+                        vehicle->getSafeAcceleration(true, kLeaderPosition, kLane, this));
+        }
+        else
+        {
+            batch.push(vehicle->getPosition(), vehicle->getVelocity(), 0, 0, 0, limits[j], kConstants.fMinSpeed, kConstants.fMaxSpeed, kConstants.fMinAcceleration, kConstants.fMaxAcceleration,
+                        vehicle->getSafeAcceleration(false, 0, kLane, this));
+        }
+        indices.push_back(j);
+    }
+
+    followLeaders(batch, getInstructionSet());
+
+    for(uint32_t k = 0; k < batch.size(); k++)
+    {
+        const uint32_t j = indices[k];
+        IVehicle* vehicle = kState[j];
+        if(fKernelMode == kKernelValidate)
+        {
+            vehicle->followBuffered(kLane, j, this, limits[j]);
+            const double kScalar[3] = {vehicle->getAcceleration(), vehicle->getVelocity(), vehicle->getPosition()};
+            const double kKernel[3] = {batch.fAccelerations[k], batch.fVelocities[k], batch.fPositions[k]};
+            if(std::memcmp(kScalar, kKernel, sizeof(kScalar)) != 0) fKernelMismatches++;     // the bits must be exactly the same
+        }
+        else vehicle->finishMoveBuffered(batch.fAccelerations[k], batch.fVelocities[k], batch.fPositions[k], kLane, this, limits[j]);
+    }
 }
 
-bool Road::checkAndReset()
+void Road::finishVehiclesBuffered()
 {
-    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling checkAndReset");
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling finishVehiclesBuffered");
+
     for(uint32_t i = 0; i < fLanes.size(); i++)
     {
-        for(Iter iter = fLanes[i].begin(); iter < fLanes[i].end(); ++iter) (*iter)->setMoved(false);
+        for(uint32_t j = 0; j < fLanes[i].size(); j++)
+        {
+            if(fLanes[i].getFlags(j) & Lane::kGhost) continue;
+            fLanes[i][j]->changeLane(i, j, this);
+        }
+    }
+
+    updateMergingVehicles();
+    dequeueFinishedVehicles();
+}
+
+void Road::commitVehicles()
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling commitVehicles");
+    for(uint32_t i = 0; i < fLanes.size(); i++) fLanes[i].storeAll();
+}
+
+void Road::updateSpeedProfile() const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling updateSpeedProfile");
+    if(fProfileVersion == Zone::getVersion()) return;
+
+    fProfilePositions.clear();
+    fProfileLimits.clear();
+    for(uint32_t i = 0; i < fZones.size(); i++)
+    {
+        const double kPosition = fZones[i]->getPosition();
+        const double kLimit = fZones[i]->getSpeedlimit();
+
+        if(!fProfilePositions.empty() and fProfilePositions.back() == kPosition) fProfileLimits.back() = kLimit;   // the last zone at a position wins
+        else if(fProfileLimits.empty() or fProfileLimits.back() != kLimit)
+        {
+            fProfilePositions.push_back(kPosition);
+            fProfileLimits.push_back(kLimit);
+        }
     }
+    fProfileVersion = Zone::getVersion();
+}
+
+void Road::updateMergingVehicles()
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling updateMergingVehicles");
+
+    // the vehicles in this bucket started merging fgkMergeTicks + 1 updates ago, they leave their old lane now
+    fMergeTick = (fMergeTick + 1) % fMergeWheel.size();
+    std::vector<std::pair<uint32_t, const IVehicle*> >& bucket = fMergeWheel[fMergeTick];
+    for(uint32_t i = 0; i < bucket.size(); i++)
+    {
+        Lane& lane = fLanes[bucket[i].first];
+        const uint32_t kIndex = lane.find(bucket[i].second, lane.findBehind(bucket[i].second->getPosition()));
+        lane[kIndex]->setMerging(false);
+        lane.erase(kIndex);
+    }
+    bucket.clear();
+}
+
+bool Road::checkAndReset()
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling checkAndReset");
     return !isEmpty();
 }
 
@@ -103,62 +260,74 @@ void Road::enqueue(IVehicle* const kVehicle)
     enqueue(kVehicle, 0);
 }
 
-bool Road::changeLaneIfPossible(IVehicle* vehicle, const uint32_t kLane, const bool kLeft)
+bool Road::changeLaneIfPossible(IVehicle* vehicle, const uint32_t kLane, const uint32_t kIndex, const bool kLeft)
 {
     REQUIRE(this->properlyInitialized(), "Road was not initialized when calling changeLaneIfPossible");
     REQUIRE(laneExists(kLane + (kLeft ? 1 : -1)), "Cannot go to non-existing lane");
+    REQUIRE(kIndex < fLanes[kLane].size() and fLanes[kLane][kIndex] == vehicle, "vehicle is not at kIndex on kLane");
 
-    std::vector<IVehicle*>& newLane = fLanes[kLane + (kLeft ? 1 : -1)];
+    Lane& newLane = fLanes[kLane + (kLeft ? 1 : -1)];
     const double ideal = 1.5 * vehicle->getVelocity();
 
     // this isn't specified but vehicles are not allowed to switch lanes when entering or leaving a road.
     if(vehicle->getPosition() < ideal or vehicle->getPosition() > fRoadLength - ideal) return false;
 
-    if(!newLane.empty())
-    {
-        uint32_t infront = -1;
-        uint32_t behind = -1;
-        for(uint32_t i = 0; i < newLane.size(); i++)
-        {
-            if(comparePositionGT<IVehicle>(vehicle->getPosition(), newLane[i]))
-            {
-                behind = i;
-                if(i != 0) infront = i-1;
-                break;
-            }
-        }
-        if(behind == uint32_t(-1)) infront = newLane.size() - 1;
-
-        if(behind  != uint32_t(-1) and newLane[behind ]->getPosition() + ideal > vehicle->getPosition()) return false;
-        if(infront != uint32_t(-1) and newLane[infront]->getPosition() - ideal < vehicle->getPosition()) return false;
+    // the vehicles directly behind and in front of the vehicle on the new lane, if there are any
+    const uint32_t kBehind = newLane.findBehind(vehicle->getPosition());
+    if(kBehind != newLane.size() and newLane[kBehind    ]->getPosition() + ideal > vehicle->getPosition()) return false;
+    if(kBehind != 0              and newLane[kBehind - 1]->getPosition() - ideal < vehicle->getPosition()) return false;
 
-        if(behind == uint32_t(-1)) newLane.push_back(vehicle);
-        else newLane.insert(begin(newLane)+behind, vehicle);
-
-        fMergingVehicles.push_back(std::tuple<uint32_t, uint32_t, const IVehicle*>(0, kLane, vehicle));
-    }
-    else
+    // both must still be able to brake in time, the one behind for the vehicle and the vehicle for the one in front
+    if(kBehind != newLane.size() and not newLane[kBehind]->canStopBehind(vehicle->getPosition())) return false;
+    if(kBehind != 0              and not vehicle->canStopBehind(newLane[kBehind - 1]->getPosition())) return false;
+    if(kBehind == newLane.size() and not canStopBeforeRoad(kLane + (kLeft ? 1 : -1), vehicle->getPosition(), this)) return false;
+    if(kBehind == 0)
     {
-        // if the lane is empty we can easily push it back
-        newLane.insert(newLane.begin(), vehicle);
-        fMergingVehicles.push_back(std::tuple<uint32_t, uint32_t, const IVehicle*>(0, kLane, vehicle));
+        const std::pair<const Lane*, double> kNextLane = getNextLane(kLane + (kLeft ? 1 : -1));
+        if(kNextLane.first != NULL and not vehicle->canStopBehind(kNextLane.first->getPosition(kNextLane.first->size() - 1) + kNextLane.second)) return false;
     }
+    if(not canJoinJunction(kLane + (kLeft ? 1 : -1), vehicle)) return false;
+
+    newLane.insert(kBehind, vehicle);
+    fMergeWheel[(fMergeTick + fgkMergeTicks + 1) % fMergeWheel.size()].push_back(std::pair<uint32_t, const IVehicle*>(kLane, vehicle));
+    fLanes[kLane].setGhost(kIndex);                         // the vehicle stays behind on its old lane until it has merged
     return true;
 }
 
-void Road::updateNextVehicles()
+void Road::setRetired(std::vector<IVehicle*>* const kRetired)
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling setRetired");
+    fRetired = kRetired;
+}
+
+void Road::setKernelMode(const EKernelMode kMode)
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling setKernelMode");
+    fKernelMode = kMode;
+}
+
+uint64_t Road::getKernelMismatches() const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getKernelMismatches");
+    return fKernelMismatches;
+}
+
+void Road::updateNextVehicles(const uint32_t kEpoch)
 {
-    if(fNextRoad != NULL) fNextRoad->updateVehicles();
+    // on a ring the update comes back to a road that is still being updated, its vehicles keep their old state
+    if(fNextRoad != NULL and not fNextRoad->fUpdating) fNextRoad->updateVehicles(kEpoch);
 }
 
 bool Road::isEmpty() const
 {
     REQUIRE(this->properlyInitialized(), "Road was not initialized when calling isEmpty");
-    for(uint32_t i = 0; i < fLanes.size(); i++)
-    {
-        if(!fLanes[i].empty()) return false;
-    }
-    return true;
+    return fNumVehicles == 0;
+}
+
+uint32_t Road::getNumVehicles() const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getNumVehicles");
+    return fNumVehicles;
 }
 
 const Road* Road::getNextRoad() const
@@ -177,6 +346,8 @@ void Road::setNextRoad(Road* const kNextRoad)
 {
     REQUIRE(this->properlyInitialized()     , "Road was not initialized when calling setNextRoad");
     REQUIRE(kNextRoad == NULL or kNextRoad->properlyInitialized(), "kNextRoad was not initialized when calling setNextRoad");
+    if(fNextRoad != NULL) fNextRoad->fPreviousRoads.erase(std::find(fNextRoad->fPreviousRoads.begin(), fNextRoad->fPreviousRoads.end(), this));
+    if(kNextRoad != NULL) kNextRoad->fPreviousRoads.push_back(this);
     Road::fNextRoad = kNextRoad;
     ENSURE(getNextRoad() == kNextRoad, "new next road not set when calling setNextRoad");
 }
@@ -205,13 +376,20 @@ bool Road::laneExists(uint32_t kLane) const
     return kLane < getNumLanes();
 }
 
-const std::vector<IVehicle*>& Road::operator[](const uint32_t kIndex) const
+const Lane& Road::operator[](const uint32_t kIndex) const
 {
     REQUIRE(this->properlyInitialized(), "Road was not initialized when calling operator[]");
     REQUIRE(laneExists(kIndex), "lane does not exist");
     return fLanes[kIndex];
 }
 
+const Lane& Road::getLane(const uint32_t kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getLane");
+    REQUIRE(laneExists(kIndex), "lane does not exist");
+    return fLanes[kIndex];
+}
+
 //--------------------------------------------------------------------------------------------------//
 //              al de onderstaande functies zijn voor verkeerstekens methodes                       //
 //--------------------------------------------------------------------------------------------------//
@@ -222,6 +400,8 @@ void Road::addZone(const Zone* kZone)
     REQUIRE(kZone->properlyInitialized(), "Zone was not properly initialized");
 
     insert_sorted<Zone>(fZones, kZone);
+    fProfileVersion = Zone::getVersion() - 1;
+    updateSpeedProfile();
 }
 
 void Road::addBusStop(const BusStop* kBusStop)
@@ -230,6 +410,7 @@ void Road::addBusStop(const BusStop* kBusStop)
     REQUIRE(kBusStop->properlyInitialized(), "BusStop was not properly initialized");
 
     insert_sorted<BusStop>(fBusStops, kBusStop);
+    fSignVersion++;
 }
 
 void Road::addTrafficLight(const TrafficLight* kTrafficLight)
@@ -238,6 +419,7 @@ void Road::addTrafficLight(const TrafficLight* kTrafficLight)
     REQUIRE(kTrafficLight->properlyInitialized(), "TrafficLight was not properly initialized");
 
     insert_sorted<TrafficLight>(fTrafficLights, kTrafficLight);
+    fSignVersion++;
 }
 
 std::vector<const Zone*> Road::getZones() const
@@ -259,14 +441,48 @@ std::vector<const TrafficLight*> Road::getTrafficLights() const
 }
 
 //--------------------------------------------------------------------------------------------------//
-//      al de onderstaande functies leiden tot een oneindige loop als banen een cirkel vormen       //
+//    al de onderstaande functies volgen de volgende banen en stoppen als die een cirkel vormen     //
 //--------------------------------------------------------------------------------------------------//
 
 double Road::getSpeedLimit(const double kPosition) const
 {
     REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getSpeedLimit");
     REQUIRE(kPosition >= 0 and kPosition < getRoadLength(), "position not valid");
-    return (*--std::upper_bound(fZones.begin(), fZones.end(), kPosition, comparePosition<Zone>))->getSpeedlimit();
+    updateSpeedProfile();
+    return fProfileLimits[std::upper_bound(fProfilePositions.begin(), fProfilePositions.end(), kPosition) - fProfilePositions.begin() - 1];
+}
+
+double Road::getSpeedLimit(const double kPosition, uint32_t& kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getSpeedLimit");
+    REQUIRE(kPosition >= 0 and kPosition < getRoadLength(), "position not valid");
+
+    updateSpeedProfile();
+    if(kIndex >= fProfilePositions.size()) kIndex = fProfilePositions.size() - 1;
+    while(kIndex + 1 < fProfilePositions.size() and fProfilePositions[kIndex + 1] <= kPosition) kIndex++;
+    while(kIndex > 0 and fProfilePositions[kIndex] > kPosition) kIndex--;
+    return fProfileLimits[kIndex];
+}
+
+void Road::getSpeedLimits(const uint32_t kLane, std::vector<double>& kLimits) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getSpeedLimits");
+    REQUIRE(laneExists(kLane), "lane does not exist");
+
+    updateSpeedProfile();
+    const Lane& kVehicles = fLanes[kLane];
+    kLimits.resize(kVehicles.size());
+
+    // the vehicles are sorted from front to back, so the profile is walked backwards once
+    uint32_t index = fProfilePositions.size() - 1;
+    for(uint32_t i = 0; i < kVehicles.size(); i++)
+    {
+        while(index > 0 and fProfilePositions[index] > kVehicles.getPosition(i)) index--;
+        while(index + 1 < fProfilePositions.size() and fProfilePositions[index + 1] <= kVehicles.getPosition(i)) index++;
+        kLimits[i] = fProfileLimits[index];
+    }
+
+    ENSURE(kLimits.size() == getLane(kLane).size(), "there must be a speed limit for every vehicle");
 }
 
 std::pair<const BusStop*, double> Road::getBusStop(const double kPosition) const
@@ -285,6 +501,7 @@ std::pair<const BusStop*, double> Road::getBusStop(const double kPosition) const
             if(fNextRoad == NULL) break;
             offset += current->fRoadLength;
             current = current->fNextRoad;
+            if(current == this) break;                                      // the roads form a ring
         }
         else return std::pair<const BusStop*, double>(*kIter, offset);
     }
@@ -307,12 +524,33 @@ std::pair<const TrafficLight*, double> Road::getTrafficLight(const double kPosit
             if(fNextRoad == NULL) break;
             offset += current->fRoadLength;
             current = current->fNextRoad;
+            if(current == this) break;                                      // the roads form a ring
         }
         else return std::pair<const TrafficLight*, double>(*kIter, offset);
     }
     return std::pair<const TrafficLight*, double>(NULL, 0);
 }
 
+std::pair<const BusStop*, double> Road::getBusStop(const double kPosition, uint32_t& kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getBusStop");
+    REQUIRE(kPosition >= 0 and kPosition < getRoadLength(), "position not valid");
+    return std::pair<const BusStop*, double>(upper_bound_from<BusStop>(fBusStops, kPosition, kIndex), 0);
+}
+
+std::pair<const TrafficLight*, double> Road::getTrafficLight(const double kPosition, uint32_t& kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getTrafficLight");
+    REQUIRE(kPosition >= 0 and kPosition < getRoadLength(), "position not valid");
+    return std::pair<const TrafficLight*, double>(upper_bound_from<TrafficLight>(fTrafficLights, kPosition, kIndex), 0);
+}
+
+uint32_t Road::getSignVersion() const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getSignVersion");
+    return fSignVersion;
+}
+
 std::pair<const IVehicle*, double> Road::getNextVehicle(const uint32_t kLane, const uint32_t kIndex) const
 {
     REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getTrafficLight");
@@ -323,7 +561,7 @@ std::pair<const IVehicle*, double> Road::getNextVehicle(const uint32_t kLane, co
     {
         const Road* iter = fNextRoad;
         double offset = fRoadLength;
-        while(iter != NULL)
+        while(iter != NULL and iter != this)                                // stop when the roads form a ring
         {
             if(iter->getNumLanes() <= kLane) break;
             else if(iter->fLanes[kLane].empty())
@@ -338,6 +576,49 @@ std::pair<const IVehicle*, double> Road::getNextVehicle(const uint32_t kLane, co
     else return std::pair<const IVehicle*, double>(fLanes[kLane][kIndex-1], 0);
 }
 
+std::pair<bool, double> Road::getLeaderPosition(const uint32_t kLane, const uint32_t kIndex) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getLeaderPosition");
+    REQUIRE(laneExists(kLane), "Cannot get vehicles on an non-existant lane");
+    REQUIRE(kIndex < fLanes[kLane].size(), "Index is out of range");
+
+    if(kIndex != 0) return std::pair<bool, double>(true, fLanes[kLane].getPosition(kIndex - 1));
+    const std::pair<const Lane*, double> kNextLane = getNextLane(kLane);
+    if(kNextLane.first == NULL) return std::pair<bool, double>(false, 0);
+    return std::pair<bool, double>(true, kNextLane.first->getPosition(kNextLane.first->size() - 1) + kNextLane.second);
+}
+
+std::pair<bool, double> Road::getMergeLeaderPosition(const uint32_t kLane, const IVehicle* const kVehicle) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getMergeLeaderPosition");
+    REQUIRE(laneExists(kLane), "Cannot get vehicles on an non-existant lane");
+
+    uint32_t index = 0;
+    const uint32_t kOther = findMergeLane(kLane, kVehicle, index);
+    if(kOther == getNumLanes()) return std::pair<bool, double>(false, 0);
+    return getLeaderPosition(kOther, index);
+}
+
+std::pair<const Lane*, double> Road::getNextLane(const uint32_t kLane) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getNextLane");
+    REQUIRE(laneExists(kLane), "Cannot get vehicles on an non-existant kLane");
+
+    const Road* iter = fNextRoad;
+    double offset = fRoadLength;
+    while(iter != NULL and iter != this)                                    // stop when the roads form a ring
+    {
+        if(iter->getNumLanes() <= kLane) break;
+        else if(iter->fLanes[kLane].empty())
+        {
+            offset += iter->fRoadLength;
+            iter = iter->fNextRoad;
+        }
+        else return std::pair<const Lane*, double>(&iter->fLanes[kLane], offset);
+    }
+    return std::pair<const Lane*, double>(NULL, 0);
+}
+
 //--------------------------------------------------------------------------------------------------//
 
 void Road::dequeueFinishedVehicles()
@@ -363,7 +644,8 @@ void Road::enqueue(IVehicle* const kVehicle, const uint32_t kLane)
     REQUIRE(kVehicle->properlyInitialized(), "Vehicle was not initialized when calling enqueue");
     REQUIRE(kLane < this->getNumLanes(), "Cannot enqueue on an non-existant lane");
 
-    fLanes[kLane].push_back(kVehicle);                        // we can add the new kVehicle
+    fLanes[kLane].pushBack(kVehicle);                         // we can add the new kVehicle
+    fNumVehicles++;
     if(kVehicle->getPosition() > fRoadLength) dequeue(kLane); // immediately remove it when it has already traversed the whole road in one tick
 }
 
@@ -373,24 +655,159 @@ void Road::dequeue(const uint32_t kLane)
     REQUIRE(!isEmpty(), "Road cannot be empty when calling dequeue");
     REQUIRE(laneExists(kLane), "Cannot dequeue vehicle from an non-existant lane");
 
+    if(fLanes[kLane].front()->getMerging()) finishMerging(fLanes[kLane].front(), kLane);     // the vehicle must only leave the road once
+
     if(fNextRoad == NULL)
     {
-        delete fLanes[kLane].front();                                                      // free memory if they leave the simulation
+        retire(fLanes[kLane].front());                                                      // free memory if they leave the simulation
     }
     else if(fNextRoad->getNumLanes() <= kLane)
     {
         std::cerr << "Next road did not have enough lanes, removing this vehicle from the simulation.\n";
-        delete fLanes[kLane].front();
+        retire(fLanes[kLane].front());
     }
     else
     {
         fLanes[kLane].front()->setPosition(fLanes[kLane].front()->getPosition() - fRoadLength); // current position minus roadlength
         fNextRoad->enqueue(fLanes[kLane].front(), kLane);                                       // enqueue in next road if there is one
     }
-    fLanes[kLane].erase(fLanes[kLane].begin());                                                 // remove from the queue
+    fLanes[kLane].erase(0);                                                                     // remove from the queue
+    fNumVehicles--;
 }
 
+void Road::finishMerging(const IVehicle* const kVehicle, const uint32_t kLane)
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling finishMerging");
+    REQUIRE(laneExists(kLane), "Cannot finish merging on an non-existant lane");
 
+    for(uint32_t i = 0; i < fLanes.size(); i++)
+    {
+        if(i == kLane) continue;
+        const uint32_t kIndex = fLanes[i].find(kVehicle, fLanes[i].findBehind(kVehicle->getPosition()));
+        if(kIndex != fLanes[i].size()) fLanes[i].erase(kIndex);
+    }
+    for(uint32_t i = 0; i < fMergeWheel.size(); i++)
+    {
+        std::vector<std::pair<uint32_t, const IVehicle*> >& bucket = fMergeWheel[i];
+        for(uint32_t j = 0; j < bucket.size(); j++)
+        {
+            if(bucket[j].second != kVehicle) continue;
+            bucket.erase(bucket.begin() + j);
+            kVehicle->setMerging(false);
+            return;
+        }
+    }
+    kVehicle->setMerging(false);
+}
+
+std::pair<bool, double> Road::getJunctionLeaderPosition(const uint32_t kLane, const IVehicle* const kVehicle) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getJunctionLeaderPosition");
+    REQUIRE(laneExists(kLane), "Cannot get vehicles on an non-existant lane");
+
+    if(fNextRoad == NULL or fNextRoad->fPreviousRoads.size() < 2) return std::pair<bool, double>(false, 0);    // no other road joins
+
+    // a merging vehicle can join the next road on both of its lanes
+    uint32_t lanes[2] = {kLane, getNumLanes()};
+    uint32_t index = 0;
+    if(kVehicle->getMerging()) lanes[1] = findMergeLane(kLane, kVehicle, index);
+
+    const double kDistance = fRoadLength - kVehicle->getPosition();
+    bool found = false;
+    double nearest = 0;
+    for(uint32_t l = 0; l < 2; l++)
+    {
+        if(lanes[l] == getNumLanes() or not fNextRoad->laneExists(lanes[l])) continue;
+        for(uint32_t i = 0; i < fNextRoad->fPreviousRoads.size(); i++)
+        {
+            const Road* const kOther = fNextRoad->fPreviousRoads[i];
+            if(kOther == this or not kOther->laneExists(lanes[l])) continue;
+
+            // the last vehicle on the other lane that joins before this one
+            const uint32_t kBehind = kOther->findBehindJunction(lanes[l], kDistance, kOther->fName < fName);
+            if(kBehind == 0) continue;
+            const double kOtherDistance = kOther->fRoadLength - kOther->fLanes[lanes[l]].getPosition(kBehind - 1);
+            if(not found or kOtherDistance > nearest)
+            {
+                found = true;
+                nearest = kOtherDistance;
+            }
+        }
+    }
+    return std::pair<bool, double>(found, fRoadLength - nearest);
+}
+
+uint32_t Road::findBehindJunction(const uint32_t kLane, const double kDistance, const bool kTieInFront) const
+{
+    // the vehicles join in the order of their distance to the junction, a tie goes to the road whose name comes first
+    const Lane& kCurrent = fLanes[kLane];
+    uint32_t low = 0;
+    uint32_t high = kCurrent.size();
+    while(low < high)
+    {
+        const uint32_t kMiddle = low + (high - low) / 2;
+        const double kOther = fRoadLength - kCurrent.getPosition(kMiddle);
+        if(kOther < kDistance or (kTieInFront and kOther == kDistance)) low = kMiddle + 1;
+        else high = kMiddle;
+    }
+    return low;
+}
 
+bool Road::canJoinJunction(const uint32_t kLane, const IVehicle* const kVehicle) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling canJoinJunction");
+
+    if(fNextRoad == NULL or not fNextRoad->laneExists(kLane)) return true;
+
+    const double kDistance = fRoadLength - kVehicle->getPosition();
+    for(uint32_t i = 0; i < fNextRoad->fPreviousRoads.size(); i++)
+    {
+        const Road* const kOther = fNextRoad->fPreviousRoads[i];
+        if(kOther == this or not kOther->laneExists(kLane)) continue;
+
+        const Lane& kOtherLane = kOther->fLanes[kLane];
+        const uint32_t kBehind = kOther->findBehindJunction(kLane, kDistance, kOther->fName < fName);
+        if(kBehind != kOtherLane.size() and not kOtherLane[kBehind]->canStopBehind(kOther->fRoadLength - kDistance)) return false;
+        if(kBehind != 0 and not kVehicle->canStopBehind(fRoadLength - kOther->fRoadLength + kOtherLane.getPosition(kBehind - 1))) return false;
+    }
+    return true;
+}
+
+uint32_t Road::findMergeLane(const uint32_t kLane, const IVehicle* const kVehicle, uint32_t& index) const
+{
+    const uint32_t kNeighbours[2] = {kLane - 1, kLane + 1};
+    for(uint32_t i = 0; i < 2; i++)
+    {
+        if(not laneExists(kNeighbours[i])) continue;
+        const Lane& kOther = fLanes[kNeighbours[i]];
+        index = kOther.find(kVehicle, kOther.findBehind(kVehicle->getPosition()));
+        if(index != kOther.size()) return kNeighbours[i];
+    }
+    return getNumLanes();
+}
+
+bool Road::canStopBeforeRoad(const uint32_t kLane, const double kPosition, const Road* const kOrigin) const
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling canStopBeforeRoad");
 
+    for(uint32_t i = 0; i < fPreviousRoads.size(); i++)
+    {
+        const Road* const kPrevious = fPreviousRoads[i];
+        if(kPrevious == kOrigin or not kPrevious->laneExists(kLane)) continue;    // stop when the roads form a ring
+
+        const double kOffset = kPosition + kPrevious->fRoadLength;
+        if(kPrevious->fLanes[kLane].empty())
+        {
+            if(not kPrevious->canStopBeforeRoad(kLane, kOffset, kOrigin)) return false;
+        }
+        else if(not kPrevious->fLanes[kLane].front()->canStopBehind(kOffset)) return false;
+    }
+    return true;
+}
 
+void Road::retire(IVehicle* const kVehicle)
+{
+    REQUIRE(this->properlyInitialized(), "Road was not initialized when calling retire");
+    if(fRetired == NULL) delete kVehicle;
+    else fRetired->push_back(kVehicle);
+}
@@ -14,11 +14,13 @@
 #include <vector>
 #include "vehicles/IVehicle.h"
 #include "TrafficSigns.h"
-
-typedef std::vector<IVehicle*>::const_iterator Iter;
+#include "Lane.h"
+#include "LaneKernel.h"
 
 class Road
 {
+    friend class SnapshotExporter;
+    friend class SnapshotParser;
 
 public:
 	/**
@@ -47,11 +49,38 @@ public:
     void updateTrafficSigns();
 
 	/**
+	 * moves every vehicle that has not moved during kEpoch yet, the network passes a new epoch every tick
+	 *
 	 * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling updateVehicles");
 	 */
-	void updateVehicles();
+	void updateVehicles(uint32_t kEpoch);
+
+	/**
+	 * moves all vehicles using only the state of the previous tick, every road can be moved independently
+	 *
+	 * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling moveVehiclesBuffered");
+	 */
+	void moveVehiclesBuffered(uint32_t kEpoch);
 
 	/**
+	 * carries out the lane changes and hands the vehicles that left the road to the next road,
+	 * must be called on every road after moveVehiclesBuffered was called on every road
+	 *
+	 * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling finishVehiclesBuffered");
+	 */
+	void finishVehiclesBuffered();
+
+	/**
+	 * copies the new state of all vehicles to the lanes, this is the state the next tick reads
+	 *
+	 * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling commitVehicles");
+	 */
+	void commitVehicles();
+
+	/**
+	 * returns true if there are still vehicles on the road. A road that is updated on its own starts a new tick by
+	 * passing the next epoch to updateVehicles.
+	 *
 	 * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling checkAndReset");
 	 */
 	bool checkAndReset();
@@ -62,19 +91,53 @@ public:
     void enqueue(IVehicle* kVehicle);
 
     /**
+     * the vehicle is added at the back of kLane, vehicles must be enqueued from the front of the lane to the back
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling enqueue");
+     * REQUIRE(kVehicle->properlyInitialized(), "Vehicle was not initialized when calling enqueue");
+     * REQUIRE(kLane < this->getNumLanes(), "Cannot enqueue on an non-existant lane");
+     */
+    void enqueue(IVehicle* kVehicle, uint32_t kLane);
+
+    /**
+     * vehicle is at kIndex on kLane, the neighbours on the new lane are found with binary search
+     *
      * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling changeLaneIfPossible");
      * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling laneExists");
+     * REQUIRE(kIndex < fLanes[kLane].size() and fLanes[kLane][kIndex] == vehicle, "vehicle is not at kIndex on kLane");
      */
-    bool changeLaneIfPossible(IVehicle* vehicle, uint32_t kLane, bool kLeft);
+    bool changeLaneIfPossible(IVehicle* vehicle, uint32_t kLane, uint32_t kIndex, bool kLeft);
 
     /**
      * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getNextTrafficLight");
      * REQUIRE(laneExists(lane), "Cannot get vehicles on an non-existant lane");
      * REQUIRE(index < fLanes[lane].size(), "Index is out of range");
      *
-     * ENSURE(getNextVehicle(kLane, kIndex).getMoved());
+     * ENSURE(getNextVehicle(kLane, kIndex).getMoved(kEpoch));
+     */
+    void updateNextVehicles(uint32_t kEpoch);
+
+    /**
+     * vehicles that leave the network are appended to kRetired instead of being deleted, NULL deletes them right away
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling setRetired");
      */
-    void updateNextVehicles();
+    void setRetired(std::vector<IVehicle*>* kRetired);
+
+    /**
+     * sets how moveVehiclesBuffered computes the vehicles that only follow their leader, kKernelOn computes a whole
+     * lane at once, kKernelValidate computes them both ways and counts the vehicles that do not give the same result
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling setKernelMode");
+     */
+    void setKernelMode(EKernelMode kMode);
+
+    /**
+     * the number of vehicles for which the lane kernel did not give exactly the same result in validate mode
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getKernelMismatches");
+     */
+    uint64_t getKernelMismatches() const;
 
     //--------------------------------------------------------------------------------------------------//
 
@@ -83,6 +146,13 @@ public:
      */
     bool isEmpty() const;
 
+    /**
+     * the amount of vehicles on the road, a merging vehicle is only counted once
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getNumVehicles");
+     */
+    uint32_t getNumVehicles() const;
+
 	/**
 	 * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getNextRoad");
 	 */
@@ -124,7 +194,13 @@ public:
      * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling operator[]");
      * REQUIRE(laneExists(kIndex), "lane does not exist");
      */
-    const std::vector<IVehicle*>& operator[](uint32_t kIndex) const;
+    const Lane& operator[](uint32_t kIndex) const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getLane");
+     * REQUIRE(laneExists(kIndex), "lane does not exist");
+     */
+    const Lane& getLane(uint32_t kIndex) const;
 
     //--------------------------------------------------------------------------------------------------//
     //              al de onderstaande functies zijn voor verkeerstekens methodes                       //
@@ -164,7 +240,7 @@ public:
     std::vector<const TrafficLight*> getTrafficLights() const;
 
     //--------------------------------------------------------------------------------------------------//
-    //      al de onderstaande functies leiden tot een oneindige loop als banen een cirkel vormen       //
+    //    al de onderstaande functies volgen de volgende banen en stoppen als die een cirkel vormen     //
     //--------------------------------------------------------------------------------------------------//
 
     /**
@@ -173,6 +249,25 @@ public:
      */
 	double getSpeedLimit(double kPosition = 0) const;
 
+    /**
+     * the same as getSpeedLimit, but the search in the speed profile continues from kIndex, the result of the
+     * previous search. kIndex is updated for the next search.
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getSpeedLimit");
+     * REQUIRE(position >= 0 and position < getRoadLength(), "position not valid");
+     */
+    double getSpeedLimit(double kPosition, uint32_t& kIndex) const;
+
+    /**
+     * the speed limit of every vehicle on kLane, at the position that is stored in the lane. The profile is walked
+     * once for the whole lane, moveLaneBuffered uses this instead of a search for every vehicle
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getSpeedLimits");
+     * REQUIRE(laneExists(kLane), "lane does not exist");
+     * ENSURE(kLimits.size() == getLane(kLane).size(), "there must be a speed limit for every vehicle");
+     */
+    void getSpeedLimits(uint32_t kLane, std::vector<double>& kLimits) const;
+
     /**
      * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getNextBusStop");
      * REQUIRE(position >= 0 and position < getRoadLength(), "position not valid");
@@ -186,12 +281,78 @@ public:
     std::pair<const TrafficLight*, double> getTrafficLight(double kPosition = 0) const;
 
     /**
+     * the same as getBusStop, but the search continues from kIndex, which must be the result of the previous
+     * search on this road with the same sign version. kIndex is updated for the next search.
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getBusStop");
+     * REQUIRE(position >= 0 and position < getRoadLength(), "position not valid");
+     */
+    std::pair<const BusStop*, double> getBusStop(double kPosition, uint32_t& kIndex) const;
+
+    /**
+     * the same as getTrafficLight, but the search continues from kIndex, which must be the result of the previous
+     * search on this road with the same sign version. kIndex is updated for the next search.
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getTrafficLight");
+     * REQUIRE(position >= 0 and position < getRoadLength(), "position not valid");
+     */
+    std::pair<const TrafficLight*, double> getTrafficLight(double kPosition, uint32_t& kIndex) const;
+
+    /**
+     * changes every time a traffic light or bus stop is added, the indices of the previous searches are invalid then
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getSignVersion");
+     */
+    uint32_t getSignVersion() const;
+
+    /**
+     * the vehicle in front of kIndex on kLane, on this road or one of the next roads. When the roads form a ring
+     * the search stops at this road again.
+     *
      * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getNextVehicle");
      * REQUIRE(laneExists(lane), "Cannot get vehicles on an non-existant lane");
      * REQUIRE(index < fLanes[lane].size(), "Index is out of range");
      */
     std::pair<const IVehicle*, double> getNextVehicle(uint32_t kLane, uint32_t kIndex) const;
 
+    /**
+     * the position of the vehicle in front of kIndex on kLane as the lanes store it, on this road or one of the next
+     * roads. False if there is no such vehicle.
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getLeaderPosition");
+     * REQUIRE(laneExists(kLane), "Cannot get vehicles on an non-existant lane");
+     * REQUIRE(kIndex < fLanes[kLane].size(), "Index is out of range");
+     */
+    std::pair<bool, double> getLeaderPosition(uint32_t kLane, uint32_t kIndex) const;
+
+    /**
+     * a merging vehicle is on kLane and on one of the lanes next to it, this is getLeaderPosition on that other lane.
+     * False if the vehicle is not on a lane next to kLane.
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getMergeLeaderPosition");
+     * REQUIRE(laneExists(kLane), "Cannot get vehicles on an non-existant lane");
+     */
+    std::pair<bool, double> getMergeLeaderPosition(uint32_t kLane, const IVehicle* kVehicle) const;
+
+    /**
+     * the lanes kLane of all roads that lead to the next road join at its start. This is the position on this road
+     * of the first vehicle on such a lane of another road that is closer to the junction than kVehicle, as the lanes
+     * store it. A merging vehicle also looks at its other lane. False if there is none.
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getJunctionLeaderPosition");
+     * REQUIRE(laneExists(kLane), "Cannot get vehicles on an non-existant lane");
+     */
+    std::pair<bool, double> getJunctionLeaderPosition(uint32_t kLane, const IVehicle* kVehicle) const;
+
+    /**
+     * returns the first non empty lane kLane on one of the next roads, the last vehicle of it is the leader of
+     * the first vehicle on kLane of this road. The second value is the offset of that road.
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling getNextLane");
+     * REQUIRE(laneExists(kLane), "Cannot get vehicles on an non-existant lane");
+     */
+    std::pair<const Lane*, double> getNextLane(uint32_t kLane) const;
+
 private:
     /**
      * ENSURE(fVehicles.front()->getPosition() <= getRoadLength(), "Update failed to place vehicle on next road or delete it.");
@@ -199,13 +360,24 @@ private:
     void dequeueFinishedVehicles();
 
     /**
-     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling enqueue");
-     * REQUIRE(kVehicle->properlyInitialized(), "Vehicle was not initialized when calling enqueue");
-     * REQUIRE(kLane < this->getNumLanes(), "Cannot enqueue on an non-existant lane");
+     * rebuilds the speed profile from the zones if a zone has been changed since it was built
      *
-     * ENSURE(getVehicles().front()->getPosition() <= getRoadLength(), "Update failed to place vehicle on next road or delete it.");
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling updateSpeedProfile");
      */
-    void enqueue(IVehicle* kVehicle, uint32_t kLane);
+    void updateSpeedProfile() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling updateMergingVehicles");
+     */
+    void updateMergingVehicles();
+
+    /**
+     * moveVehiclesBuffered for one lane, with the lane kernel
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling moveLaneBuffered");
+     * REQUIRE(laneExists(kLane), "Cannot move a non-existant lane");
+     */
+    void moveLaneBuffered(uint32_t kLane, uint32_t kEpoch);
 
     /**
      * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling dequeue");
@@ -214,18 +386,73 @@ private:
      */
     void dequeue(uint32_t kLane);
 
+    /**
+     * removes the other entry of a merging vehicle that leaves the road from kLane
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling finishMerging");
+     * REQUIRE(laneExists(kLane), "Cannot finish merging on an non-existant lane");
+     */
+    void finishMerging(const IVehicle* kVehicle, uint32_t kLane);
+
+    /**
+     * the index of the first vehicle on kLane that joins the next road after a vehicle at kDistance before the end
+     * of its road, a vehicle at the same distance joins first if kTieInFront
+     */
+    uint32_t findBehindJunction(uint32_t kLane, double kDistance, bool kTieInFront) const;
+
+    /**
+     * true if the vehicles on kLane of the other roads that lead to the next road can still brake in time for
+     * kVehicle, and kVehicle for them, when it changes to kLane
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling canJoinJunction");
+     */
+    bool canJoinJunction(uint32_t kLane, const IVehicle* kVehicle) const;
+
+    /**
+     * a merging vehicle is on kLane and on one of the lanes next to it, this is that other lane and the index of the
+     * vehicle on it in index. getNumLanes() if the vehicle is not on a lane next to kLane.
+     */
+    uint32_t findMergeLane(uint32_t kLane, const IVehicle* kVehicle, uint32_t& index) const;
+
+    /**
+     * true if the first vehicle on kLane of every previous road can stop behind kPosition on this road. Empty lanes
+     * are skipped like getNextVehicle does, the search stops at kOrigin when the roads form a ring.
+     *
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling canStopBeforeRoad");
+     */
+    bool canStopBeforeRoad(uint32_t kLane, double kPosition, const Road* kOrigin) const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "Road was not initialized when calling retire");
+     */
+    void retire(IVehicle* kVehicle);
+
     //--------------------------------------------------------------------------------------------------//
 
+	static const uint32_t fgkMergeTicks;            // a merging vehicle leaves its old lane after fgkMergeTicks + 1 updates
+
 	double fRoadLength;
 	std::string fName;
 
 	Road* fNextRoad;
-	std::vector<std::vector<IVehicle*> > fLanes;
-	std::vector<std::tuple<uint32_t, uint32_t, const IVehicle*>> fMergingVehicles;
+	std::vector<const Road*> fPreviousRoads;       // the roads that have this road as their next road
+	bool fUpdating;                                 // true during updateVehicles, so a ring of roads does not update a road twice
+	std::vector<Lane> fLanes;
+	uint32_t fNumVehicles;
+	std::vector<std::vector<std::pair<uint32_t, const IVehicle*> > > fMergeWheel;   // merging vehicles and their old lane, per update in which they finish
+	uint32_t fMergeTick;                                                              // the bucket of the last updateMergingVehicles
+	std::vector<IVehicle*>* fRetired;
+
+	EKernelMode fKernelMode;
+	uint64_t fKernelMismatches;
 
 	std::vector<const Zone*> fZones;
+	mutable std::vector<double> fProfilePositions;  // start of every part of the speed profile, parts with the same limit are merged
+	mutable std::vector<double> fProfileLimits;     // speed limit of every part of the speed profile
+	mutable uint32_t fProfileVersion;               // the zone version the speed profile was built with
 	std::vector<const BusStop*> fBusStops;
 	std::vector<const TrafficLight*> fTrafficLights;
+	uint32_t fSignVersion;
 
 	Road* _initCheck;
 };
@@ -0,0 +1,241 @@
+//============================================================================
+// @name        : RoadScheduler.cpp
+// @author      : Thomas Dooms
+// @date        : 5/23/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : updates the independent parts of a network concurrently on a pool of threads
+//============================================================================
+
+#include <map>
+#include <algorithm>
+#include "RoadScheduler.h"
+#include "../DesignByContract.h"
+
+namespace
+{
+    uint32_t findRoot(std::vector<uint32_t>& parents, uint32_t index)
+    {
+        while(parents[index] != index)
+        {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    }
+
+    struct CompareSize
+    {
+        explicit CompareSize(const std::vector<std::vector<uint32_t> >& kComponents) : fComponents(kComponents) {}
+        bool operator()(uint32_t lhs, uint32_t rhs) const { return fComponents[lhs].size() > fComponents[rhs].size(); }
+
+        const std::vector<std::vector<uint32_t> >& fComponents;
+    };
+}
+
+RoadScheduler::RoadScheduler(const std::vector<Road*>& kRoads, const uint32_t kThreads)
+{
+    REQUIRE(kThreads > 0, "Scheduler needs at least one thread");
+
+    fRoads = kRoads;
+
+    // union every road with its next road, roads that are not part of the network are included as well
+    std::map<const Road*, uint32_t> indices;
+    std::vector<uint32_t> parents;
+    for(uint32_t i = 0; i < fRoads.size(); i++)
+    {
+        Road* road = fRoads[i];
+        while(road != NULL and indices.find(road) == indices.end())
+        {
+            indices[road] = fNodes.size();
+            parents.push_back(fNodes.size());
+            fNodes.push_back(road);
+            road = road->getNextRoad();
+        }
+    }
+    for(uint32_t i = 0; i < fNodes.size(); i++)
+    {
+        if(fNodes[i]->getNextRoad() == NULL) continue;
+        parents[findRoot(parents, i)] = findRoot(parents, indices[fNodes[i]->getNextRoad()]);
+    }
+
+    // gather the roads of every component in the order of the network
+    std::map<uint32_t, uint32_t> roots;
+    std::vector<std::vector<uint32_t> > components;
+    for(uint32_t i = 0; i < fRoads.size(); i++)
+    {
+        const uint32_t kRoot = findRoot(parents, indices[fRoads[i]]);
+        if(roots.find(kRoot) == roots.end())
+        {
+            roots[kRoot] = components.size();
+            components.push_back(std::vector<uint32_t>());
+        }
+        components[roots[kRoot]].push_back(i);
+    }
+
+    // big components are handed out first to balance the load
+    for(uint32_t i = 0; i < components.size(); i++) fOrder.push_back(i);
+    std::stable_sort(fOrder.begin(), fOrder.end(), CompareSize(components));
+
+    fComponents.resize(components.size());
+    fComponentOf.resize(fRoads.size());
+    fSegments.resize(fRoads.size());
+    for(uint32_t i = 0; i < components.size(); i++)
+    {
+        fComponents[i].fRoads = components[i];
+        fComponents[i].fActive = false;
+        for(uint32_t j = 0; j < components[i].size(); j++) fComponentOf[components[i][j]] = i;
+    }
+    for(uint32_t i = 0; i < fNodes.size(); i++)
+    {
+        fNodes[i]->setRetired(&fComponents[roots[findRoot(parents, i)]].fRetired);
+    }
+
+    fGeneration = 0;
+    fBusy = 0;
+    fBuffered = false;
+    fEpoch = 0;
+    fStop = false;
+    fNext = 0;
+
+    // the calling thread does its share of the work as well
+    const uint32_t kWorkers = std::min<uint32_t>(kThreads, std::max<uint32_t>(fComponents.size(), 1)) - 1;
+    for(uint32_t i = 0; i < kWorkers; i++) fThreads.push_back(std::thread(&RoadScheduler::work, this));
+
+    _initCheck = this;
+    ENSURE(this->properlyInitialized(), "RoadScheduler constructor must end in properlyInitialized state");
+}
+
+RoadScheduler::~RoadScheduler()
+{
+    REQUIRE(this->properlyInitialized(), "RoadScheduler was not initialized when calling the destructor");
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+    }
+    fStart.notify_all();
+    for(uint32_t i = 0; i < fThreads.size(); i++) fThreads[i].join();
+    for(uint32_t i = 0; i < fNodes.size(); i++) fNodes[i]->setRetired(NULL);
+}
+
+bool RoadScheduler::properlyInitialized() const
+{
+    return _initCheck == this;
+}
+
+uint32_t RoadScheduler::getNumThreads() const
+{
+    REQUIRE(this->properlyInitialized(), "RoadScheduler was not initialized when calling getNumThreads");
+    return fThreads.size() + 1;
+}
+
+uint32_t RoadScheduler::getNumComponents() const
+{
+    REQUIRE(this->properlyInitialized(), "RoadScheduler was not initialized when calling getNumComponents");
+    return fComponents.size();
+}
+
+bool RoadScheduler::update(const bool kBuffered, const uint32_t kEpoch)
+{
+    REQUIRE(this->properlyInitialized(), "RoadScheduler was not initialized when calling update");
+
+    fNext = 0;
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fBusy = fThreads.size();
+        fBuffered = kBuffered;
+        fEpoch = kEpoch;
+        fGeneration++;
+    }
+    fStart.notify_all();
+
+    updateComponents();
+    {
+        std::unique_lock<std::mutex> lock(fMutex);
+        while(fBusy != 0) fDone.wait(lock);
+    }
+
+    // delete the vehicles that left the network in the same order as the sequential update
+    for(uint32_t i = 0; i < fRoads.size(); i++)
+    {
+        const std::vector<IVehicle*>& kRetired = fComponents[fComponentOf[i]].fRetired;
+        for(uint32_t j = fSegments[i].first; j < fSegments[i].second; j++) delete kRetired[j];
+    }
+
+    bool simulationDone = true;
+    for(uint32_t i = 0; i < fComponents.size(); i++)
+    {
+        fComponents[i].fRetired.clear();
+        if(fComponents[i].fActive) simulationDone = false;
+    }
+    return simulationDone;
+}
+
+void RoadScheduler::work()
+{
+    uint64_t generation = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(fMutex);
+            while(not fStop and fGeneration == generation) fStart.wait(lock);
+            if(fStop) return;
+            generation = fGeneration;
+        }
+
+        updateComponents();
+
+        std::lock_guard<std::mutex> lock(fMutex);
+        if(--fBusy == 0) fDone.notify_one();
+    }
+}
+
+void RoadScheduler::updateComponents()
+{
+    for(uint32_t i = fNext++; i < fOrder.size(); i = fNext++) updateComponent(fOrder[i]);
+}
+
+void RoadScheduler::updateComponent(const uint32_t kComponent)
+{
+    REQUIRE(kComponent < getNumComponents(), "Component does not exist");
+
+    Component& component = fComponents[kComponent];
+    const std::vector<uint32_t>& kRoads = component.fRoads;
+
+    for(uint32_t i = 0; i < kRoads.size(); i++)
+    {
+        fRoads[kRoads[i]]->updateTrafficSigns();
+    }
+    if(fBuffered)
+    {
+        for(uint32_t i = 0; i < kRoads.size(); i++)
+        {
+            fRoads[kRoads[i]]->moveVehiclesBuffered(fEpoch);
+        }
+        for(uint32_t i = 0; i < kRoads.size(); i++)
+        {
+            fSegments[kRoads[i]].first = component.fRetired.size();
+            fRoads[kRoads[i]]->finishVehiclesBuffered();
+            fSegments[kRoads[i]].second = component.fRetired.size();
+        }
+        component.fActive = false;
+        for(uint32_t i = 0; i < kRoads.size(); i++)
+        {
+            fRoads[kRoads[i]]->commitVehicles();
+            if(!fRoads[kRoads[i]]->isEmpty()) component.fActive = true;
+        }
+        return;
+    }
+
+    for(uint32_t i = 0; i < kRoads.size(); i++)
+    {
+        fSegments[kRoads[i]].first = component.fRetired.size();
+        fRoads[kRoads[i]]->updateVehicles(fEpoch);
+        fSegments[kRoads[i]].second = component.fRetired.size();
+    }
+    component.fActive = false;
+    for(uint32_t i = 0; i < kRoads.size(); i++)
+    {
+        if(!fRoads[kRoads[i]]->isEmpty()) component.fActive = true;
+    }
+}
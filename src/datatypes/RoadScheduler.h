@@ -0,0 +1,114 @@
+//============================================================================
+// @name        : RoadScheduler.h
+// @author      : Thomas Dooms
+// @date        : 5/23/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : updates the independent parts of a network concurrently on a pool of threads
+//============================================================================
+
+#ifndef SIMULATION_ROADSCHEDULER_H
+#define SIMULATION_ROADSCHEDULER_H
+
+#include <stdint.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "Road.h"
+
+/**
+ * Roads only ever look at and hand vehicles to the roads after them, so the roads that are connected through
+ * their next roads (a corridor and everything that feeds into it) form a component that never interacts with
+ * the other components. Every component is updated by one thread, in the same order as Network::update does,
+ * so the result is exactly the same as the sequential update. Vehicles that leave the network are deleted
+ * afterwards in the order the sequential update would have deleted them.
+ */
+class RoadScheduler
+{
+public:
+    /**
+     * REQUIRE(kThreads > 0, "Scheduler needs at least one thread");
+     *
+     * ENSURE(this->properlyInitialized(), "RoadScheduler constructor must end in properlyInitialized state");
+     */
+    RoadScheduler(const std::vector<Road*>& kRoads, uint32_t kThreads);
+
+    /**
+     * the roads delete the vehicles that leave the network themselves again afterwards
+     *
+     * REQUIRE(this->properlyInitialized(), "RoadScheduler was not initialized when calling the destructor");
+     */
+    ~RoadScheduler();
+
+    bool properlyInitialized() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "RoadScheduler was not initialized when calling getNumThreads");
+     */
+    uint32_t getNumThreads() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "RoadScheduler was not initialized when calling getNumComponents");
+     */
+    uint32_t getNumComponents() const;
+
+    /**
+     * updates all roads once, returns true if the network is empty afterwards.
+     * kBuffered uses the double-buffered update of the roads, see Network::setDoubleBuffered, kEpoch is the tick
+     * of the network
+     *
+     * REQUIRE(this->properlyInitialized(), "RoadScheduler was not initialized when calling update");
+     */
+    bool update(bool kBuffered, uint32_t kEpoch);
+
+private:
+    struct Component
+    {
+        std::vector<uint32_t> fRoads;       // indices in the network, in the order of the network
+        std::vector<IVehicle*> fRetired;    // vehicles that left the network during this tick
+        bool fActive;                       // true if there are still vehicles on this component
+    };
+
+    RoadScheduler(const RoadScheduler&);
+    RoadScheduler& operator=(const RoadScheduler&);
+
+    /**
+     * the main loop of the worker threads
+     */
+    void work();
+
+    /**
+     * updates components until there are none left for this tick
+     */
+    void updateComponents();
+
+    /**
+     * REQUIRE(kComponent < getNumComponents(), "Component does not exist");
+     */
+    void updateComponent(uint32_t kComponent);
+
+    std::vector<Road*> fRoads;
+    std::vector<Road*> fNodes;                              // the roads of the network and all roads after them
+    std::vector<Component> fComponents;
+    std::vector<uint32_t> fOrder;                           // the components from big to small, to balance the load
+    std::vector<uint32_t> fComponentOf;                     // component of every road
+    std::vector<std::pair<uint32_t, uint32_t> > fSegments;  // the vehicles every road retired in the retired list of its component
+
+    std::vector<std::thread> fThreads;
+    std::mutex fMutex;
+    std::condition_variable fStart;
+    std::condition_variable fDone;
+    uint64_t fGeneration;
+    uint32_t fBusy;
+    bool fBuffered;
+    uint32_t fEpoch;
+    bool fStop;
+    std::atomic<uint32_t> fNext;
+
+    const RoadScheduler* _initCheck;
+};
+
+
+#endif //SIMULATION_ROADSCHEDULER_H
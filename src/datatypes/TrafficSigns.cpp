@@ -180,6 +180,8 @@ double BusStop::getPosition() const
 
 //--------------------------------------------------------------------------------------------------//
 
+uint32_t Zone::fgVersion = 0;
+
 Zone::Zone(const double kPosition, const double kSpeedLimit)
 {
     REQUIRE(kPosition   >= 0, "kPosition must be greater than 0"  );
@@ -206,6 +208,7 @@ void Zone::setSpeedLimit(const double kSpeedlimit) const
     REQUIRE(properlyInitialized(), "Zone was not properly initialized when calling setSpeedLimit");
     REQUIRE(kSpeedlimit >= 0, "kSpeedLimit must be greater than 0");
     fSpeedlimit = kSpeedlimit;
+    fgVersion++;
     ENSURE(getSpeedlimit() == kSpeedlimit, "new speedlimit not set when calling setSpeedLimit");
 }
 
@@ -215,3 +218,7 @@ double Zone::getPosition() const
     return fPosition;
 }
 
+uint32_t Zone::getVersion()
+{
+    return fgVersion;
+}
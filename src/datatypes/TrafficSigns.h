@@ -12,13 +12,17 @@
 
 #include <stdint.h>
 #include <utility>
+#include <cstddef>
+#include "Allocator.h"
 class IVehicle;
 
 
 //--------------------------------------------------------------------------------------------------//
 
-class TrafficLight
+class TrafficLight : public ArenaAllocated
 {
+    friend class SnapshotExporter;
+    friend class SnapshotParser;
 public:
     enum EColor{kRed, kOrange, kGreen};
 
@@ -84,8 +88,10 @@ private:
 
 //--------------------------------------------------------------------------------------------------//
 
-class BusStop
+class BusStop : public ArenaAllocated
 {
+    friend class SnapshotExporter;
+    friend class SnapshotParser;
 public:
     /*
      * REQUIRE(kPosition > 0, "kPosition must be greater than 0");
@@ -131,7 +137,7 @@ private:
 
 //--------------------------------------------------------------------------------------------------//
 
-class Zone
+class Zone : public ArenaAllocated
 {
 public:
     /*
@@ -160,10 +166,17 @@ public:
      */
     double getPosition() const;
 
+    /*
+     * changes every time the speed limit of any zone is changed, roads rebuild their speed profile then
+     */
+    static uint32_t getVersion();
+
 private:
     double fPosition;
     mutable double fSpeedlimit;
 
+    static uint32_t fgVersion;
+
     const Zone* _initCheck;
 };
 
@@ -11,7 +11,9 @@
 #define SIMULATION_UTIL_H
 
 
+#include <stdint.h>
 #include <utility>
+#include <vector>
 #include <algorithm>
 
 template<typename T>
@@ -38,19 +40,23 @@ bool comparePositions(const T* lhs, const T* rhs)
     return lhs->getPosition() < rhs->getPosition();
 }
 
-struct Comparator : public std::unary_function<Road*, bool>
-{
-    explicit Comparator(const std::string& base) : fBase(base) {}
-    bool operator()(Road* road) { return fBase == road->getName(); }
-
-    const std::string& fBase;
-};
-
 template<typename T>
 typename std::vector<const T*>::iterator insert_sorted(std::vector<const T*>& vec, const T* item)
 {
     return vec.insert(std::upper_bound(vec.begin(), vec.end(), item, comparePositions<T>), item);
 }
 
+/**
+ * returns the first item after position, like upper_bound, but the search starts from index: the result of the
+ * previous search. When position only increases a little every time this is O(1). Returns NULL if there is none.
+ */
+template<typename T>
+const T* upper_bound_from(const std::vector<const T*>& vec, double position, uint32_t& index)
+{
+    if(index > vec.size()) index = vec.size();
+    while(index < vec.size() and vec[index]->getPosition() <= position) index++;
+    while(index > 0 and vec[index - 1]->getPosition() > position) index--;
+    return (index < vec.size()) ? vec[index] : NULL;
+}
 
 #endif //SIMULATION_UTIL_H
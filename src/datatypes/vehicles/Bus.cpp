@@ -10,15 +10,17 @@
 #include "Bus.h"
 #include "../../DesignByContract.h"
 
-const double Bus::fgkMaxAcceleration = 1.0;
-const double Bus::fgkMinAcceleration = -7.0;
+const double Bus::fgkMaxAcceleration = VehicleTraits<kBus>::fgkMaxAcceleration;
+const double Bus::fgkMinAcceleration = VehicleTraits<kBus>::fgkMinAcceleration;
 
-const double Bus::fgkMinSpeed = 0.0;
-const double Bus::fgkMaxSpeed = 70.0 / 3.6;
+const double Bus::fgkMinSpeed = VehicleTraits<kBus>::fgkMinSpeed;
+const double Bus::fgkMaxSpeed = VehicleTraits<kBus>::fgkMaxSpeed;
 
-const double Bus::fgkVehicleLength = 10;
+const double Bus::fgkVehicleLength = VehicleTraits<kBus>::fgkVehicleLength;
 
-Bus::Bus(const std::string& license, double position, double velocity) : IVehicle(license, position, velocity){}
+const VehicleConstants Bus::fgkConstants = makeVehicleConstants<kBus>();
+
+Bus::Bus(const std::string& license, double position, double velocity) : IVehicle(license, position, velocity, fgkConstants){}
 
 double Bus::getVehicleLength() const
 {
@@ -26,12 +28,6 @@ double Bus::getVehicleLength() const
     return fgkVehicleLength;
 }
 
-std::string Bus::getType() const
-{
-    REQUIRE(this->properlyInitialized(), "Bus was not initialized when calling getType");
-    return "bus";
-}
-
 double Bus::getMaxSpeed() const
 {
     REQUIRE(this->properlyInitialized(), "Bus was not initialized when calling getMaxSpeed");
@@ -12,8 +12,9 @@
 #define SIMULATION_BUS_H
 
 #include "IVehicle.h"
+#include "../Allocator.h"
 
-class Bus : public IVehicle
+class Bus : public IVehicle, public PoolAllocated<Bus>
 {
 public:
     /**
@@ -30,11 +31,6 @@ public:
     */
     virtual double getVehicleLength() const;
 
-    /**
-    * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getType");
-    */
-    virtual std::string getType() const;
-
     /**
     * REQUIRE(this->properlyInitialized(), "Bus was not initialized when calling getMaxSpeed");
     */
@@ -63,6 +59,8 @@ protected:
     static const double fgkMaxSpeed;
 
     static const double fgkVehicleLength;
+
+    static const VehicleConstants fgkConstants;
 };
 
 
@@ -1,15 +1,17 @@
 #include "Car.h"
 #include "../../DesignByContract.h"
 
-const double Car::fgkMaxAcceleration = 2.0;
-const double Car::fgkMinAcceleration = -8.0;
+const double Car::fgkMaxAcceleration = VehicleTraits<kCar>::fgkMaxAcceleration;
+const double Car::fgkMinAcceleration = VehicleTraits<kCar>::fgkMinAcceleration;
 
-const double Car::fgkMinSpeed = 0.0;
-const double Car::fgkMaxSpeed = 150.0 / 3.6;
+const double Car::fgkMinSpeed = VehicleTraits<kCar>::fgkMinSpeed;
+const double Car::fgkMaxSpeed = VehicleTraits<kCar>::fgkMaxSpeed;
 
-const double Car::fgkVehicleLength = 3;
+const double Car::fgkVehicleLength = VehicleTraits<kCar>::fgkVehicleLength;
 
-Car::Car(const std::string& license, double position, double velocity) : IVehicle(license, position, velocity){}
+const VehicleConstants Car::fgkConstants = makeVehicleConstants<kCar>();
+
+Car::Car(const std::string& license, double position, double velocity) : IVehicle(license, position, velocity, fgkConstants){}
 
 double Car::getVehicleLength() const
 {
@@ -17,12 +19,6 @@ double Car::getVehicleLength() const
     return fgkVehicleLength;
 }
 
-std::string Car::getType() const
-{
-    REQUIRE(this->properlyInitialized(), "Car was not initialized when calling getType");
-    return "auto";
-}
-
 double Car::getMaxSpeed() const
 {
     REQUIRE(this->properlyInitialized(), "Car was not initialized when calling getMaxSpeed");
@@ -12,8 +12,9 @@
 
 
 #include "IVehicle.h"
+#include "../Allocator.h"
 
-class Car : public IVehicle
+class Car : public IVehicle, public PoolAllocated<Car>
 {
 public:
     /**
@@ -30,11 +31,6 @@ public:
     */
     virtual double getVehicleLength() const;
 
-    /**
-    * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getType");
-    */
-    virtual std::string getType() const;
-
     /**
     * REQUIRE(this->properlyInitialized(), "Car was not initialized when calling getMaxSpeed");
     */
@@ -63,6 +59,8 @@ protected:
     static const double fgkMaxSpeed;
 
     static const double fgkVehicleLength;
+
+    static const VehicleConstants fgkConstants;
 };
 
 
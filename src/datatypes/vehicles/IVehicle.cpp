@@ -1,9 +1,12 @@
 #include "IVehicle.h"
 #include <iostream>
+#include <cmath>
+#include <limits>
 #include "../../DesignByContract.h"
 #include "../../exporters/VehicleExporter.h"
 #include "../TrafficSigns.h"
 #include "../Road.h"
+#include "../Lane.h"
 #include "../util.h"
 
 double clamp(double val, double min, double max){ return std::max(std::min(val, max), min); }
@@ -11,7 +14,7 @@ double clamp(double val, double min, double max){ return std::max(std::min(val,
 const double IVehicle::fgkMinVehicleDist = 5.0;
 const double IVehicle::fgkEpsilonThreshold = 0.01;
 
-IVehicle::IVehicle(const std::string& license, double position, double velocity)
+IVehicle::IVehicle(const std::string& license, double position, double velocity, const VehicleConstants& kConstants)
 {
     REQUIRE(velocity >= 0, "Velocity must be greater than 0");
     REQUIRE(position >= 0, "Position must be greater than 0");
@@ -19,9 +22,10 @@ IVehicle::IVehicle(const std::string& license, double position, double velocity)
 
     _initCheck = this;
 
-    fMoved = false;
+    fMovedEpoch = std::numeric_limits<uint32_t>::max();   // not moved in epoch 0, the first epoch of a network
     fStationed = false;
     fMerging = false;
+    fLaneChanges = 0;
 
     fLicensePlate = license;
 
@@ -29,11 +33,20 @@ IVehicle::IVehicle(const std::string& license, double position, double velocity)
     fVelocity = velocity;
     fAcceleration = 0;
 
-    fPrevAcceleration = std::deque<double>(5, 1);
+    fConstants = &kConstants;
+
+    for(uint32_t i = 0; i < 5; i++) fPrevAcceleration[i] = 1;
+    fPrevIndex = 0;
 
     fTrafficLightAccel = std::tuple<bool, double, const TrafficLight*>(false, 0, NULL);
     fBusStopAccel = std::tuple<bool, double, const BusStop*>(false, 0, NULL);
 
+    fSignRoad = NULL;
+    fSignVersion = 0;
+    fTrafficLightIndex = 0;
+    fBusStopIndex = 0;
+    fZoneIndex = 0;
+
     fTimer = 0;
     fDriveTimer = 0;
     fDistance = 0;
@@ -51,64 +64,198 @@ bool IVehicle::properlyInitialized() const
     return _initCheck == this;
 }
 
-void IVehicle::move(const uint32_t kLane, const uint32_t kIndex, Road* const kRoad)
+void IVehicle::move(const uint32_t kLane, const uint32_t kIndex, Road* const kRoad, const uint32_t kEpoch)
 {
     REQUIRE(this->properlyInitialized(), "moved vehicle must be properly initialized");
     REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling move");
     REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling move");
 
-    if(fMoved) return;      // moved means the vehicle already has been updated
-    fMoved = true;
+    if(fMovedEpoch == kEpoch) return;       // moved means the vehicle already has been updated
+    fMovedEpoch = kEpoch;
 
     updateStatistics();
     if(fStationed) return;  // stationed means the vehicle must not update
 
-    checkTrafficLights(kRoad->getTrafficLight(fPosition));                                              // calculate the slowdown if needed
-    checkBusStop(kRoad->getBusStop(fPosition));                                                         // calculate the slowdown if needed
-    const double kSpeedlimit = kRoad->getSpeedLimit(fPosition);                                         // calculate the speed limit
-
-    const std::pair<const IVehicle*, double> kNextVehicle = kRoad->getNextVehicle(kLane, kIndex);       // get the next vehicle
-    if(kNextVehicle.first != NULL and not kNextVehicle.first->getMoved()) kRoad->updateNextVehicles();  // if the next road hasnt been updated yet, update it.
-    double acceleration = getFollowingAcceleration(kNextVehicle);                                       // calculate the following speed
+    bool leader = true;
+    double leaderPosition = 0;
+    double leaderVelocity = 0;
+    double leaderLength = 0;
+    if(kIndex == 0)                                                                                     // the next vehicle is on one of the next roads
+    {
+        std::pair<const IVehicle*, double> nextVehicle = kRoad->getNextVehicle(kLane, kIndex);          // get the next vehicle
+        if(nextVehicle.first != NULL and not nextVehicle.first->getMoved(kEpoch))                             // if the next road hasnt been updated yet, update it.
+        {
+            kRoad->updateNextVehicles(kEpoch);
+            nextVehicle = kRoad->getNextVehicle(kLane, kIndex);                                         // a vehicle can have merged in front of us meanwhile
+        }
 
-    if(std::get<0>(fTrafficLightAccel)) acceleration = std::min(std::get<1>(fTrafficLightAccel), acceleration);    // we need to take the minimum of these values
-    if(std::get<0>(fBusStopAccel)     ) acceleration = std::min(std::get<1>(fBusStopAccel)     , acceleration);    // to ensure we slow down enough
+        leader = nextVehicle.first != NULL;
+        if(leader)
+        {
+            leaderPosition = pairPosition<IVehicle>(nextVehicle);
+            leaderVelocity = nextVehicle.first->getVelocity();
+            leaderLength = nextVehicle.first->getConstants().fLength;
+        }
+    }
+    else                                                                                                // the next vehicle is in front of us on this lane and has already moved
+    {
+        const Lane& kLaneState = kRoad->getLane(kLane);
+        leaderPosition = kLaneState.getPosition(kIndex-1);
+        leaderVelocity = kLaneState.getVelocity(kIndex-1);
+        leaderLength = kLaneState.getConstants(kIndex-1).fLength;
+    }
 
-    const std::pair<double, double> kMinMax = getMinMaxAcceleration(kSpeedlimit);                       // calculate the min and max acceleration possible
+    updateSignCursors(kRoad);
+    checkTrafficLights(kRoad->getTrafficLight(fPosition, fTrafficLightIndex));                          // calculate the slowdown if needed
+    checkBusStop(kRoad->getBusStop(fPosition, fBusStopIndex), leader ? leaderPosition - fgkMinVehicleDist - fgkEpsilonThreshold : std::numeric_limits<double>::max());
+    const double kSpeedlimit = kRoad->getSpeedLimit(fPosition, fZoneIndex);                             // calculate the speed limit
 
-    fAcceleration = clamp(acceleration, kMinMax.first, kMinMax.second);                                 // clamp the values
-    fVelocity += fAcceleration;                                                                         // Calculate new velocity
-    fPosition += fVelocity;                                                                             // Calculate new positions
-
-    fPrevAcceleration.push_front(fAcceleration);
-    fPrevAcceleration.pop_back();
+    // if there is not car in front, acceleration = max
+    double acceleration = leader ? getFollowingAcceleration(leaderPosition, leaderVelocity, leaderLength) : fConstants->fMaxAcceleration;
+    acceleration = std::min(acceleration, getSafeAcceleration(leader, leaderPosition, kLane, kRoad));   // never come closer than the vehicle can brake for
+    accelerate(acceleration, kSpeedlimit);
 
     if(kRoad->laneExists(kLane+1) and !fMerging) checkLaneChange(std::get<0>(fTrafficLightAccel), kLane, kIndex, kRoad, true , kSpeedlimit);// overtake if possible
     if(kRoad->laneExists(kLane-1) and !fMerging) checkLaneChange(std::get<0>(fTrafficLightAccel), kLane, kIndex, kRoad, false, kSpeedlimit);// go back if possible
 
     ENSURE(getVelocity() >= 0, "Velocity cannot be negative");
-    ENSURE((getAcceleration() >= getMinAcceleration()) && (getAcceleration() <= getMaxAcceleration()), "Acceleration is too high / low");
-    ENSURE(kNextVehicle.first == NULL or pairPosition<IVehicle>(kNextVehicle) - getPosition() > getMinVehicleDist(), "distance between vehicles must be greater than minVehicleDist");
-    ENSURE(fPrevAcceleration.size() == 5, "Previous acceleration must contain 5 elements");
+    ENSURE((getAcceleration() >= fConstants->fMinAcceleration) && (getAcceleration() <= fConstants->fMaxAcceleration), "Acceleration is too high / low");
+    ENSURE(not leader or leaderPosition - getPosition() > getMinVehicleDist(), "distance between vehicles must be greater than minVehicleDist");
 }
 
-double IVehicle::getFollowingAcceleration(std::pair<const IVehicle*, double> nextVehicle) const
+void IVehicle::moveBuffered(const uint32_t kLane, const uint32_t kIndex, Road* const kRoad, const uint32_t kEpoch)
 {
-    REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getFollowingAcceleration");
-    REQUIRE(nextVehicle.second >= 0, "nextVehicle ill-formed when calling getFollowingAcceleration");
+    REQUIRE(this->properlyInitialized(), "moved vehicle must be properly initialized");
+    REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling moveBuffered");
+    REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling moveBuffered");
+
+    if(beginMoveBuffered(kLane, kIndex, kRoad, kEpoch)) followBuffered(kLane, kIndex, kRoad, kRoad->getSpeedLimit(fPosition, fZoneIndex));
+}
+
+bool IVehicle::beginMoveBuffered(const uint32_t kLane, const uint32_t kIndex, Road* const kRoad, const uint32_t kEpoch)
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling beginMoveBuffered");
+    REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling beginMoveBuffered");
+    REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling beginMoveBuffered");
+
+    fLaneChanges = 0;
+    fMovedEpoch = kEpoch;
+
+    updateStatistics();
+    if(fStationed) return false;    // stationed means the vehicle must not update
+
+    updateSignCursors(kRoad);
+    checkTrafficLights(kRoad->getTrafficLight(fPosition, fTrafficLightIndex));                          // calculate the slowdown if needed
+    const std::pair<bool, double> kLeader = kRoad->getLeaderPosition(kLane, kIndex);
+    checkBusStop(kRoad->getBusStop(fPosition, fBusStopIndex), kLeader.first ? kLeader.second - fgkMinVehicleDist - fgkEpsilonThreshold : std::numeric_limits<double>::max());
+    return true;
+}
+
+bool IVehicle::isSlowingDown() const
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling isSlowingDown");
+    return std::get<0>(fTrafficLightAccel) or std::get<0>(fBusStopAccel);
+}
+
+void IVehicle::followBuffered(const uint32_t kLane, const uint32_t kIndex, Road* const kRoad, const double kSpeedlimit)
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling followBuffered");
+    REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling followBuffered");
+    REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling followBuffered");
+
+    // the leader is read from the lanes, which still hold the state of the previous tick
+    const std::pair<const Lane*, double> kNextLane = (kIndex == 0) ? kRoad->getNextLane(kLane) : std::pair<const Lane*, double>(&kRoad->getLane(kLane), 0);
+    double acceleration;
+    double leaderPosition = 0;
+    if(kNextLane.first != NULL)
+    {
+        const uint32_t kLeader = (kIndex == 0) ? kNextLane.first->size() - 1 : kIndex - 1;
+        leaderPosition = kNextLane.first->getPosition(kLeader) + kNextLane.second;
+        acceleration = getFollowingAcceleration(leaderPosition, kNextLane.first->getVelocity(kLeader), kNextLane.first->getConstants(kLeader).fLength);
+    }
+    else acceleration = fConstants->fMaxAcceleration;                                                   // if there is not car in front, acceleration = max
+
+    acceleration = std::min(acceleration, getSafeAcceleration(kNextLane.first != NULL, leaderPosition, kLane, kRoad));
+    accelerate(acceleration, kSpeedlimit);
+    requestLaneChanges(kLane, kRoad, kSpeedlimit);
+
+    ENSURE(getVelocity() >= 0, "Velocity cannot be negative");
+    ENSURE((getAcceleration() >= fConstants->fMinAcceleration) && (getAcceleration() <= fConstants->fMaxAcceleration), "Acceleration is too high / low");
+}
+
+void IVehicle::finishMoveBuffered(const double kAcceleration, const double kVelocity, const double kPosition, const uint32_t kLane, Road* const kRoad, const double kSpeedlimit)
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling finishMoveBuffered");
+    REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling finishMoveBuffered");
+    REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling finishMoveBuffered");
+
+    fAcceleration = kAcceleration;
+    fVelocity = kVelocity;
+    fPosition = kPosition;
+
+    fPrevAcceleration[fPrevIndex] = fAcceleration;                                                     // overwrite the oldest acceleration
+    fPrevIndex = (fPrevIndex + 1) % 5;
+
+    requestLaneChanges(kLane, kRoad, kSpeedlimit);
+
+    ENSURE(getVelocity() >= 0, "Velocity cannot be negative");
+    ENSURE((getAcceleration() >= fConstants->fMinAcceleration) && (getAcceleration() <= fConstants->fMaxAcceleration), "Acceleration is too high / low");
+}
+
+void IVehicle::requestLaneChanges(const uint32_t kLane, const Road* const kRoad, const double kSpeedlimit)
+{
+    REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling requestLaneChanges");
+    REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling requestLaneChanges");
+
+    if(kRoad->laneExists(kLane+1) and !fMerging and wantsLaneChange(std::get<0>(fTrafficLightAccel), true , kSpeedlimit)) fLaneChanges |= kChangeLeft;
+    if(kRoad->laneExists(kLane-1) and !fMerging and wantsLaneChange(std::get<0>(fTrafficLightAccel), false, kSpeedlimit)) fLaneChanges |= kChangeRight;
+}
+
+void IVehicle::changeLane(const uint32_t kLane, const uint32_t kIndex, Road* const kRoad)
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling changeLane");
+    REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling changeLane");
+
+    const uint8_t kRequested = fLaneChanges;
+    fLaneChanges = 0;
+
+    if((kRequested & kChangeLeft ) and !fMerging) fMerging = kRoad->changeLaneIfPossible(this, kLane, kIndex, true );    // overtake if possible
+    if((kRequested & kChangeRight) and !fMerging) fMerging = kRoad->changeLaneIfPossible(this, kLane, kIndex, false);    // go back if possible
+}
 
-    if(nextVehicle.first == NULL) return getMaxAcceleration();                                                  // if there is not car in front, acceleration = max
+void IVehicle::accelerate(const double acceleration, const double kSpeedlimit)
+{
+    REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling accelerate");
+
+    double result = acceleration;
+    if(std::get<0>(fTrafficLightAccel)) result = std::min(std::get<1>(fTrafficLightAccel), result);    // we need to take the minimum of these values
+    if(std::get<0>(fBusStopAccel)     ) result = std::min(std::get<1>(fBusStopAccel)     , result);    // to ensure we slow down enough
+
+    const std::pair<double, double> kMinMax = getMinMaxAcceleration(kSpeedlimit);                       // calculate the min and max acceleration possible
+
+    fAcceleration = clamp(result, kMinMax.first, kMinMax.second);                                       // clamp the values
+    fVelocity += fAcceleration;                                                                         // Calculate new velocity
+    fPosition += fVelocity;                                                                             // Calculate new positions
+
+    fPrevAcceleration[fPrevIndex] = fAcceleration;                                                     // overwrite the oldest acceleration
+    fPrevIndex = (fPrevIndex + 1) % 5;
+}
+
+double IVehicle::getFollowingAcceleration(const double kLeaderPosition, const double kLeaderVelocity, const double kLeaderLength) const
+{
+    REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getFollowingAcceleration");
+    REQUIRE(kLeaderLength > 0, "leader must have a length when calling getFollowingAcceleration");
 
     double ideal;
-    if(fVelocity - nextVehicle.first->getVelocity() > -getMinAcceleration())
+    if(fVelocity - kLeaderVelocity > -fConstants->fMinAcceleration)
     {
-        ideal  = 1.5 * fVelocity + nextVehicle.first->getVehicleLength() + 2;                               // ideal following distance = 3/4 speed + 2 meters extra
+        ideal  = 1.5 * fVelocity + kLeaderLength + 2;                                                       // ideal following distance = 3/4 speed + 2 meters extra
     }
     else
     {
-        ideal  = 0.75 * fVelocity + nextVehicle.first->getVehicleLength() + 2;                               // ideal following distance = 3/4 speed + 2 meters extra
+        ideal  = 0.75 * fVelocity + kLeaderLength + 2;                                                      // ideal following distance = 3/4 speed + 2 meters extra
     }
-    double actual = pairPosition<IVehicle>(nextVehicle) - nextVehicle.first->getVelocity() - nextVehicle.first->getVehicleLength() - fPosition;    // distance between 2 vehicles
+    double actual = kLeaderPosition - kLeaderVelocity - kLeaderLength - fPosition;                          // distance between 2 vehicles
 
 
     return 0.5 * (actual - ideal);                                                                              // take the average
@@ -119,14 +266,14 @@ std::pair<double, double> IVehicle::getMinMaxAcceleration(double speedlimit) con
     REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getMinMaxAcceleration");
     REQUIRE(speedlimit >= 0, "speedlimit must be greater than 0 when calling getMinMaxAcceleration");
 
-    double maxSpeed = std::min(speedlimit, getMaxSpeed());                              // take the maxSpeed as the minimum of both
-    double minSpeed = std::max(0.0       , getMinSpeed());                              // if the minimum speed is negative for some reason
+    double maxSpeed = std::min(speedlimit, fConstants->fMaxSpeed);                      // take the maxSpeed as the minimum of both
+    double minSpeed = std::max(0.0       , fConstants->fMinSpeed);                      // if the minimum speed is negative for some reason
 
-    double maxAcceleration = maxSpeed - getVelocity();                                  // check if going to fast
-    double minAcceleration = minSpeed - getVelocity();                                  // check if going too slow
+    double maxAcceleration = maxSpeed - fVelocity;                                      // check if going to fast
+    double minAcceleration = minSpeed - fVelocity;                                      // check if going too slow
 
-    double clampedMax = clamp(maxAcceleration, getMinAcceleration(), getMaxAcceleration());
-    double clampedMin = clamp(minAcceleration, getMinAcceleration(), getMaxAcceleration());
+    double clampedMax = clamp(maxAcceleration, fConstants->fMinAcceleration, fConstants->fMaxAcceleration);
+    double clampedMin = clamp(minAcceleration, fConstants->fMinAcceleration, fConstants->fMaxAcceleration);
 
     return std::pair<double, double>(clampedMin, clampedMax);
 }
@@ -160,19 +307,22 @@ void IVehicle::checkTrafficLights(std::pair<const TrafficLight*, double> nextTra
     }
 }
 
-void IVehicle::checkBusStop(std::pair<const BusStop*, double> nextBusStop)
+void IVehicle::checkBusStop(std::pair<const BusStop*, double> nextBusStop, const double kMaxPosition)
 {
     REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling checkBusStop");
     REQUIRE(nextBusStop.second >= 0, "nextBusStop ill-formed when calling checkBusStop");
 
-    if(getType() != "bus") return;
+    if(not fConstants->fUsesBusStops) return;
 
     if(std::get<0>(fBusStopAccel))
     {
         if(fVelocity < fgkEpsilonThreshold)
         {
+            const double kStation = std::max(fPosition, std::get<2>(fBusStopAccel)->getPosition()+fgkEpsilonThreshold);  // a bus that could not stop in time does not drive back
+            if(kStation > kMaxPosition) return;                                                                         // wait until the stop is free
+
             std::get<2>(fBusStopAccel)->setStationed(this);
-            fPosition = std::get<2>(fBusStopAccel)->getPosition()+fgkEpsilonThreshold;
+            fPosition = kStation;
             fBusStopAccel = std::tuple<bool, double, const BusStop*>(false, 0, NULL);
             return;
         }
@@ -191,21 +341,42 @@ void IVehicle::checkLaneChange(const bool trafficLight, const uint32_t lane, con
     REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling checkLaneChange");
     REQUIRE(road->laneExists(lane), "lane does not exist on road when calling checkLaneChange");
 
+    // 6. Er is geen voertuig op de nieuwe rijstrook in een straal van de ideale volgafstand (dus zowel voor als achter het voertuig).
+    if(wantsLaneChange(trafficLight, left, kSpeedlimit)) fMerging = road->changeLaneIfPossible(this, lane, index, left);
+}
+
+bool IVehicle::wantsLaneChange(const bool trafficLight, const bool left, const double kSpeedlimit) const
+{
+    REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling wantsLaneChange");
+
     // 5. Het voertuig is van type auto of motorfiets.
-    if(getType() != "auto" and getType() != "motorfiets") return;
+    if(not fConstants->fCanChangeLane) return false;
 
     // 4. Het voertuig rijdt volgens de regels in Use case 3.1, en is dus niet aan het vertragen voor een verkeersteken.
-    if(trafficLight) return;
+    if(trafficLight) return false;
 
     // 3. Het voertuig heeft 5 seconden op rij een versnelling van 0.
-    for(uint32_t i = 0; i < 5; i++) if(fPrevAcceleration[i] > fgkEpsilonThreshold) return;
+    for(uint32_t i = 0; i < 5; i++) if(fPrevAcceleration[i] > fgkEpsilonThreshold) return false;
 
     // 1. Het voertuig rijdt trager dan de snelheidslimiet van de baan of zone,
     // 2. Het voertuig rijdt trager dan zijn maximaal haalbare snelheid.
-    if(left and fVelocity >= std::min(kSpeedlimit, getMaxSpeed()) - fgkEpsilonThreshold) return;
+    if(left and fVelocity >= std::min(kSpeedlimit, fConstants->fMaxSpeed) - fgkEpsilonThreshold) return false;
 
-    // 6. Er is geen voertuig op de nieuwe rijstrook in een straal van de ideale volgafstand (dus zowel voor als achter het voertuig).
-    fMerging = road->changeLaneIfPossible(this, lane, left);
+    return true;
+}
+
+void IVehicle::updateSignCursors(const Road* const kRoad)
+{
+    REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling updateSignCursors");
+    REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling updateSignCursors");
+
+    if(kRoad == fSignRoad and kRoad->getSignVersion() == fSignVersion) return;
+
+    fSignRoad = kRoad;
+    fSignVersion = kRoad->getSignVersion();
+    fTrafficLightIndex = 0;
+    fBusStopIndex = 0;
+    fZoneIndex = 0;
 }
 
 std::pair<bool, double> IVehicle::calculateStop(double nextPos) const
@@ -216,11 +387,11 @@ std::pair<bool, double> IVehicle::calculateStop(double nextPos) const
     const double kDist = nextPos - fPosition;
     const double kAccel = -fVelocity*fVelocity/(kDist + 2*fVelocity);
 
-    double futurePos = fPosition + fVelocity + getMaxAcceleration();
+    double futurePos = fPosition + fVelocity + fConstants->fMaxAcceleration;
     double futureVel = fVelocity;
-    while(futureVel > -getMinAcceleration())
+    while(futureVel > -fConstants->fMinAcceleration)
     {
-        futureVel += getMinAcceleration();
+        futureVel += fConstants->fMinAcceleration;
         futurePos += futureVel;
     }
     futurePos += futureVel;
@@ -259,7 +430,7 @@ void IVehicle::updateStatistics()
 
 //--------------------------------------------------------------------------------------------------//
 
-std::string IVehicle::getLicensePlate() const
+const std::string& IVehicle::getLicensePlate() const
 {
     REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getLicensePlate");
     return fLicensePlate;
@@ -288,23 +459,97 @@ double IVehicle::getAcceleration() const
     return fAcceleration;
 }
 
+const VehicleConstants& IVehicle::getConstants() const
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getConstants");
+    return *fConstants;
+}
+
+EVehicleType IVehicle::getKind() const
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getKind");
+    return fConstants->fType;
+}
+
+std::string IVehicle::getType() const
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getType");
+    return fConstants->fName;
+}
+
 double IVehicle::getMinVehicleDist() const
 {
     REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getMinVehicleDist");
     return fgkMinVehicleDist;
 }
 
-bool IVehicle::getMoved() const
+bool IVehicle::canStopBehind(const double kLeaderPosition) const
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling canStopBehind");
+    return fPosition + getBrakingDistance(fVelocity) <= kLeaderPosition - fgkMinVehicleDist - fgkEpsilonThreshold;
+}
+
+double IVehicle::getSafeAcceleration(const bool kLeader, const double kLeaderPosition, const uint32_t kLane, const Road* const kRoad) const
+{
+    REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getSafeAcceleration");
+    REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling getSafeAcceleration");
+
+    // a leader further than the vehicle can brake for after accelerating as hard as it can does not bound it,
+    // the extra meter keeps the rounding of getStoppingAcceleration out of the comparison
+    const double kVelocity = fVelocity + fConstants->fMaxAcceleration;
+    const double kFree = fPosition + kVelocity + getBrakingDistance(kVelocity) + fgkMinVehicleDist + fgkEpsilonThreshold + 1;
+
+    double safe = std::numeric_limits<double>::infinity();
+    if(kLeader and kLeaderPosition < kFree) safe = getStoppingAcceleration(kLeaderPosition);
+    if(fMerging)                                                                                        // until it has merged it is on two lanes
+    {
+        const std::pair<bool, double> kMergeLeader = kRoad->getMergeLeaderPosition(kLane, this);
+        if(kMergeLeader.first and kMergeLeader.second < kFree) safe = std::min(safe, getStoppingAcceleration(kMergeLeader.second));
+    }
+    const std::pair<bool, double> kJunctionLeader = kRoad->getJunctionLeaderPosition(kLane, this);
+    if(kJunctionLeader.first and kJunctionLeader.second < kFree) safe = std::min(safe, getStoppingAcceleration(kJunctionLeader.second));
+    return safe;
+}
+
+double IVehicle::getBrakingDistance(double velocity) const
+{
+    REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getBrakingDistance");
+
+    double distance = 0;
+    while(velocity > -fConstants->fMinAcceleration)
+    {
+        velocity += fConstants->fMinAcceleration;
+        distance += velocity;
+    }
+    return distance;
+}
+
+double IVehicle::getStoppingAcceleration(const double kLeaderPosition) const
+{
+    REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getStoppingAcceleration");
+
+    const double kRoom = kLeaderPosition - fgkMinVehicleDist - fgkEpsilonThreshold - fPosition;
+    if(kRoom <= 0) return -fVelocity;
+
+    // a velocity v between n and n + 1 times the braking covers (n + 1) * v - braking * n * (n + 1) / 2 before it stands still
+    const double kBraking = -fConstants->fMinAcceleration;
+    uint32_t n = static_cast<uint32_t>(std::max(0.0, std::ceil(std::sqrt(2 * kRoom / kBraking + 0.25) - 1.5)));
+    while(n > 0 and kBraking * n * (n + 1) / 2 >= kRoom) n--;
+    while(kBraking * (n + 1) * (n + 2) / 2 < kRoom) n++;
+    return (kRoom + kBraking * n * (n + 1) / 2) / (n + 1) - fVelocity;
+}
+
+bool IVehicle::getMoved(const uint32_t kEpoch) const
 {
     REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getMoved");
-    return fMoved;
+    return fMovedEpoch == kEpoch;
 }
 
-void IVehicle::setMoved(const bool kMoved) const
+void IVehicle::setMoved(const bool kMoved, const uint32_t kEpoch) const
 {
     REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling setMoved");
-    fMoved = kMoved;
-    ENSURE(getMoved() == kMoved, "new moved not set when calling setMoved");
+    fMovedEpoch = kMoved ? kEpoch : kEpoch - 1;
+    ENSURE(getMoved(kEpoch) == kMoved, "new moved not set when calling setMoved");
 }
 
 bool IVehicle::getStationed() const
@@ -12,13 +12,15 @@
 
 #include <string>
 #include "../TrafficSigns.h"
-#include <deque>
+#include "VehicleTraits.h"
 #include <tuple>
 
 class Road;
 
 class IVehicle
 {
+    friend class SnapshotExporter;
+    friend class SnapshotParser;
 public:
     /**
      * REQUIRE(velocity >= 0, "Velocity must be greater than 0");
@@ -27,13 +29,12 @@ public:
      *
      * ENSURE(this->properlyInitialized(), "Vehicle constructor must end in properlyInitialized state");
      */
-    IVehicle(const std::string& license, double pos, double velocity);
+    IVehicle(const std::string& license, double pos, double velocity, const VehicleConstants& kConstants);
     virtual ~IVehicle();
 
     bool properlyInitialized() const;
 
     virtual double getVehicleLength() const = 0;
-    virtual std::string getType() const = 0;
 
     virtual double getMaxSpeed() const = 0;
     virtual double getMinSpeed() const = 0;
@@ -41,6 +42,23 @@ public:
     virtual double getMaxAcceleration() const = 0;
     virtual double getMinAcceleration() const = 0;
 
+    /*
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getConstants");
+     */
+    const VehicleConstants& getConstants() const;
+
+    /*
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getKind");
+     */
+    EVehicleType getKind() const;
+
+    /*
+     * the name of the type as used in the input and output files
+     *
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getType");
+     */
+    std::string getType() const;
+
     /*
      * REQUIRE(this->properlyInitialized(), "moved vehicle must be properly initialized");
      * REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling move");
@@ -49,16 +67,78 @@ public:
      * ENSURE(getVelocity() >= 0, "Velocity cannot be negative");
      * ENSURE((getAcceleration() >= getMinAcceleration()) && (getAcceleration() <= getMinAcceleration()), "Acceleration is too high / low");
      * ENSURE(nextVehicle.first == NULL or pairPosition<IVehicle>(nextVehicle) - getPosition() > getMinVehicleDist(), "distance between vehicles must be greater than minVehicleDist");
-     * ENSURE(fPrevAcceleration.size() == 5, "Previous acceleration must contain 5 elements");
      */
-    void move(uint32_t kLane, uint32_t kIndex, Road* kRoad);
+    void move(uint32_t kLane, uint32_t kIndex, Road* kRoad, uint32_t kEpoch);
+
+    /*
+     * moves the vehicle using only the state of the previous tick as stored in the lanes, lane changes are only
+     * requested and must be carried out by changeLane once every vehicle has moved.
+     *
+     * REQUIRE(this->properlyInitialized(), "moved vehicle must be properly initialized");
+     * REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling moveBuffered");
+     * REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling moveBuffered");
+     *
+     * ENSURE(getVelocity() >= 0, "Velocity cannot be negative");
+     * ENSURE((getAcceleration() >= getMinAcceleration()) && (getAcceleration() <= getMinAcceleration()), "Acceleration is too high / low");
+     */
+    void moveBuffered(uint32_t kLane, uint32_t kIndex, Road* kRoad, uint32_t kEpoch);
+
+    /*
+     * the first part of moveBuffered: updates the statistics and looks at the traffic signs, returns false if the
+     * vehicle does not move this tick. The speed limit is looked up by the caller, a whole lane at once with
+     * Road::getSpeedLimits or one vehicle with Road::getSpeedLimit
+     *
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling beginMoveBuffered");
+     * REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling beginMoveBuffered");
+     * REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling beginMoveBuffered");
+     */
+    bool beginMoveBuffered(uint32_t kLane, uint32_t kIndex, Road* kRoad, uint32_t kEpoch);
+
+    /*
+     * true if the vehicle is slowing down for a traffic light or a bus stop
+     *
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling isSlowingDown");
+     */
+    bool isSlowingDown() const;
+
+    /*
+     * the second part of moveBuffered: follows the leader as it is stored in the lanes
+     *
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling followBuffered");
+     * REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling followBuffered");
+     * REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling followBuffered");
+     *
+     * ENSURE(getVelocity() >= 0, "Velocity cannot be negative");
+     * ENSURE((getAcceleration() >= getMinAcceleration()) && (getAcceleration() <= getMinAcceleration()), "Acceleration is too high / low");
+     */
+    void followBuffered(uint32_t kLane, uint32_t kIndex, Road* kRoad, double kSpeedlimit);
+
+    /*
+     * the second part of moveBuffered for a vehicle that has been computed by the lane kernel
+     *
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling finishMoveBuffered");
+     * REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling finishMoveBuffered");
+     * REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling finishMoveBuffered");
+     *
+     * ENSURE(getVelocity() >= 0, "Velocity cannot be negative");
+     * ENSURE((getAcceleration() >= getMinAcceleration()) && (getAcceleration() <= getMinAcceleration()), "Acceleration is too high / low");
+     */
+    void finishMoveBuffered(double kAcceleration, double kVelocity, double kPosition, uint32_t kLane, Road* kRoad, double kSpeedlimit);
+
+    /*
+     * carries out the lane change requested by moveBuffered, if there is room for it
+     *
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling changeLane");
+     * REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling changeLane");
+     */
+    void changeLane(uint32_t kLane, uint32_t kIndex, Road* kRoad);
 
     //--------------------------------------------------------------------------------------------------//
 
     /*
      * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getLicensePlate");
      */
-    std::string getLicensePlate()const;
+    const std::string& getLicensePlate() const;
 
     /*
      * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getPosition");
@@ -86,14 +166,35 @@ public:
     double getMinVehicleDist() const;
 
     /*
+     * true if the vehicle can still stop more than getMinVehicleDist() behind a leader at kLeaderPosition when it
+     * brakes as hard as it can, the leader may stop but never drives backwards
+     *
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling canStopBehind");
+     */
+    bool canStopBehind(double kLeaderPosition) const;
+
+    /*
+     * the highest acceleration after which the vehicle can still stop behind its leader at kLeaderPosition, if
+     * kLeader, behind the vehicle in front of it on its other lane while it merges and behind the vehicles that join
+     * the next road before it. Infinite if there are none.
+     *
+     * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getSafeAcceleration");
+     * REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling getSafeAcceleration");
+     */
+    double getSafeAcceleration(bool kLeader, double kLeaderPosition, uint32_t kLane, const Road* kRoad) const;
+
+    /*
+     * a vehicle has moved if it has been updated during kEpoch, the tick its network is in
+     *
      * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getMoved");
      */
-    bool getMoved() const;
+    bool getMoved(uint32_t kEpoch) const;
 
     /*
      * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling setMoved");
+     * ENSURE(getMoved(kEpoch) == kMoved, "new moved not set when calling setMoved");
      */
-    void setMoved(bool kMoved) const;
+    void setMoved(bool kMoved, uint32_t kEpoch) const;
 
     /*
      * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getStationed");
@@ -127,9 +228,9 @@ public:
 private:
     /*
      * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getFollowingAcceleration");
-     * REQUIRE(nextVehicle.second >= 0, "nextVehicle ill-formed when calling getFollowingAcceleration");
+     * REQUIRE(kLeaderLength > 0, "leader must have a length when calling getFollowingAcceleration");
      */
-    double getFollowingAcceleration(std::pair<const IVehicle*, double> nextVehicle) const;
+    double getFollowingAcceleration(double kLeaderPosition, double kLeaderVelocity, double kLeaderLength) const;
 
     /*
      * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getMinMaxAcceleration");
@@ -144,10 +245,12 @@ private:
     void checkTrafficLights(std::pair<const TrafficLight*, double> nextTrafficLight) const;
 
     /*
+     * a bus that stopped for its bus stop stations there, but not past kMaxPosition
+     *
      * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling checkBusStop");
      * REQUIRE(nextBusStop.second >= 0, "nextBusStop ill-formed when calling checkBusStop");
      */
-    void checkBusStop(std::pair<const BusStop*, double> nextBusStop);
+    void checkBusStop(std::pair<const BusStop*, double> nextBusStop, double kMaxPosition);
 
     /*
      * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling checkLaneChange");
@@ -156,6 +259,34 @@ private:
      */
     void checkLaneChange(bool trafficLight, uint32_t lane, uint32_t index, Road* road, bool left, double kSpeedlimit);
 
+    /*
+     * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling requestLaneChanges");
+     * REQUIRE(kRoad->laneExists(kLane), "kLane does not exist when calling requestLaneChanges");
+     */
+    void requestLaneChanges(uint32_t kLane, const Road* kRoad, double kSpeedlimit);
+
+    /*
+     * checks all conditions to change lanes, except for the room on the new lane
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling wantsLaneChange");
+     */
+    bool wantsLaneChange(bool trafficLight, bool left, double kSpeedlimit) const;
+
+    /*
+     * takes the traffic signs and the speed limit into account and updates the velocity and position
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling accelerate");
+     */
+    void accelerate(double acceleration, double kSpeedlimit);
+
+    /*
+     * starts the sign and speed limit searches from the front of kRoad when the vehicle is on a new road or signs were added
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling updateSignCursors");
+     * REQUIRE(kRoad->properlyInitialized(), "road was not initialized when calling updateSignCursors");
+     */
+    void updateSignCursors(const Road* kRoad);
+
     /*
      * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling calculateStop");
      * REQUIRE(nextPos > getPosition(), "cannot stop behind current pos when calling calculate stop");
@@ -167,29 +298,56 @@ private:
      */
     void updateStatistics();
 
+    /*
+     * the distance the vehicle covers from velocity until it stands still when it brakes as hard as it can
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getBrakingDistance");
+     */
+    double getBrakingDistance(double velocity) const;
+
+    /*
+     * the highest acceleration after which canStopBehind(kLeaderPosition) still holds. If it holds now, braking as
+     * hard as possible keeps it true, so a vehicle that keeps to this never comes too close to its leader
+     *
+     * REQUIRE(properlyInitialized(), "Vehicle was not initialized when calling getStoppingAcceleration");
+     */
+    double getStoppingAcceleration(double kLeaderPosition) const;
+
 protected:
     IVehicle* _initCheck;
 
     std::string fLicensePlate;
 
-    mutable bool fMoved;
+    mutable uint32_t fMovedEpoch;   // the last epoch in which the vehicle has moved
     mutable bool fStationed;
     mutable bool fMerging;
+    uint8_t fLaneChanges;   // the lane changes requested by moveBuffered
 
     double fPosition;
     double fVelocity;
     double fAcceleration;
 
-    std::deque<double> fPrevAcceleration;
+    const VehicleConstants* fConstants;
+
+    double fPrevAcceleration[5];
+    uint32_t fPrevIndex;
 
     mutable std::tuple<bool, double, const TrafficLight*> fTrafficLightAccel;
     mutable std::tuple<bool, double, const BusStop*> fBusStopAccel;
 
+    const Road* fSignRoad;          // the road of the sign cursors
+    uint32_t fSignVersion;          // the sign version of that road when the cursors were last reset
+    uint32_t fTrafficLightIndex;    // index of the next traffic light on that road
+    uint32_t fBusStopIndex;         // index of the next bus stop on that road
+    uint32_t fZoneIndex;            // index of the current part of the speed profile of that road
+
     uint32_t fTimer;
     uint32_t fDriveTimer;
     double fDistance;
     double fMaxVelocity;
 
+    enum ELaneChange {kChangeLeft = 1, kChangeRight = 2};
+
     static const double fgkMinVehicleDist;
     static const double fgkEpsilonThreshold;
 };
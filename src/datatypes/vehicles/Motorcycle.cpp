@@ -10,15 +10,17 @@
 #include "Motorcycle.h"
 #include "../../DesignByContract.h"
 
-const double Motorcycle::fgkMaxAcceleration = 4.0;
-const double Motorcycle::fgkMinAcceleration = -10.0;
+const double Motorcycle::fgkMaxAcceleration = VehicleTraits<kMotorcycle>::fgkMaxAcceleration;
+const double Motorcycle::fgkMinAcceleration = VehicleTraits<kMotorcycle>::fgkMinAcceleration;
 
-const double Motorcycle::fgkMinSpeed = 0.0;
-const double Motorcycle::fgkMaxSpeed = 180.0 / 3.6;
+const double Motorcycle::fgkMinSpeed = VehicleTraits<kMotorcycle>::fgkMinSpeed;
+const double Motorcycle::fgkMaxSpeed = VehicleTraits<kMotorcycle>::fgkMaxSpeed;
 
-const double Motorcycle::fgkVehicleLength = 1;
+const double Motorcycle::fgkVehicleLength = VehicleTraits<kMotorcycle>::fgkVehicleLength;
 
-Motorcycle::Motorcycle(const std::string& license, double position, double velocity) : IVehicle(license, position, velocity){}
+const VehicleConstants Motorcycle::fgkConstants = makeVehicleConstants<kMotorcycle>();
+
+Motorcycle::Motorcycle(const std::string& license, double position, double velocity) : IVehicle(license, position, velocity, fgkConstants){}
 
 double Motorcycle::getVehicleLength() const
 {
@@ -26,12 +28,6 @@ double Motorcycle::getVehicleLength() const
     return fgkVehicleLength;
 }
 
-std::string Motorcycle::getType() const
-{
-    REQUIRE(this->properlyInitialized(), "Motorcycle was not initialized when calling getType");
-    return "motorfiets";
-}
-
 double Motorcycle::getMaxSpeed() const
 {
     REQUIRE(this->properlyInitialized(), "Motorcycle was not initialized when calling getMaxSpeed");
@@ -13,8 +13,9 @@
 
 
 #include "IVehicle.h"
+#include "../Allocator.h"
 
-class Motorcycle : public IVehicle
+class Motorcycle : public IVehicle, public PoolAllocated<Motorcycle>
 {
 public:
     /**
@@ -31,11 +32,6 @@ public:
     */
     virtual double getVehicleLength() const;
 
-    /**
-    * REQUIRE(this->properlyInitialized(), "Motorcycle was not initialized when calling getType");
-    */
-    virtual std::string getType() const;
-
     /**
     * REQUIRE(this->properlyInitialized(), "Motorcycle was not initialized when calling getMaxSpeed");
     */
@@ -64,6 +60,8 @@ protected:
     static const double fgkMaxSpeed;
 
     static const double fgkVehicleLength;
+
+    static const VehicleConstants fgkConstants;
 };
 
 
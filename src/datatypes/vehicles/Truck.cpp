@@ -10,15 +10,17 @@
 #include "Truck.h"
 #include "../../DesignByContract.h"
 
-const double Truck::fgkMaxAcceleration = 1.0;
-const double Truck::fgkMinAcceleration = -6.0;
+const double Truck::fgkMaxAcceleration = VehicleTraits<kTruck>::fgkMaxAcceleration;
+const double Truck::fgkMinAcceleration = VehicleTraits<kTruck>::fgkMinAcceleration;
 
-const double Truck::fgkMinSpeed = 0.0;
-const double Truck::fgkMaxSpeed = 90.0 / 3.6;
+const double Truck::fgkMinSpeed = VehicleTraits<kTruck>::fgkMinSpeed;
+const double Truck::fgkMaxSpeed = VehicleTraits<kTruck>::fgkMaxSpeed;
 
-const double Truck::fgkVehicleLength = 15;
+const double Truck::fgkVehicleLength = VehicleTraits<kTruck>::fgkVehicleLength;
 
-Truck::Truck(const std::string& license, double position, double velocity) : IVehicle(license, position, velocity){}
+const VehicleConstants Truck::fgkConstants = makeVehicleConstants<kTruck>();
+
+Truck::Truck(const std::string& license, double position, double velocity) : IVehicle(license, position, velocity, fgkConstants){}
 
 double Truck::getVehicleLength() const
 {
@@ -26,12 +28,6 @@ double Truck::getVehicleLength() const
     return fgkVehicleLength;
 }
 
-std::string Truck::getType() const
-{
-    REQUIRE(this->properlyInitialized(), "Truck was not initialized when calling getType");
-    return "vrachtwagen";
-}
-
 double Truck::getMaxSpeed() const
 {
     REQUIRE(this->properlyInitialized(), "Truck was not initialized when calling getMaxSpeed");
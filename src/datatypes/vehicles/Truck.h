@@ -11,8 +11,9 @@
 #define SIMULATION_TRUCK_H
 
 #include "IVehicle.h"
+#include "../Allocator.h"
 
-class Truck : public IVehicle
+class Truck : public IVehicle, public PoolAllocated<Truck>
 {
 public:
     /**
@@ -29,11 +30,6 @@ public:
     */
     virtual double getVehicleLength() const;
 
-    /**
-    * REQUIRE(this->properlyInitialized(), "Vehicle was not initialized when calling getType");
-    */
-    virtual std::string getType() const;
-
     /**
     * REQUIRE(this->properlyInitialized(), "Truck was not initialized when calling getMaxSpeed");
     */
@@ -62,6 +58,8 @@ protected:
     static const double fgkMaxSpeed;
 
     static const double fgkVehicleLength;
+
+    static const VehicleConstants fgkConstants;
 };
 
 
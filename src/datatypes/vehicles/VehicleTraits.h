@@ -0,0 +1,96 @@
+//============================================================================
+// @name        : VehicleTraits.h
+// @author      : Thomas Dooms
+// @date        : 5/22/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : the kinds of vehicles and their constants, known at compile time
+//============================================================================
+
+#ifndef SIMULATION_VEHICLETRAITS_H
+#define SIMULATION_VEHICLETRAITS_H
+
+enum EVehicleType {kCar, kBus, kMotorcycle, kTruck};
+
+template<EVehicleType T>
+struct VehicleTraits;
+
+template<>
+struct VehicleTraits<kCar>
+{
+    static constexpr const char* fgkName = "auto";
+    static constexpr double fgkMaxAcceleration = 2.0;
+    static constexpr double fgkMinAcceleration = -8.0;
+    static constexpr double fgkMinSpeed = 0.0;
+    static constexpr double fgkMaxSpeed = 150.0 / 3.6;
+    static constexpr double fgkVehicleLength = 3;
+    static constexpr bool fgkCanChangeLane = true;
+    static constexpr bool fgkUsesBusStops = false;
+};
+
+template<>
+struct VehicleTraits<kBus>
+{
+    static constexpr const char* fgkName = "bus";
+    static constexpr double fgkMaxAcceleration = 1.0;
+    static constexpr double fgkMinAcceleration = -7.0;
+    static constexpr double fgkMinSpeed = 0.0;
+    static constexpr double fgkMaxSpeed = 70.0 / 3.6;
+    static constexpr double fgkVehicleLength = 10;
+    static constexpr bool fgkCanChangeLane = false;
+    static constexpr bool fgkUsesBusStops = true;
+};
+
+template<>
+struct VehicleTraits<kMotorcycle>
+{
+    static constexpr const char* fgkName = "motorfiets";
+    static constexpr double fgkMaxAcceleration = 4.0;
+    static constexpr double fgkMinAcceleration = -10.0;
+    static constexpr double fgkMinSpeed = 0.0;
+    static constexpr double fgkMaxSpeed = 180.0 / 3.6;
+    static constexpr double fgkVehicleLength = 1;
+    static constexpr bool fgkCanChangeLane = true;
+    static constexpr bool fgkUsesBusStops = false;
+};
+
+template<>
+struct VehicleTraits<kTruck>
+{
+    static constexpr const char* fgkName = "vrachtwagen";
+    static constexpr double fgkMaxAcceleration = 1.0;
+    static constexpr double fgkMinAcceleration = -6.0;
+    static constexpr double fgkMinSpeed = 0.0;
+    static constexpr double fgkMaxSpeed = 90.0 / 3.6;
+    static constexpr double fgkVehicleLength = 15;
+    static constexpr bool fgkCanChangeLane = false;
+    static constexpr bool fgkUsesBusStops = false;
+};
+
+/**
+ * the constants of a vehicle type, every type has one static instance that all its vehicles point to
+ */
+struct VehicleConstants
+{
+    EVehicleType fType;
+    const char* fName;
+    double fLength;
+    double fMinSpeed;
+    double fMaxSpeed;
+    double fMinAcceleration;
+    double fMaxAcceleration;
+    bool fCanChangeLane;
+    bool fUsesBusStops;
+};
+
+template<EVehicleType T>
+constexpr VehicleConstants makeVehicleConstants()
+{
+    return VehicleConstants{T, VehicleTraits<T>::fgkName, VehicleTraits<T>::fgkVehicleLength,
+                            VehicleTraits<T>::fgkMinSpeed, VehicleTraits<T>::fgkMaxSpeed,
+                            VehicleTraits<T>::fgkMinAcceleration, VehicleTraits<T>::fgkMaxAcceleration,
+                            VehicleTraits<T>::fgkCanChangeLane, VehicleTraits<T>::fgkUsesBusStops};
+}
+
+
+#endif //SIMULATION_VEHICLETRAITS_H
@@ -0,0 +1,124 @@
+//============================================================================
+// @name        : ExportPipeline.cpp
+// @author      : Thomas Dooms
+// @date        : 5/27/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : formats and writes the outputs of the exporters on background threads
+//============================================================================
+
+#include "ExportPipeline.h"
+#include "../DesignByContract.h"
+
+const uint64_t ExportPipeline::fgkDefaultCapacity = 64 << 20;
+
+std::vector<std::thread> ExportPipeline::fgWriters;
+std::mutex ExportPipeline::fgMutex;
+std::condition_variable ExportPipeline::fgQueued;
+std::condition_variable ExportPipeline::fgWritten;
+std::deque<std::pair<uint64_t, IExportJob*> > ExportPipeline::fgQueue;
+uint64_t ExportPipeline::fgPushed = 0;
+uint64_t ExportPipeline::fgNextWrite = 0;
+uint64_t ExportPipeline::fgWaiting = 0;
+uint64_t ExportPipeline::fgCapacity = fgkDefaultCapacity;
+bool ExportPipeline::fgStop = false;
+
+namespace
+{
+    // the writers must be joined before the program exits, also when stop is never called
+    struct StopAtExit
+    {
+        ~StopAtExit() { ExportPipeline::stop(); }
+    };
+    StopAtExit stopAtExit;
+}
+
+void ExportPipeline::start(const uint32_t kWriters, const uint64_t kCapacity)
+{
+    REQUIRE(kCapacity > 0, "The pipeline needs room for at least one job");
+    stop();
+
+    fgCapacity = kCapacity;
+    fgStop = false;
+    for(uint32_t i = 0; i < kWriters; i++) fgWriters.push_back(std::thread(&ExportPipeline::work));
+
+    ENSURE(getWriters() == kWriters, "Writers not started when calling start");
+}
+
+void ExportPipeline::stop()
+{
+    if(fgWriters.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(fgMutex);
+        fgStop = true;
+    }
+    fgQueued.notify_all();
+    for(uint32_t i = 0; i < fgWriters.size(); i++) fgWriters[i].join();
+    fgWriters.clear();
+}
+
+uint32_t ExportPipeline::getWriters()
+{
+    return fgWriters.size();
+}
+
+void ExportPipeline::push(IExportJob* const kJob)
+{
+    REQUIRE(kJob != NULL, "Cannot push an empty job");
+    if(fgWriters.empty())
+    {
+        kJob->format();
+        kJob->write();
+        delete kJob;
+        return;
+    }
+
+    const uint64_t kSize = kJob->getSize();
+    {
+        // a job that is bigger than the whole queue is accepted once the queue is empty
+        std::unique_lock<std::mutex> lock(fgMutex);
+        while(fgWaiting != 0 and fgWaiting + kSize > fgCapacity) fgWritten.wait(lock);
+        fgWaiting += kSize;
+        fgQueue.push_back(std::pair<uint64_t, IExportJob*>(fgPushed++, kJob));
+    }
+    fgQueued.notify_one();
+}
+
+void ExportPipeline::flush()
+{
+    std::unique_lock<std::mutex> lock(fgMutex);
+    while(fgNextWrite != fgPushed) fgWritten.wait(lock);
+}
+
+void ExportPipeline::work()
+{
+    while(true)
+    {
+        std::pair<uint64_t, IExportJob*> job;
+        {
+            std::unique_lock<std::mutex> lock(fgMutex);
+            while(fgQueue.empty() and not fgStop) fgQueued.wait(lock);
+            if(fgQueue.empty()) return;
+            job = fgQueue.front();
+            fgQueue.pop_front();
+        }
+
+        const uint64_t kSize = job.second->getSize();
+        job.second->format();
+        {
+            std::unique_lock<std::mutex> lock(fgMutex);
+            while(fgNextWrite != job.first) fgWritten.wait(lock);
+        }
+
+        // only the writer of the next job gets here, the others wait for their turn
+        job.second->write();
+        delete job.second;
+
+        {
+            std::lock_guard<std::mutex> lock(fgMutex);
+            fgNextWrite++;
+            fgWaiting -= kSize;
+        }
+        fgWritten.notify_all();
+    }
+}
@@ -0,0 +1,96 @@
+//============================================================================
+// @name        : ExportPipeline.h
+// @author      : Thomas Dooms
+// @date        : 5/27/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : formats and writes the outputs of the exporters on background threads
+//============================================================================
+
+#ifndef SIMULATION_EXPORTPIPELINE_H
+#define SIMULATION_EXPORTPIPELINE_H
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * A piece of output, it holds a copy of everything it needs so the simulation can continue while it is written.
+ * format may run on any writer thread at the same time as other jobs, write is called in the order the jobs
+ * were pushed and never at the same time as another write.
+ */
+class IExportJob
+{
+public:
+    virtual ~IExportJob() {}
+
+    virtual void format() = 0;
+
+    virtual void write() = 0;
+
+    /**
+     * the amount of memory the copied state holds, it must not change after the job is pushed.
+     * The pipeline stops accepting jobs when too much is waiting.
+     */
+    virtual uint64_t getSize() const = 0;
+};
+
+/**
+ * Without writer threads every job is formatted and written right away on the thread that pushes it.
+ * With writer threads the jobs are queued, a full queue blocks the simulation until the writers have caught up.
+ */
+class ExportPipeline
+{
+public:
+    /**
+     * starts kWriters writer threads, at most kCapacity bytes of jobs wait in the queue. 0 writers stops the pipeline
+     *
+     * REQUIRE(kCapacity > 0, "The pipeline needs room for at least one job");
+     * ENSURE(getWriters() == kWriters, "Writers not started when calling start");
+     */
+    static void start(uint32_t kWriters, uint64_t kCapacity = fgkDefaultCapacity);
+
+    /**
+     * writes all jobs that are still queued and stops the writer threads
+     */
+    static void stop();
+
+    static uint32_t getWriters();
+
+    /**
+     * the pipeline takes ownership of kJob
+     *
+     * REQUIRE(kJob != NULL, "Cannot push an empty job");
+     */
+    static void push(IExportJob* kJob);
+
+    /**
+     * waits until every job that has been pushed is written
+     */
+    static void flush();
+
+    static const uint64_t fgkDefaultCapacity;
+
+private:
+    /**
+     * the main loop of the writer threads
+     */
+    static void work();
+
+    static std::vector<std::thread> fgWriters;
+    static std::mutex fgMutex;
+    static std::condition_variable fgQueued;      // a job was pushed or the writers must stop
+    static std::condition_variable fgWritten;     // a job was written
+    static std::deque<std::pair<uint64_t, IExportJob*> > fgQueue;
+    static uint64_t fgPushed;                       // sequence number of the next job that is pushed
+    static uint64_t fgNextWrite;                    // sequence number of the next job that is written
+    static uint64_t fgWaiting;                      // bytes of the jobs that are pushed but not written yet
+    static uint64_t fgCapacity;
+    static bool fgStop;
+};
+
+
+#endif //SIMULATION_EXPORTPIPELINE_H
@@ -10,6 +10,7 @@
 //============================================================================
 
 #include "NetworkExporter.h"
+#include "ExportPipeline.h"
 #include "../DesignByContract.h"
 #include <stdlib.h>
 #include <math.h>
@@ -17,6 +18,12 @@
 #include <iomanip>
 #include <cfloat>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+
+using cg::Color;
+using cg::Pos;
+using cg::Object;
 
 typedef Object object;
 std::ofstream NetworkExporter::fgSimple;
@@ -27,18 +34,27 @@ std::stringstream NetworkExporter::fgBuf;
 double NetworkExporter::fgScale = 0;
 uint32_t NetworkExporter::fgLongestName = 0;
 
+std::shared_ptr<const cg::Scene> NetworkExporter::fgRoads;
+std::vector<uint32_t> NetworkExporter::fgLayout;
+
 bool NetworkExporter::_initCheck = false;
 
 void
-NetworkExporter::init(const Network *kNetwork, const std::string &kSimplePath, const std::string &kImpressionPath) {
+NetworkExporter::init(const Network *kNetwork, const std::string &kSimplePath, const std::string &kImpressionPath,
+                      const std::pair<uint64_t, uint64_t> &kResume) {
     REQUIRE(kNetwork, "Failed to export network: no network");
     int res = system("mkdir outputfiles >/dev/null 2>&1");
     ENSURE(res == 0 or res == 256, "Failed to create output directory");
 
-    fgSimple.open(("outputfiles/" + kSimplePath + ".txt").c_str());
+    // both outputs are continued or both are started anew
+    bool continued = OpenOutput(fgSimple, "outputfiles/" + kSimplePath + ".txt", kResume.first);
+    continued = OpenOutput(fgImpression, "outputfiles/" + kImpressionPath + ".txt", continued ? kResume.second : 0) and continued;
+    if (not continued and kResume.first > 0) {
+        fgSimple.close();
+        OpenOutput(fgSimple, "outputfiles/" + kSimplePath + ".txt", 0);
+    }
+    const bool kContinued = continued;
     ENSURE(fgSimple.is_open(), "Failed to load file for simple output");
-
-    fgImpression.open(("outputfiles/" + kImpressionPath + ".txt").c_str());
     ENSURE(fgImpression.is_open(), "Failed to load File for impression output");
 
     _initCheck = true;
@@ -46,6 +62,9 @@ NetworkExporter::init(const Network *kNetwork, const std::string &kSimplePath, c
     double maxLength = 0;
     for (uint32_t i = 0; i < kNetwork->fRoads.size(); i++) {
         Road *road = kNetwork->fRoads[i];
+        if (road->getRoadLength() > maxLength) maxLength = road->getRoadLength();
+        if (road->getName().size() > fgLongestName) fgLongestName = road->getName().size();
+        if (kContinued) continue;    // the description of the roads is already in the outputs
 
         tee("Baan : " + road->getName() + '\n', true);
         tee("  -> Snelheidslimiet: " + std::to_string(int(std::round(road->getSpeedLimit() * 3.6))) + "km/u\n", true);
@@ -65,11 +84,9 @@ NetworkExporter::init(const Network *kNetwork, const std::string &kSimplePath, c
             tee("  -> Verkeerslicht  : Positie: " + std::to_string(int(std::round(trafficLight->getPosition()))) +
                 "m\n", true);
         }
-
-        if (road->getRoadLength() > maxLength) maxLength = road->getRoadLength();
-        if (road->getName().size() > fgLongestName) fgLongestName = road->getName().size();
     }
     fgScale = maxLength / 120;
+    if (kContinued) return;
     tee("\n", true);
     tee("-------------------------------------------------\nOne character is " + std::to_string(fgScale) + " meters\n",
         false);
@@ -77,59 +94,133 @@ NetworkExporter::init(const Network *kNetwork, const std::string &kSimplePath, c
 
 void NetworkExporter::finish() {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling finish");
+    ExportPipeline::flush();
     fgImpression << std::flush;
     fgSimple << std::flush;
     fgImpression.close();
     fgSimple.close();
     fgScale = 0;
     fgLongestName = 0;
+    fgRoads.reset();
+    fgLayout.clear();
     _initCheck = false;
 }
 
-std::string NetworkExporter::addSection(const Network *kNetwork, uint32_t number) {
-    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling addSection");
-    REQUIRE(kNetwork, "Failed to add section: no network");
-    fgSimple << "-------------------------------------------------\n";
-    if (number != 1) fgSimple << "State of the network after " << number << " ticks have passed:\n\n";
-    else fgSimple << "State of the network after " << number << " tick has passed:\n\n";
-    for (uint32_t i = 0; i < kNetwork->fRoads.size(); i++) {
-        const Road *road = kNetwork->fRoads[i];
-        for (uint32_t j = 0; j < road->getNumLanes(); j++) {
-            for (uint32_t k = 0; k < (*road)[j].size(); k++) {
-                const IVehicle *vehicle = (*road)[j][k];
-                fgSimple << "Voertuig: " + vehicle->getType() + '(' + vehicle->getLicensePlate() + ")\n";
-                fgSimple << "  -> Baan    : " << road->getName() << '\n';
-                fgSimple << "  -> Positie : " << vehicle->getPosition() << '\n';
-                fgSimple << "  -> Snelheid: " << vehicle->getVelocity() * 3.6 << '\n';
+std::pair<uint64_t, uint64_t> NetworkExporter::getSizes() {
+    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling getSizes");
+    ExportPipeline::flush();
+    fgSimple << std::flush;
+    fgImpression << std::flush;
+    return std::pair<uint64_t, uint64_t>(fgSimple.tellp(), fgImpression.tellp());
+}
+
+// the state of the network after a tick, formatted and written by the export pipeline
+class NetworkExporter::SectionJob : public IExportJob {
+public:
+    SectionJob(const Network *kNetwork, uint32_t number) : fNumber(number), fScale(fgScale), fLongestName(fgLongestName) {
+        for (uint32_t i = 0; i < kNetwork->fRoads.size(); i++) {
+            const Road *road = kNetwork->fRoads[i];
+            fRoads.push_back(RoadState(road->getName(), road->getRoadLength()));
+            for (uint32_t j = 0; j < road->getNumLanes(); j++) {
+                const Lane &kLane = (*road)[j];
+                for (uint32_t k = 0; k < kLane.size(); k++) {
+                    const IVehicle *vehicle = kLane[k];
+                    const VehicleState kState = {vehicle->getConstants().fName, vehicle->getLicensePlate(),
+                                                 vehicle->getPosition(), vehicle->getVelocity()};
+                    fVehicles.push_back(kState);
+                }
+                fRoads.back().fLanes.push_back(fVehicles.size());
             }
         }
     }
-    fgSimple << '\n';
-
-    fgBuf.str("");
 
-    tee("-------------------------------------------------\n", false);
-    if (number != 1) tee("State of the network after " + std::to_string(number) + " ticks have passed:\n\n", false);
-    else tee("State of the network after " + std::to_string(number) + " tick has passed:\n\n", false);
-    for (uint32_t i = 0; i < kNetwork->fRoads.size(); i++) {
-        const Road *road = kNetwork->fRoads[i];
-        tee(road->getName() + whitespace(fgLongestName - road->getName().size()) + " | ", false);
-        for (uint32_t j = 0; j < road->getNumLanes(); j++) {
-            std::vector<std::vector<char> > lane;
-            uint32_t max = 1;
-            lane.resize(static_cast<uint32_t >(ceil(road->getRoadLength() / fgScale)));
-            for (uint32_t k = 0; k < (*road)[j].size(); k++) {
-                const IVehicle *vehicle = (*road)[j][k];
-                uint32_t pos = static_cast<uint32_t >(floor(vehicle->getPosition() / fgScale));
-                lane[pos].push_back(toupper(vehicle->getType()[0]));
-                if (lane[pos].size() > max) max = lane[pos].size();
+    virtual void format() {
+        std::ostringstream simple;
+        simple << "-------------------------------------------------\n";
+        if (fNumber != 1) simple << "State of the network after " << fNumber << " ticks have passed:\n\n";
+        else simple << "State of the network after " << fNumber << " tick has passed:\n\n";
+        uint32_t vehicle = 0;
+        for (uint32_t i = 0; i < fRoads.size(); i++) {
+            for (; vehicle < fRoads[i].fLanes.back(); vehicle++) {
+                const VehicleState &kVehicle = fVehicles[vehicle];
+                simple << "Voertuig: " << kVehicle.fType << '(' << kVehicle.fLicensePlate << ")\n";
+                simple << "  -> Baan    : " << fRoads[i].fName << '\n';
+                simple << "  -> Positie : " << kVehicle.fPosition << '\n';
+                simple << "  -> Snelheid: " << kVehicle.fVelocity * 3.6 << '\n';
             }
-            printLane(lane, max, j);
         }
+        simple << '\n';
+        fSimple = simple.str();
+
+        fImpression = "-------------------------------------------------\n";
+        if (fNumber != 1) fImpression += "State of the network after " + std::to_string(fNumber) + " ticks have passed:\n\n";
+        else fImpression += "State of the network after " + std::to_string(fNumber) + " tick has passed:\n\n";
+        vehicle = 0;
+        for (uint32_t i = 0; i < fRoads.size(); i++) {
+            const RoadState &kRoad = fRoads[i];
+            fImpression += kRoad.fName + whitespace(fLongestName - kRoad.fName.size()) + " | ";
+            for (uint32_t j = 0; j < kRoad.fLanes.size(); j++) {
+                std::vector<std::vector<char> > lane;
+                uint32_t max = 1;
+                lane.resize(static_cast<uint32_t >(ceil(kRoad.fLength / fScale)));
+                for (; vehicle < kRoad.fLanes[j]; vehicle++) {
+                    const VehicleState &kVehicle = fVehicles[vehicle];
+                    // rounding can put a vehicle at the very end of the road one character too far
+                    uint32_t pos = std::min<uint32_t>(floor(kVehicle.fPosition / fScale), lane.size() - 1);
+                    lane[pos].push_back(toupper(kVehicle.fType[0]));
+                    if (lane[pos].size() > max) max = lane[pos].size();
+                }
+                formatLane(fImpression, lane, max, j, fLongestName);
+            }
+        }
+        fImpression += "\n";
+    }
+
+    virtual void write() {
+        fgSimple << fSimple;
+        fgImpression << fImpression;
+        std::cout << fImpression;
+        fgBuf.str("");
+        fgBuf << fImpression;
+    }
+
+    virtual uint64_t getSize() const {
+        uint64_t size = sizeof(*this) + fVehicles.size() * sizeof(VehicleState);
+        for (uint32_t i = 0; i < fRoads.size(); i++) size += sizeof(RoadState) + fRoads[i].fLanes.size() * sizeof(uint32_t);
+        return size;
     }
-    tee("\n", false);
 
-    return fgBuf.str();
+private:
+    struct RoadState {
+        RoadState(const std::string &kName, double length) : fName(kName), fLength(length) {}
+
+        std::string fName;
+        double fLength;
+        std::vector<uint32_t> fLanes;   // the end of every lane in fVehicles
+    };
+
+    struct VehicleState {
+        const char *fType;
+        std::string fLicensePlate;
+        double fPosition;
+        double fVelocity;
+    };
+
+    const uint32_t fNumber;
+    const double fScale;
+    const uint32_t fLongestName;
+    std::vector<RoadState> fRoads;
+    std::vector<VehicleState> fVehicles;
+
+    std::string fSimple;
+    std::string fImpression;
+};
+
+std::string NetworkExporter::addSection(const Network *kNetwork, uint32_t number) {
+    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling addSection");
+    REQUIRE(kNetwork, "Failed to add section: no network");
+    ExportPipeline::push(new SectionJob(kNetwork, number));
+    return ExportPipeline::getWriters() == 0 ? fgBuf.str() : "";
 }
 
 std::string NetworkExporter::whitespace(const int amount) {
@@ -143,14 +234,21 @@ std::string NetworkExporter::whitespace(const int amount) {
 void
 NetworkExporter::printLane(const std::vector<std::vector<char>> &lane, const uint32_t max, const uint32_t laneNum) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling printLane");
+    std::string out;
+    formatLane(out, lane, max, laneNum, fgLongestName);
+    tee(out, false);
+}
+
+void NetworkExporter::formatLane(std::string &out, const std::vector<std::vector<char>> &lane, const uint32_t max,
+                                 const uint32_t laneNum, const uint32_t longestName) {
     for (uint32_t l = 0; l < max; ++l) {
-        if (!(laneNum == 0 && l == 0)) tee(whitespace(fgLongestName + 3), false);
-        if (l == 0) tee(std::to_string(laneNum + 1) + " ", false);
-        else tee(whitespace(1 + std::to_string(laneNum + 1).size()), false);
+        if (!(laneNum == 0 && l == 0)) out += whitespace(longestName + 3);
+        if (l == 0) out += std::to_string(laneNum + 1) + " ";
+        else out += whitespace(1 + std::to_string(laneNum + 1).size());
         for (uint32_t k = 0; k < lane.size(); ++k) {
-            tee((l < lane[k].size() ? lane[k][l] : (l == 0 ? '=' : ' ')), false);
+            out += (l < lane[k].size() ? lane[k][l] : (l == 0 ? '=' : ' '));
         }
-        tee('\n', false);
+        out += '\n';
     }
 }
 
@@ -158,69 +256,136 @@ bool NetworkExporter::properlyInitialized() {
     return _initCheck;
 }
 
+namespace {
+    cg::Material material(const Color &kAmbient, const Color &kDiffuse, const Color &kSpecular, double kCoefficient) {
+        const cg::Material kMaterial = {{kAmbient.fR, kAmbient.fG, kAmbient.fB},
+                                        {kDiffuse.fR, kDiffuse.fG, kDiffuse.fB},
+                                        {kSpecular.fR, kSpecular.fG, kSpecular.fB}, kCoefficient};
+        return kMaterial;
+    }
+}
+
+// a frame of the cg export, rendered and written by the export pipeline
+class NetworkExporter::RenderJob : public IExportJob {
+public:
+    RenderJob(const std::shared_ptr<const cg::Scene> &kRoads, cg::Scene *vehicles, const std::string &kFilename)
+            : fRoads(kRoads), fVehicles(vehicles), fFilename(kFilename), fRendered(false) {}
+
+    virtual void format() {
+        std::vector<const cg::Scene *> scenes;
+        scenes.push_back(fRoads.get());
+        scenes.push_back(fVehicles.get());
+        fRendered = cg::render(scenes, fImage);
+        fRoads.reset();
+        fVehicles.reset();
+    }
+
+    virtual void write() {
+        if (not fRendered) return;
+        const bool kWritten = cg::writeBmp(fImage, fFilename);
+        ENSURE(kWritten, "Failed to write the cg image");
+    }
+
+    virtual uint64_t getSize() const {
+        // the scenes are small next to the image they become
+        return sizeof(*this) + 3 * uint64_t(fgkView.size) * fgkView.size;
+    }
+
+private:
+    std::shared_ptr<const cg::Scene> fRoads;    // shared with the exporter and the other frames
+    std::unique_ptr<cg::Scene> fVehicles;
+    const std::string fFilename;
+    cg::Image fImage;
+    bool fRendered;
+};
+
+const cg::View NetworkExporter::fgkView = {2024, {0.05, 0.06, 0.05}, {0, 50, 100},
+                                           std::vector<cg::Light>(1, {{0.4, 0.4, 0.4}, {1, 1, 1}, {1, 1, 1},
+                                                                      {-3, -1, -10}})};
+
 void NetworkExporter::cgExport(const Network *kNetwork, const unsigned int kTick) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling cgExport");
     REQUIRE(kNetwork, "Failed to export to cg: no network");
-    REQUIRE(FileExists("engine/engine"), "Failed to export to cg engine: engine not found");
 
     int res = system("mkdir outputfiles >/dev/null 2>&1");
     ENSURE(res == 0 or res == 256, "Failed to create output directory");
 
-    std::string filename = "outputfiles/cg.ini";
-    if (kTick > 0) filename = "outputfiles/tick" + std::to_string(kTick) + ".ini";
-    std::ofstream ini(filename);
-    ENSURE(ini.is_open(), "Failed to open file for cg export");
+    std::string filename = "outputfiles/cg.bmp";
+    if (kTick > 0) filename = "outputfiles/tick" + std::to_string(kTick) + ".bmp";
 
-    ini << std::fixed;
-    ini << std::setprecision(2);
+    std::shared_ptr<const cg::Scene> roads;
+    cg::Scene *vehicles = cgScene(kNetwork, roads);
+    ExportPipeline::push(new RenderJob(roads, vehicles, filename));
+    // cg.bmp is shown right after the export, only the numbered frames are written in the background
+    if (kTick == 0) ExportPipeline::flush();
+}
 
-    double y = 0;
-    int nr = 0;
+cg::Scene *NetworkExporter::cgScene(const Network *kNetwork, std::shared_ptr<const cg::Scene> &roadScene) {
+    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling cgScene");
+    REQUIRE(kNetwork, "Failed to draw the network: no network");
 
+    // vehicles that overlap are drawn next to each other, which widens their lane
+    std::vector<uint32_t> layout;   // the amount of rows of every lane
+    std::vector<uint32_t> rows;     // the row of every vehicle
     for (uint32_t i = 0; i < kNetwork->fRoads.size(); i++) {
         const Road *road = kNetwork->fRoads[i];
         for (uint32_t j = 0; j < road->getNumLanes(); j++) {
             uint32_t max = 1;
-            double roadLength = road->getRoadLength() / fgScale;
             double prevPosition = DBL_MAX;
             for (uint32_t k = 0; k < (*road)[j].size(); k++) {
                 const IVehicle *vehicle = (*road)[j][k];
                 double position = vehicle->getPosition() / fgScale;
-                char type = vehicle->getType()[0];
-                double length = vehicle->getVehicleLength();
                 if (position >= prevPosition) {
                     max++;
                 }
-                switch (type) {
-                    case 'a':
-                        car(ini, nr, {-position, y + (max - 1) * 2, 0.25}, true);
+                rows.push_back(max - 1);
+                prevPosition = position - vehicle->getConstants().fLength;
+            }
+            layout.push_back(max);
+        }
+    }
+
+    // the roads and their signs only change with the layout, the frames in between share them
+    if (not fgRoads or layout != fgLayout) {
+        cg::Scene *scene = new cg::Scene(fgkView);
+        roads(*scene, kNetwork, layout);
+        fgRoads.reset(scene);
+        fgLayout = layout;
+    }
+
+    cg::Scene *scene = new cg::Scene(fgkView);
+    double y = 0;
+    uint32_t index = 0;     // of the lane in the layout
+    uint32_t row = 0;
+    for (uint32_t i = 0; i < kNetwork->fRoads.size(); i++) {
+        const Road *road = kNetwork->fRoads[i];
+        for (uint32_t j = 0; j < road->getNumLanes(); j++, index++) {
+            for (uint32_t k = 0; k < (*road)[j].size(); k++, row++) {
+                const IVehicle *vehicle = (*road)[j][k];
+                double position = vehicle->getPosition() / fgScale;
+                switch (vehicle->getKind()) {
+                    case kCar:
+                        car(*scene, {-position, y + rows[row] * 2, 0.25}, true);
                         break;
-                    case 'b':
-                        bus(ini, nr, {-position, y + (max - 1) * 2, 0.25});
+                    case kBus:
+                        bus(*scene, {-position, y + rows[row] * 2, 0.25});
                         break;
-                    case 'v':
-                        truck(ini, nr, {-position, y + (max - 1) * 2, 0.25});
+                    case kTruck:
+                        truck(*scene, {-position, y + rows[row] * 2, 0.25});
                         break;
-                    case 'm':
-                        motorcycle(ini, nr, {-position, (y + (max - 1) * 2) + 0.5, 0.25});
+                    case kMotorcycle:
+                        motorcycle(*scene, {-position, (y + rows[row] * 2) + 0.5, 0.25});
                         break;
                     default:
                         std::cerr << "Vehicle type can not be represented with the CG engine\n";
                 }
-                prevPosition = position - length;
             }
-            lane(ini, nr, max, y, roadLength);
-            if (j != road->getNumLanes() - 1) line(ini, nr, y + 2.0 * max, roadLength);
-            y += max * 2.0 + 0.5;
-        }
-        for (unsigned int b = 0; b < road->getBusStops().size(); b++) {
-            double pos = road->getBusStops()[b]->getPosition() / fgScale;
-            sign(ini, nr, pos, y, 'y');
+            y += layout[index] * 2.0 + 0.5;
         }
         for (unsigned int b = 0; b < road->getTrafficLights().size(); b++) {
             double pos = road->getTrafficLights()[b]->getPosition() / fgScale;
             TrafficLight::EColor color = road->getTrafficLights()[b]->getColor();
-            char c;
+            char c = 'r';
             switch (color) {
                 case TrafficLight::EColor::kGreen:
                     c = 'g';
@@ -232,51 +397,47 @@ void NetworkExporter::cgExport(const Network *kNetwork, const unsigned int kTick
                     c = 'r';
                     break;
             }
-            sign(ini, nr, pos, y, c);
+            sign(*scene, pos, y, c);
+        }
+        y += 1;
+    }
+
+    roadScene = fgRoads;
+    return scene;
+}
+
+void NetworkExporter::roads(cg::Scene &scene, const Network *kNetwork, const std::vector<uint32_t> &kLayout) {
+    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling roads");
+    double y = 0;
+    uint32_t index = 0;     // of the lane in the layout
+    for (uint32_t i = 0; i < kNetwork->fRoads.size(); i++) {
+        const Road *road = kNetwork->fRoads[i];
+        double roadLength = road->getRoadLength() / fgScale;
+        for (uint32_t j = 0; j < road->getNumLanes(); j++, index++) {
+            lane(scene, kLayout[index], y, roadLength);
+            if (j != road->getNumLanes() - 1) line(scene, y + 2.0 * kLayout[index], roadLength);
+            y += kLayout[index] * 2.0 + 0.5;
+        }
+        for (unsigned int b = 0; b < road->getBusStops().size(); b++) {
+            double pos = road->getBusStops()[b]->getPosition() / fgScale;
+            pole(scene, pos, y);
+            sign(scene, pos, y, 'y');
+        }
+        // the colour of a traffic light changes, only its pole is drawn with the roads
+        for (unsigned int b = 0; b < road->getTrafficLights().size(); b++) {
+            pole(scene, road->getTrafficLights()[b]->getPosition() / fgScale, y);
         }
         for (unsigned int b = 0; b < road->getZones().size(); b++) {
             double pos = road->getZones()[b]->getPosition() / fgScale;
-            sign(ini, nr, pos, y, 'w');
+            pole(scene, pos, y);
+            sign(scene, pos, y, 'w');
         }
         y += 1;
     }
+}
 
-    general(ini, nr);
-
-    ini.close();
-    std::string command = "./engine/engine " + filename + "";
-    if (kTick > 0) command += " &";
-    res = system(command.c_str());
-    ENSURE(res == 0 or res == 256, "Failed to run engine on the generated ini file");
-    ENSURE(!ini.is_open(), "Failed to close ofstream to ini");
-}
-
-void NetworkExporter::general(std::ofstream &ini, const int &kNr) {
-    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling general");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(kNr >= 0, "kNr must be greater than 0");
-    ini << "[General]\n"
-           "size = 2024\n"
-           "backgroundcolor = (0.05,0.06,0.05)\n"
-           "type = \"LightedZBuffering\"\n"
-           "nrLights = 1\n"
-           "shadowEnabled = FALSE\n"
-           "eye = (0,50,100)\n"
-           "nrFigures = " << kNr << "\n"
-                                    "\n"
-                                    "[Light0]\n"
-                                    "infinity = TRUE\n"
-                                    "direction = (-3,-1,-10)\n"
-                                    "ambientLight = (0.4,0.4,0.4)\n"
-                                    "diffuseLight = (1,1,1)\n"
-                                    "specularLight = (1,1,1)\n"
-                                    "\n";
-}
-
-void NetworkExporter::car(std::ofstream &ini, int &nr, const Pos &pos, bool real) {
+void NetworkExporter::car(cg::Scene &scene, const Pos &pos, bool real) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling car");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
     Object bottom = Object::rectangle(pos, {pos.fX + 3, pos.fY + 1.5, pos.fZ + 0.5});
     Object top = Object::rectangle({pos.fX + 1, pos.fY, pos.fZ + 0.5}, {pos.fX + 2, pos.fY + 1.5, pos.fZ + 1});
     if (real) {
@@ -299,52 +460,27 @@ void NetworkExporter::car(std::ofstream &ini, int &nr, const Pos &pos, bool real
         top.fReflectionCoefficient = 20;
 
     }
-    bottom.print(ini, nr++);
-    top.print(ini, nr++);
-    wheel(ini, nr, {pos.fX + 0.5, pos.fY - 0.25, pos.fZ});
-    wheel(ini, nr, {pos.fX + 2.5, pos.fY - 0.25, pos.fZ});
+    bottom.draw(scene);
+    top.draw(scene);
+    wheel(scene, {pos.fX + 0.5, pos.fY - 0.25, pos.fZ});
+    wheel(scene, {pos.fX + 2.5, pos.fY - 0.25, pos.fZ});
 }
 
-void NetworkExporter::wheel(std::ofstream &ini, int &nr, const Pos &kPos) {
+void NetworkExporter::wheel(cg::Scene &scene, const Pos &kPos) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling wheel");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
-    ini << "[Figure" << nr++ << "]\n";
-    ini << "type = \"Cylinder\"\n";
-    ini << "scale = 0.25\n";
-    ini << "rotateX = -90\n";
-    ini << "center = " << kPos << "\n";
-    ini << "ambientReflection = (0.1, 0.1, 0.1)\n";
-    ini << "diffuseReflection = (0.1, 0.1, 0.1)\n";
-    ini << "n = 10\n";
-    ini << "height = 8\n";
-    ini << "\n";
-}
-
-void NetworkExporter::lane(std::ofstream &ini, int &nr, double max, double y, double roadlength) {
+    const double kCenter[3] = {kPos.fX, kPos.fY, kPos.fZ};
+    scene.addCylinder(10, 8, 0.25, -90, kCenter, material({0.1, 0.1, 0.1}, {0.1, 0.1, 0.1}, {}, 0));
+}
+
+void NetworkExporter::lane(cg::Scene &scene, double max, double y, double roadlength) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling lane");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
-    ini << "[Figure" << nr++ << "]\n";
-    ini << "type = \"LineDrawing\"\n";
-    ini << "ambientReflection = (0.2, 0.2, 0.2)\n";
-    ini << "diffuseReflection = (0.3, 0.3, 0.3)\n";
-    ini << "specularReflection = (0.2, 0.2, 0.2)\n";
-    ini << "reflectoinCoefficient = 10\n";
-    ini << "nrPoints = 4\n";
-    ini << "nrLines = 1\n";
-    ini << "point0 = " << Pos{0, y, 0} << "\n";
-    ini << "point1 = " << Pos{0, y + (max * 2), 0} << "\n";
-    ini << "point2 = " << Pos{-roadlength, y + (max * 2), 0} << "\n";
-    ini << "point3 = " << Pos{-roadlength, y, 0} << "\n";
-    ini << "line0 = (0,1,2,3)\n";
-    ini << "\n";
-}
-
-void NetworkExporter::bus(std::ofstream &ini, int &nr, const Pos &pos) {
+    // the coefficient of lanes and lines has always been 0, the engine never read the one in the ini files
+    scene.addPolygons({0, y, 0, 0, y + (max * 2), 0, -roadlength, y + (max * 2), 0, -roadlength, y, 0},
+                      {{0, 1, 2, 3}}, material({0.2, 0.2, 0.2}, {0.3, 0.3, 0.3}, {0.2, 0.2, 0.2}, 0));
+}
+
+void NetworkExporter::bus(cg::Scene &scene, const Pos &pos) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling bus");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
     Object bottom = Object::rectangle(pos, {pos.fX + 10, pos.fY + 1.5, pos.fZ + 3});
     Object window = Object::rectangle({pos.fX + 0.5, pos.fY - 0.02, pos.fZ + 0.5},
                                       {pos.fX + 1.25, pos.fY + 1.52, pos.fZ + 2.5});
@@ -353,17 +489,15 @@ void NetworkExporter::bus(std::ofstream &ini, int &nr, const Pos &pos) {
     bottom.fDiffuse.set(0.8, 0.8, 0.1);
     bottom.fSpecular.set(0.5, 0.5, 0.1);
     bottom.fReflectionCoefficient = 20;
-    window.print(ini, nr++);
-    bottom.print(ini, nr++);
-    wheel(ini, nr, {pos.fX + 5, pos.fY - 0.25, pos.fZ});
-    wheel(ini, nr, {pos.fX + 2, pos.fY - 0.25, pos.fZ});
-    wheel(ini, nr, {pos.fX + 8, pos.fY - 0.25, pos.fZ});
+    window.draw(scene);
+    bottom.draw(scene);
+    wheel(scene, {pos.fX + 5, pos.fY - 0.25, pos.fZ});
+    wheel(scene, {pos.fX + 2, pos.fY - 0.25, pos.fZ});
+    wheel(scene, {pos.fX + 8, pos.fY - 0.25, pos.fZ});
 }
 
-void NetworkExporter::truck(std::ofstream &ini, int &nr, const Pos &pos) {
+void NetworkExporter::truck(cg::Scene &scene, const Pos &pos) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling truck");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
     Object cabin = Object::rectangle({pos.fX, pos.fY, pos.fZ + 1}, {pos.fX + 1, pos.fY + 1.5, pos.fZ + 3});
     cabin.fAmbient.set(0.5, 0.1, 0.1);
     cabin.fDiffuse.set(0.8, 0.1, 0.1);
@@ -379,20 +513,18 @@ void NetworkExporter::truck(std::ofstream &ini, int &nr, const Pos &pos) {
     container.fDiffuse.set(0.1, 0.8, 0.8);
     container.fSpecular.set(0.1, 0.5, 0.5);
     container.fReflectionCoefficient = 20;
-    car(ini, nr, {pos.fX + 10, pos.fY, pos.fZ + 1.25}, false);
-    bottom.print(ini, nr++);
-    container.print(ini, nr++);
-    cabin.print(ini, nr++);
-    wheel(ini, nr, {pos.fX + 1.5, pos.fY - 0.25, pos.fZ});
-    wheel(ini, nr, {pos.fX + 5, pos.fY - 0.25, pos.fZ});
-    wheel(ini, nr, {pos.fX + 10, pos.fY - 0.25, pos.fZ});
-    wheel(ini, nr, {pos.fX + 15 - 1.5, pos.fY - 0.25, pos.fZ});
+    car(scene, {pos.fX + 10, pos.fY, pos.fZ + 1.25}, false);
+    bottom.draw(scene);
+    container.draw(scene);
+    cabin.draw(scene);
+    wheel(scene, {pos.fX + 1.5, pos.fY - 0.25, pos.fZ});
+    wheel(scene, {pos.fX + 5, pos.fY - 0.25, pos.fZ});
+    wheel(scene, {pos.fX + 10, pos.fY - 0.25, pos.fZ});
+    wheel(scene, {pos.fX + 15 - 1.5, pos.fY - 0.25, pos.fZ});
 }
 
-void NetworkExporter::motorcycle(std::ofstream &ini, int &nr, const Pos &pos) {
+void NetworkExporter::motorcycle(cg::Scene &scene, const Pos &pos) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling motorcycle");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
     Object bottom = Object::rectangle(pos, {pos.fX + 1, pos.fY + 0.5, pos.fZ + 0.5});
     Object seat = Object::rectangle({pos.fX + 0.5, pos.fY + 0.05, pos.fZ + 0.5},
                                     {pos.fX + 0.9, pos.fY + 0.45, pos.fZ + 0.75});
@@ -405,88 +537,66 @@ void NetworkExporter::motorcycle(std::ofstream &ini, int &nr, const Pos &pos) {
     seat.fDiffuse.set(0.1, 0.1, 0.1);
     steer.fAmbient.set(0.1, 0.1, 0.1);
     steer.fDiffuse.set(0.1, 0.1, 0.1);
-    steer.print(ini, nr++);
-    bottom.print(ini, nr++);
-    seat.print(ini, nr++);
+    steer.draw(scene);
+    bottom.draw(scene);
+    seat.draw(scene);
 }
 
-void NetworkExporter::line(std::ofstream &ini, int &nr, const double &y, const double &x) {
+void NetworkExporter::line(cg::Scene &scene, const double &y, const double &x) {
     REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling line");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
+    // the specular colour of the white dashes is what the engine has always drawn them with
+    const cg::Material kWhite = material({0.9, 0.9, 0.9}, {0.9, 0.9, 0.9}, {0.9, 0, 9.9}, 0);
+    const cg::Material kGrey = material({0.2, 0.2, 0.2}, {0.3, 0.3, 0.3}, {0.2, 0.2, 0.2}, 0);
     double now = 0;
     bool white = true;
     while (-now < x) {
-        ini << "[Figure" << nr++ << "]\n";
-        ini << "type = \"LineDrawing\"\n";
-        if (white) {
-            ini << "ambientReflection = (0.9,0.9,0.9)\n";
-            ini << "diffuseReflection = (0.9,0.9,0.9)\n";
-            ini << "specularReflection = (0.9,0,9.9)\n";
-            ini << "reflectoinCoefficient = 10\n";
-        } else {
-            ini << "ambientReflection = (0.2, 0.2, 0.2)\n";
-            ini << "diffuseReflection = (0.3, 0.3, 0.3)\n";
-            ini << "specularReflection = (0.2, 0.2, 0.2)\n";
-            ini << "reflectoinCoefficient = 10\n";
-        }
-        white = !white;
-        ini << "nrPoints = 4\n";
-        ini << "nrLines = 1\n";
-        ini << "point0 = " << Pos{now, y, 0} << "\n";
-        ini << "point1 = " << Pos{now, y + 0.5, 0} << "\n";
+        const double kBegin = now;
         if (now + x <= 2) {
             now = -x;
         } else {
             now -= 2;
         }
-        ini << "point2 = " << Pos{now, y + 0.5, 0} << "\n";
-        ini << "point3 = " << Pos{now, y, 0} << "\n";
-        ini << "line0 = (0,1,2,3)\n";
-        ini << "\n";
+        scene.addPolygons({kBegin, y, 0, kBegin, y + 0.5, 0, now, y + 0.5, 0, now, y, 0}, {{0, 1, 2, 3}},
+                          white ? kWhite : kGrey);
+        white = !white;
     }
 }
 
-void NetworkExporter::sign(std::ofstream &ini, int &nr, const double &x, const double &y, char c) {
-    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling sign");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
+void NetworkExporter::pole(cg::Scene &scene, const double &x, const double &y) {
+    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling pole");
     Object pole = Object::rectangle({-x, y, 0}, {-x - 0.1, y + 0.1, 2});
     pole.fDiffuse.set(0.3, 0.3, 0.3);
     pole.fSpecular.set(0.3, 0.3, 0.3);
-    pole.print(ini, nr++);
-    ini << "[Figure" << nr++ << "]\n";
-    ini << "type = \"Sphere\"\n";
+    pole.draw(scene);
+}
+
+void NetworkExporter::sign(cg::Scene &scene, const double &x, const double &y, char c) {
+    REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling sign");
+    Color color;
     switch (c) {
         case 'r':
-            ini << "ambientReflection = (1,0,0)\n";
-            ini << "diffuseReflection = (1,0,0)\n";
+            color.set(1, 0, 0);
             break;
         case 'o':
-            ini << "ambientReflection = (1, 0.5, 0)\n";
-            ini << "diffuseReflection = (1, 0.5, 0)\n";
+            color.set(1, 0.5, 0);
             break;
         case 'g':
-            ini << "ambientReflection = (0,1,0)\n";
-            ini << "diffuseReflection = (0,1,0)\n";
+            color.set(0, 1, 0);
             break;
         case 'y':
-            ini << "ambientReflection = (1,1,0)\n";
-            ini << "diffuseReflection = (1,1,0)\n";
+            color.set(1, 1, 0);
             break;
         case 'w':
-            ini << "ambientReflection = (1,1,1)\n";
-            ini << "diffuseReflection = (1,1,1)\n";
+            color.set(1, 1, 1);
             break;
         default:
             std::cerr << "Sign of type " << c << " could not be displayed\n";
     }
-    ini << "scale = 0.4\n";
-    ini << "center = " << Pos{-x - 0.05, y, 2} << "\n";
-    ini << "n = 1\n";
-    ini << "\n";
+    const double kCenter[3] = {-x - 0.05, y, 2};
+    scene.addSphere(1, 0.4, kCenter, material(color, color, {}, 0));
 }
 
+namespace cg {
 Object Object::rectangle(const Pos &begin, const Pos &end) {
     REQUIRE(!(begin.fX == end.fX && begin.fY == end.fY && begin.fZ == end.fZ),
             "NetworkExporter was not initialized when calling sign");
@@ -512,25 +622,21 @@ Object Object::rectangle(const Pos &begin, const Pos &end) {
     return object;
 }
 
-void Object::print(std::ofstream &ini, const int nr) {
-    REQUIRE(properlyInitialized(), "Object was not initialized when calling print");
-    REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-    REQUIRE(nr >= 0, "Nr must be greater than 0");
-    ini << "[Figure" << nr << "]\n";
-    ini << "type = \"LineDrawing\"\n";
-    ini << "ambientReflection = " << fAmbient << "\n";
-    ini << "diffuseReflection = " << fDiffuse << "\n";
-    ini << "specularReflection = " << fSpecular << "\n";
-    ini << "reflectionCoefficient = " << fReflectionCoefficient << "\n";
-    ini << "nrPoints = " << fPoints.size() << "\n";
-    ini << "nrLines = " << fFaces.size() << "\n";
+void Object::draw(cg::Scene &scene) const {
+    REQUIRE(properlyInitialized(), "Object was not initialized when calling draw");
+    std::vector<double> points;
+    points.reserve(3 * fPoints.size());
     for (unsigned int i = 0; i < fPoints.size(); i++) {
-        ini << "point" << i << " = " << fPoints[i] << "\n";
+        points.push_back(fPoints[i].fX);
+        points.push_back(fPoints[i].fY);
+        points.push_back(fPoints[i].fZ);
     }
+    std::vector<std::vector<int> > faces;
+    faces.reserve(fFaces.size());
     for (unsigned int i = 0; i < fFaces.size(); i++) {
-        ini << "line" << i << " = " << fFaces[i] << "\n";
+        faces.push_back(fFaces[i].fIndexes);
     }
-    ini << "\n";
+    scene.addPolygons(points, faces, material(fAmbient, fDiffuse, fSpecular, fReflectionCoefficient));
 }
 
 Object::Object() {
@@ -605,6 +711,7 @@ Face::Face(std::vector<int> fIndexes) : fIndexes(std::move(fIndexes)) {
 bool Face::properlyInitialized() const {
     return _initCheck == this;
 }
+}
 
 // source: Serge Demeyer - TicTactToe in C++, Ansi-style
 bool FileExists(const std::string &filename) {
@@ -619,4 +726,14 @@ bool FileExists(const std::string &filename) {
     return false;
 }
 
-
+bool OpenOutput(std::ofstream &file, const std::string &kPath, const uint64_t kResume) {
+    struct stat st{};
+    if (kResume > 0 and stat(kPath.c_str(), &st) == 0 and static_cast<uint64_t>(st.st_size) >= kResume and
+        truncate(kPath.c_str(), kResume) == 0) {
+        file.open(kPath.c_str(), std::ios::in | std::ios::out | std::ios::ate);
+        if (file.is_open()) return true;
+    }
+    if (kResume > 0) std::cerr << "Failed to continue " << kPath << ": the output is written from the start\n";
+    file.open(kPath.c_str());
+    return false;
+}
@@ -12,10 +12,17 @@
 #define SIMULATION_NETWORKEXPORTER_H
 
 #include "../datatypes/Network.h"
+#include "../DesignByContract.h"
+#include "../../engine/Scene.h"
 #include <fstream>
+#include <iostream>
+#include <sstream>
 #include <stdint.h>
 #include <ostream>
+#include <memory>
 
+// the shapes the network is drawn with, they are kept in cg so they do not clash with the Color and Face of the engine
+namespace cg {
 struct Color {
     double fR;
     double fG;
@@ -105,11 +112,9 @@ struct Object {
     static Object rectangle(const Pos &begin, const Pos &end);
 
     /**
-     *  REQUIRE(properlyInitialized(), "Object was not initialized when calling print");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
+     *  REQUIRE(properlyInitialized(), "Object was not initialized when calling draw");
      */
-    void print(std::ofstream &ini, int nr);
+    void draw(cg::Scene &scene) const;
 
     /**
      *  ENSURE(this->properlyInitialized(), "Object was not initialized when constructed");
@@ -119,19 +124,34 @@ struct Object {
 private:
     Object *_initCheck;
 };
+}
 
 class NetworkExporter {
 public:
 
     /**
+     *  kResume are the sizes of the simple and impression output at a checkpoint, the outputs are continued from there.
+     *  0 starts the output anew.
+     *
      *  REQUIRE(kNetwork, "Failed to export network: no network");
      *  ENSURE(res == 0 or res == 256, "Failed to create output directory");
      *  ENSURE(fgSimple.is_open(), "Failed to load file for simple output");
      *  ENSURE(fgImpression.is_open(), "Failed to load File for impression output");
      */
-    static void init(const Network *network, const std::string &kSimplePath, const std::string &kImpressionPath);
+    static void init(const Network *network, const std::string &kSimplePath, const std::string &kImpressionPath,
+                     const std::pair<uint64_t, uint64_t> &kResume = std::pair<uint64_t, uint64_t>(0, 0));
 
     /**
+     *  flushes the outputs and returns the sizes of the simple and impression output
+     *
+     *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling getSizes");
+     */
+    static std::pair<uint64_t, uint64_t> getSizes();
+
+    /**
+     *  copies the state of the network and hands it to the ExportPipeline to be written. Returns the impression of
+     *  the section, or an empty string when the pipeline writes it on a background thread.
+     *
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling addSection");
      *  REQUIRE(kNetwork, "Failed to add section: no network");
      */
@@ -162,19 +182,37 @@ public:
     static void printLane(const std::vector<std::vector<char>> &lane, uint32_t max, uint32_t laneNum);
 
     /**
+     *  renders the network with the cg engine to outputfiles/cg.bmp, or to outputfiles/tickN.bmp when kTick is not 0.
+     *  The image is rendered and written by the ExportPipeline, cg.bmp is written before this returns.
+     *  The roads are only drawn again when a lane has to be widened or narrowed for vehicles that overlap,
+     *  every frame draws the vehicles and the colours of the traffic lights.
+     *  Nothing is written when the network has nothing to draw.
+     *
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling cgExport");
      *  REQUIRE(kNetwork, "Failed to export to cg: no network");
-     *  REQUIRE(FileExists("engine/engine"), "Failed to export to cg engine: engine not found");
      *  ENSURE(res == 0 or res == 256, "Failed to create output directory");
-     *  ENSURE(ini.is_open(), "Failed to open file for cg export");
-     *  ENSURE(res == 0, "Failed to run engine on the generated ini file");
-     *  ENSURE(!ini.is_open(), "Failed to close ofstream to ini");
      */
     static void cgExport(const Network *kNetwork, unsigned int kTick);
 
+    /**
+     *  draws the network for the cg engine the way cgExport does. roadScene is set to the scene with the roads and signs,
+     *  which is kept between frames, the returned scene holds the vehicles and the colours of the traffic lights.
+     *  The caller owns the returned scene and renders it on top of roadScene.
+     *
+     *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling cgScene");
+     *  REQUIRE(kNetwork, "Failed to draw the network: no network");
+     */
+    static cg::Scene *cgScene(const Network *kNetwork, std::shared_ptr<const cg::Scene> &roadScene);
+
+    // the settings the cg images are rendered with
+    static const cg::View fgkView;
+
     static bool properlyInitialized();
 
 private:
+    class SectionJob;
+    class RenderJob;
+
     static std::ofstream fgSimple;
     static std::ofstream fgImpression;
 
@@ -183,74 +221,80 @@ private:
     static double fgScale;
     static uint32_t fgLongestName;
 
+    // the roads and signs of the cg export and the amount of rows of every lane they were drawn for
+    static std::shared_ptr<const cg::Scene> fgRoads;
+    static std::vector<uint32_t> fgLayout;
+
     static bool _initCheck;
 
     /**
-     *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling sign");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
+     *  appends the impression of one lane to out, this does not use the state of the exporter
      */
-    static void sign(std::ofstream &ini, int &nr, const double &x, const double &y, char c);
+    static void formatLane(std::string &out, const std::vector<std::vector<char>> &lane, uint32_t max, uint32_t laneNum,
+                           uint32_t longestName);
 
     /**
-     *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling general");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
+     *  draws the lanes, the lines between them and the signs that do not change, kLayout holds the amount of rows of
+     *  every lane
+     *
+     *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling roads");
      */
-    static void general(std::ofstream &ini, const int &kNr);
+    static void roads(cg::Scene &scene, const Network *kNetwork, const std::vector<uint32_t> &kLayout);
+
+    /**
+     *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling pole");
+     */
+    static void pole(cg::Scene &scene, const double &x, const double &y);
+
+    /**
+     *  the coloured sphere on top of a pole
+     *
+     *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling sign");
+     */
+    static void sign(cg::Scene &scene, const double &x, const double &y, char c);
 
     /**
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling line");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
      */
-    static void line(std::ofstream &ini, int &nr, const double &y, const double &x);
+    static void line(cg::Scene &scene, const double &y, const double &x);
 
     /**
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling lane");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
      */
-    static void lane(std::ofstream &ini, int &nr, double max, double y, double roadlength);
+    static void lane(cg::Scene &scene, double max, double y, double roadlength);
 
     /**
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling wheel");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
      */
-    static void wheel(std::ofstream &ini, int &nr, const Pos &kPos);
+    static void wheel(cg::Scene &scene, const cg::Pos &kPos);
 
     /**
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling car");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
      */
-    static void car(std::ofstream &ini, int &nr, const Pos &pos, bool real);
+    static void car(cg::Scene &scene, const cg::Pos &pos, bool real);
 
     /**
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling bus");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
      */
-    static void bus(std::ofstream &ini, int &nr, const Pos &pos);
+    static void bus(cg::Scene &scene, const cg::Pos &pos);
 
     /**
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling truck");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
      */
-    static void truck(std::ofstream &ini, int &nr, const Pos &pos);
+    static void truck(cg::Scene &scene, const cg::Pos &pos);
 
     /**
      *  REQUIRE(properlyInitialized(), "NetworkExporter was not initialized when calling motorcycle");
-     *  REQUIRE(ini.is_open(), "Ofstream to ini is not open");
-     *  REQUIRE(nr >= 0, "Nr must be greater than 0");
      */
-    static void motorcycle(std::ofstream &ini, int &nr, const Pos &pos);
+    static void motorcycle(cg::Scene &scene, const cg::Pos &pos);
 
 };
 
 // source: Serge Demeyer - TicTactToe in C++, Ansi-style
 bool FileExists(const std::string &filename);
 
+// opens an output file, when kResume is not 0 the file is cut back to kResume bytes and continued.
+// Returns true if the file is continued, false if it is started anew.
+bool OpenOutput(std::ofstream &file, const std::string &kPath, uint64_t kResume);
+
 #endif //SIMULATION_NETWORKEXPORTER_H
@@ -0,0 +1,188 @@
+//============================================================================
+// @name        : ReplayExporter.cpp
+// @author      : Thomas Dooms
+// @date        : 5/28/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : writes the cg images of a simulation as the frames of one uncompressed video stream
+//============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include "ReplayExporter.h"
+#include "ExportPipeline.h"
+#include "NetworkExporter.h"
+#include "../DesignByContract.h"
+
+const uint32_t ReplayExporter::fgkDefaultFps = 25;
+
+std::ofstream ReplayExporter::fgFile;
+EReplayFormat ReplayExporter::fgFormat = kReplayPpm;
+uint32_t ReplayExporter::fgFps = 0;
+uint32_t ReplayExporter::fgWidth = 0;
+uint32_t ReplayExporter::fgHeight = 0;
+uint32_t ReplayExporter::fgFrames = 0;
+bool ReplayExporter::_initCheck = false;
+
+namespace
+{
+    // the same rounding the engine uses for its own colours
+    uint8_t channel(const double kValue)
+    {
+        return static_cast<uint8_t>(std::round(std::min(std::max(kValue, 0.0), 1.0) * 255));
+    }
+
+    // the integer BT.601 conversion, with y in 16-235 and u and v in 16-240 like y4m players expect
+    void yuv(const uint8_t* kPixel, uint8_t& y, uint8_t& u, uint8_t& v)
+    {
+        const int kR = kPixel[0];
+        const int kG = kPixel[1];
+        const int kB = kPixel[2];
+        y = static_cast<uint8_t>(((66 * kR + 129 * kG + 25 * kB + 128) >> 8) + 16);
+        u = static_cast<uint8_t>(((-38 * kR - 74 * kG + 112 * kB + 128) >> 8) + 128);
+        v = static_cast<uint8_t>(((112 * kR - 94 * kG - 18 * kB + 128) >> 8) + 128);
+    }
+}
+
+// a frame of the replay, rendered and converted by the export pipeline
+class ReplayExporter::FrameJob : public IExportJob
+{
+public:
+    FrameJob(const std::shared_ptr<const cg::Scene>& kRoads, cg::Scene* vehicles)
+            : fRoads(kRoads), fVehicles(vehicles), fFormat(fgFormat), fWidth(fgWidth), fHeight(fgHeight), fRendered(false)
+    {
+    }
+
+    virtual void format()
+    {
+        std::vector<const cg::Scene*> scenes;
+        scenes.push_back(fRoads.get());
+        scenes.push_back(fVehicles.get());
+        cg::Image image;
+        fRendered = cg::render(scenes, image);
+        fRoads.reset();
+        fVehicles.reset();
+        if(not fRendered) return;
+
+        if(fFormat == kReplayPpm)
+        {
+            fBytes = "P6\n" + std::to_string(image.width) + " " + std::to_string(image.height) + "\n255\n";
+            fBytes.append(reinterpret_cast<const char*>(image.pixels.data()), image.pixels.size());
+            return;
+        }
+
+        // the first frame decides the size of the stream
+        if(fWidth == 0)
+        {
+            fWidth = image.width;
+            fHeight = image.height;
+        }
+        const uint64_t kPlane = uint64_t(fWidth) * fHeight;
+        const std::string kFrame = "FRAME\n";
+        fBytes.resize(kFrame.size() + 3 * kPlane);
+        fBytes.replace(0, kFrame.size(), kFrame);
+        uint8_t* planes[3];
+        for(uint32_t i = 0; i < 3; i++) planes[i] = reinterpret_cast<uint8_t*>(&fBytes[kFrame.size() + i * kPlane]);
+
+        uint8_t background[3];
+        for(uint32_t i = 0; i < 3; i++) background[i] = channel(NetworkExporter::fgkView.background[i]);
+        uint8_t fill[3];
+        yuv(background, fill[0], fill[1], fill[2]);
+        for(uint32_t i = 0; i < 3; i++) std::fill(planes[i], planes[i] + kPlane, fill[i]);
+
+        // the image is centred on the frame, what falls outside is cut
+        const int64_t kLeft = (int64_t(fWidth) - image.width) / 2;
+        const int64_t kTop = (int64_t(fHeight) - image.height) / 2;
+        for(uint32_t y = 0; y < image.height; y++)
+        {
+            const int64_t kRow = kTop + y;
+            if(kRow < 0 or kRow >= fHeight) continue;
+            for(uint32_t x = 0; x < image.width; x++)
+            {
+                const int64_t kColumn = kLeft + x;
+                if(kColumn < 0 or kColumn >= fWidth) continue;
+                const uint64_t kIndex = kRow * fWidth + kColumn;
+                yuv(&image.pixels[3 * (uint64_t(y) * image.width + x)], planes[0][kIndex], planes[1][kIndex], planes[2][kIndex]);
+            }
+        }
+    }
+
+    virtual void write()
+    {
+        if(not fRendered) return;
+        if(fFormat == kReplayY4m and fgWidth == 0)
+        {
+            fgWidth = fWidth;
+            fgHeight = fHeight;
+            fgFile << "YUV4MPEG2 W" << fgWidth << " H" << fgHeight << " F" << fgFps << ":1 Ip A1:1 C444\n";
+        }
+        fgFile.write(fBytes.data(), fBytes.size());
+        fgFrames++;
+    }
+
+    virtual uint64_t getSize() const
+    {
+        // the image and the frame it becomes are about as big
+        return sizeof(*this) + 3 * uint64_t(NetworkExporter::fgkView.size) * NetworkExporter::fgkView.size;
+    }
+
+private:
+    std::shared_ptr<const cg::Scene> fRoads;    // shared with the network exporter and the other frames
+    std::unique_ptr<cg::Scene> fVehicles;
+    const EReplayFormat fFormat;
+    uint32_t fWidth;
+    uint32_t fHeight;
+    std::string fBytes;
+    bool fRendered;
+};
+
+void ReplayExporter::init(const std::string& kPath, const EReplayFormat kFormat, const uint32_t kFps)
+{
+    REQUIRE(kFps > 0, "A replay plays at least one frame every second");
+    int res = system("mkdir outputfiles >/dev/null 2>&1");
+    ENSURE(res == 0 or res == 256, "Failed to create output directory");
+
+    const std::string kExtension = kFormat == kReplayPpm ? ".ppm" : ".y4m";
+    fgFile.open(("outputfiles/" + kPath + kExtension).c_str(), std::ios::binary | std::ios::trunc);
+    _initCheck = fgFile.is_open();
+    ENSURE(properlyInitialized(), "Failed to open file for replay output");
+
+    fgFormat = kFormat;
+    fgFps = kFps;
+    fgWidth = 0;
+    fgHeight = 0;
+    fgFrames = 0;
+}
+
+void ReplayExporter::addFrame(const Network* const kNetwork)
+{
+    REQUIRE(properlyInitialized(), "ReplayExporter was not initialized when calling addFrame");
+    REQUIRE(NetworkExporter::properlyInitialized(), "NetworkExporter was not initialized when calling addFrame");
+    REQUIRE(kNetwork, "Failed to add frame: no network");
+
+    std::shared_ptr<const cg::Scene> roads;
+    cg::Scene* vehicles = NetworkExporter::cgScene(kNetwork, roads);
+    ExportPipeline::push(new FrameJob(roads, vehicles));
+    // the frames after the first one are made for its size, so they can only be queued once it is known
+    if(fgFormat == kReplayY4m and fgWidth == 0) ExportPipeline::flush();
+}
+
+uint32_t ReplayExporter::getFrames()
+{
+    REQUIRE(properlyInitialized(), "ReplayExporter was not initialized when calling getFrames");
+    ExportPipeline::flush();
+    return fgFrames;
+}
+
+void ReplayExporter::finish()
+{
+    REQUIRE(properlyInitialized(), "ReplayExporter was not initialized when calling finish");
+    ExportPipeline::flush();
+    fgFile.close();
+    _initCheck = false;
+}
+
+bool ReplayExporter::properlyInitialized()
+{
+    return _initCheck;
+}
@@ -0,0 +1,81 @@
+//============================================================================
+// @name        : ReplayExporter.h
+// @author      : Thomas Dooms
+// @date        : 5/28/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : writes the cg images of a simulation as the frames of one uncompressed video stream
+//============================================================================
+
+#ifndef SIMULATION_REPLAYEXPORTER_H
+#define SIMULATION_REPLAYEXPORTER_H
+
+#include <stdint.h>
+#include <string>
+#include <fstream>
+#include "../datatypes/Network.h"
+
+/**
+ * A ppm replay is a binary ppm image for every frame, one after the other, so every frame keeps its own size.
+ * A y4m replay is a YUV4MPEG2 stream with 4:4:4 sampling: every frame is as big as the first one, a frame that is
+ * bigger is cut and a frame that is smaller is centred on the background colour. Players and encoders read both,
+ * for example "ffmpeg -i replay.y4m" or "ffmpeg -f image2pipe -c:v ppm -i replay.ppm".
+ */
+enum EReplayFormat {kReplayPpm, kReplayY4m};
+
+class ReplayExporter
+{
+public:
+    /**
+     * creates outputfiles/kPath.ppm or outputfiles/kPath.y4m, a y4m replay plays kFps frames every second
+     *
+     * REQUIRE(kFps > 0, "A replay plays at least one frame every second");
+     * ENSURE(res == 0 or res == 256, "Failed to create output directory");
+     * ENSURE(properlyInitialized(), "Failed to open file for replay output");
+     */
+    static void init(const std::string& kPath, EReplayFormat kFormat, uint32_t kFps = fgkDefaultFps);
+
+    /**
+     * draws the network like NetworkExporter::cgExport and hands the frame to the ExportPipeline, which renders it
+     * on a writer thread. Frames are written in the order they are added, a network that the engine can not draw
+     * adds no frame. Until the first frame is written this waits for it, so a y4m replay knows its size.
+     *
+     * REQUIRE(properlyInitialized(), "ReplayExporter was not initialized when calling addFrame");
+     * REQUIRE(NetworkExporter::properlyInitialized(), "NetworkExporter was not initialized when calling addFrame");
+     * REQUIRE(kNetwork, "Failed to add frame: no network");
+     */
+    static void addFrame(const Network* kNetwork);
+
+    /**
+     * waits until every frame that was added is written and returns the amount of frames in the replay
+     *
+     * REQUIRE(properlyInitialized(), "ReplayExporter was not initialized when calling getFrames");
+     */
+    static uint32_t getFrames();
+
+    /**
+     * waits until every frame is written and closes the replay
+     *
+     * REQUIRE(properlyInitialized(), "ReplayExporter was not initialized when calling finish");
+     */
+    static void finish();
+
+    static bool properlyInitialized();
+
+    static const uint32_t fgkDefaultFps;
+
+private:
+    class FrameJob;
+
+    static std::ofstream fgFile;
+    static EReplayFormat fgFormat;
+    static uint32_t fgFps;
+    static uint32_t fgWidth;        // size of the y4m frames, 0 until the first frame is written
+    static uint32_t fgHeight;
+    static uint32_t fgFrames;
+
+    static bool _initCheck;
+};
+
+
+#endif //SIMULATION_REPLAYEXPORTER_H
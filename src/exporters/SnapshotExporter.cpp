@@ -0,0 +1,248 @@
+//============================================================================
+// @name        : SnapshotExporter.cpp
+// @author      : Thomas Dooms
+// @date        : 5/26/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : writes the complete state of a network to a binary snapshot that can be mapped back in
+//============================================================================
+
+#include <fstream>
+#include <cstring>
+#include <unordered_map>
+#include "SnapshotExporter.h"
+#include "../DesignByContract.h"
+
+const char SnapshotExporter::fgkMagic[8] = {'S', 'I', 'M', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t SnapshotExporter::fgkVersion = 2;
+const uint32_t SnapshotExporter::fgkEndianness = 0x01020304;
+const uint64_t SnapshotExporter::fgkRecordSizes[kSnapshotSections] = {sizeof(SnapshotRoad), sizeof(SnapshotLane),
+    sizeof(SnapshotEntry), sizeof(SnapshotMerge), sizeof(SnapshotZone), sizeof(SnapshotBusStop),
+    sizeof(SnapshotTrafficLight), sizeof(SnapshotVehicle), 1};
+
+// the layout is part of the format, a change here needs a new fgkVersion
+static_assert(sizeof(SnapshotHeader) == 216, "snapshot header layout changed");
+static_assert(sizeof(SnapshotRoad) == 88, "snapshot road layout changed");
+static_assert(sizeof(SnapshotLane) == 8, "snapshot lane layout changed");
+static_assert(sizeof(SnapshotEntry) == 32, "snapshot entry layout changed");
+static_assert(sizeof(SnapshotMerge) == 16, "snapshot merge layout changed");
+static_assert(sizeof(SnapshotZone) == 16, "snapshot zone layout changed");
+static_assert(sizeof(SnapshotBusStop) == 16, "snapshot bus stop layout changed");
+static_assert(sizeof(SnapshotTrafficLight) == 32, "snapshot traffic light layout changed");
+static_assert(sizeof(SnapshotVehicle) == 160, "snapshot vehicle layout changed");
+
+namespace
+{
+    template<typename T>
+    int32_t indexOf(const std::unordered_map<const T*, uint32_t>& kIndices, const T* kObject)
+    {
+        if(kObject == NULL) return -1;
+        const typename std::unordered_map<const T*, uint32_t>::const_iterator kFound = kIndices.find(kObject);
+        return kFound == kIndices.end() ? -1 : kFound->second;
+    }
+
+    uint64_t addString(std::string& strings, const std::string& kString)
+    {
+        const uint64_t kOffset = strings.size();
+        strings += kString;
+        return kOffset;
+    }
+
+    uint64_t padded(const uint64_t kBytes)
+    {
+        return (kBytes + 7) / 8 * 8;
+    }
+
+    void writeSection(std::ofstream& file, const void* kData, const uint64_t kBytes)
+    {
+        static const char kPadding[8] = {};
+        file.write(static_cast<const char*>(kData), kBytes);
+        file.write(kPadding, padded(kBytes) - kBytes);
+    }
+}
+
+bool SnapshotExporter::save(const Network* const kNetwork, const std::string& kPath)
+{
+    REQUIRE(kNetwork->properlyInitialized(), "Network was not initialized when calling save");
+
+    const std::vector<Road*>& kRoads = kNetwork->getRoads();
+    std::unordered_map<const Road*, uint32_t> roadIndices;
+    std::unordered_map<const BusStop*, uint32_t> busStopIndices;
+    std::unordered_map<const TrafficLight*, uint32_t> trafficLightIndices;
+    std::unordered_map<const IVehicle*, uint32_t> vehicleIndices;
+    std::vector<const IVehicle*> vehicles;
+    uint32_t numBusStops = 0;
+    uint32_t numTrafficLights = 0;
+
+    // number every object first, signs and vehicles can refer to objects on other roads
+    for(uint32_t i = 0; i < kRoads.size(); i++)
+    {
+        const Road* kRoad = kRoads[i];
+        roadIndices[kRoad] = i;
+        for(uint32_t j = 0; j < kRoad->fBusStops.size(); j++) busStopIndices[kRoad->fBusStops[j]] = numBusStops++;
+        for(uint32_t j = 0; j < kRoad->fTrafficLights.size(); j++) trafficLightIndices[kRoad->fTrafficLights[j]] = numTrafficLights++;
+        for(uint32_t j = 0; j < kRoad->getNumLanes(); j++)
+        {
+            const Lane& kLane = kRoad->getLane(j);
+            for(uint32_t k = 0; k < kLane.size(); k++)
+            {
+                if(kLane.getFlags(k) & Lane::kGhost) continue;     // a merging vehicle is saved with its new lane
+                vehicleIndices[kLane[k]] = vehicles.size();
+                vehicles.push_back(kLane[k]);
+            }
+        }
+    }
+
+    std::vector<SnapshotRoad> roads;
+    std::vector<SnapshotLane> lanes;
+    std::vector<SnapshotEntry> entries;
+    std::vector<SnapshotMerge> merges;
+    std::vector<SnapshotZone> zones;
+    std::vector<SnapshotBusStop> busStops;
+    std::vector<SnapshotTrafficLight> trafficLights;
+    std::vector<SnapshotVehicle> vehicleRecords;
+    std::string strings;
+
+    for(uint32_t i = 0; i < kRoads.size(); i++)
+    {
+        const Road* kRoad = kRoads[i];
+        SnapshotRoad road = SnapshotRoad();
+        road.fName = addString(strings, kRoad->getName());
+        road.fNameLength = kRoad->getName().size();
+        road.fNextRoad = indexOf(roadIndices, kRoad->getNextRoad());
+        road.fLength = kRoad->getRoadLength();
+
+        road.fFirstLane = lanes.size();
+        road.fNumLanes = kRoad->getNumLanes();
+        for(uint32_t j = 0; j < kRoad->getNumLanes(); j++)
+        {
+            const Lane& kLane = kRoad->getLane(j);
+            const SnapshotLane kRecord = {static_cast<uint32_t>(entries.size()), kLane.size()};
+            lanes.push_back(kRecord);
+            for(uint32_t k = 0; k < kLane.size(); k++)
+            {
+                SnapshotEntry entry = SnapshotEntry();
+                entry.fPosition = kLane.getPosition(k);
+                entry.fVelocity = kLane.getVelocity(k);
+                entry.fAcceleration = kLane.getAcceleration(k);
+                entry.fVehicle = indexOf(vehicleIndices, kLane[k]);
+                entry.fFlags = kLane.getFlags(k);
+                entries.push_back(entry);
+            }
+        }
+
+        road.fFirstZone = zones.size();
+        road.fNumZones = kRoad->fZones.size();
+        for(uint32_t j = 0; j < kRoad->fZones.size(); j++)
+        {
+            const SnapshotZone kRecord = {kRoad->fZones[j]->getPosition(), kRoad->fZones[j]->getSpeedlimit()};
+            zones.push_back(kRecord);
+        }
+
+        road.fFirstBusStop = busStops.size();
+        road.fNumBusStops = kRoad->fBusStops.size();
+        for(uint32_t j = 0; j < kRoad->fBusStops.size(); j++)
+        {
+            const BusStop* kStop = kRoad->fBusStops[j];
+            const SnapshotBusStop kRecord = {kStop->fPosition, indexOf(vehicleIndices, kStop->fStationed), kStop->fTimer};
+            busStops.push_back(kRecord);
+        }
+
+        road.fFirstTrafficLight = trafficLights.size();
+        road.fNumTrafficLights = kRoad->fTrafficLights.size();
+        for(uint32_t j = 0; j < kRoad->fTrafficLights.size(); j++)
+        {
+            const TrafficLight* kLight = kRoad->fTrafficLights[j];
+            const SnapshotTrafficLight kRecord = {kLight->fPosition, indexOf(vehicleIndices, kLight->fkInRange),
+                                                  static_cast<uint32_t>(kLight->fColor), kLight->fRedTime, kLight->fGreenTime, kLight->fTimer, 0};
+            trafficLights.push_back(kRecord);
+        }
+
+        road.fFirstMerge = merges.size();
+        for(uint32_t j = 0; j < kRoad->fMergeWheel.size(); j++)
+        {
+            for(uint32_t k = 0; k < kRoad->fMergeWheel[j].size(); k++)
+            {
+                const SnapshotMerge kRecord = {j, kRoad->fMergeWheel[j][k].first, static_cast<uint32_t>(indexOf(vehicleIndices, kRoad->fMergeWheel[j][k].second)), 0};
+                merges.push_back(kRecord);
+            }
+        }
+        road.fNumMerges = merges.size() - road.fFirstMerge;
+        road.fMergeTick = kRoad->fMergeTick;
+        road.fSignVersion = kRoad->fSignVersion;
+        road.fNumVehicles = kRoad->fNumVehicles;
+        road.fKernelMismatches = kRoad->fKernelMismatches;
+        roads.push_back(road);
+    }
+
+    for(uint32_t i = 0; i < vehicles.size(); i++)
+    {
+        const IVehicle* kVehicle = vehicles[i];
+        SnapshotVehicle vehicle = SnapshotVehicle();
+        vehicle.fLicensePlate = addString(strings, kVehicle->fLicensePlate);
+        vehicle.fLicenseLength = kVehicle->fLicensePlate.size();
+        vehicle.fType = kVehicle->getKind();
+        vehicle.fMoved = kVehicle->getMoved(kNetwork->fEpoch);
+        vehicle.fStationed = kVehicle->fStationed;
+        vehicle.fMerging = kVehicle->fMerging;
+        vehicle.fLaneChanges = kVehicle->fLaneChanges;
+        vehicle.fPosition = kVehicle->fPosition;
+        vehicle.fVelocity = kVehicle->fVelocity;
+        vehicle.fAcceleration = kVehicle->fAcceleration;
+        for(uint32_t j = 0; j < 5; j++) vehicle.fPrevAcceleration[j] = kVehicle->fPrevAcceleration[j];
+        vehicle.fPrevIndex = kVehicle->fPrevIndex;
+        vehicle.fTrafficLightSlowing = std::get<0>(kVehicle->fTrafficLightAccel);
+        vehicle.fTrafficLightAccel = std::get<1>(kVehicle->fTrafficLightAccel);
+        vehicle.fTrafficLight = indexOf(trafficLightIndices, std::get<2>(kVehicle->fTrafficLightAccel));
+        vehicle.fBusStopSlowing = std::get<0>(kVehicle->fBusStopAccel);
+        vehicle.fBusStopAccel = std::get<1>(kVehicle->fBusStopAccel);
+        vehicle.fBusStop = indexOf(busStopIndices, std::get<2>(kVehicle->fBusStopAccel));
+        vehicle.fSignRoad = indexOf(roadIndices, kVehicle->fSignRoad);
+        vehicle.fSignVersion = kVehicle->fSignVersion;
+        vehicle.fTrafficLightIndex = kVehicle->fTrafficLightIndex;
+        vehicle.fBusStopIndex = kVehicle->fBusStopIndex;
+        vehicle.fZoneIndex = kVehicle->fZoneIndex;
+        vehicle.fTimer = kVehicle->fTimer;
+        vehicle.fDriveTimer = kVehicle->fDriveTimer;
+        vehicle.fDistance = kVehicle->fDistance;
+        vehicle.fMaxVelocity = kVehicle->fMaxVelocity;
+        vehicleRecords.push_back(vehicle);
+    }
+
+    SnapshotHeader header = SnapshotHeader();
+    std::memcpy(header.fMagic, fgkMagic, sizeof(fgkMagic));
+    header.fVersion = fgkVersion;
+    header.fEndianness = fgkEndianness;
+    header.fTicksPassed = kNetwork->fTicksPassed;
+    header.fSteadyCount = kNetwork->fSteadyCount;
+    header.fPrevVelocity = kNetwork->fPrevStatistics.first;
+    header.fPrevFlow = kNetwork->fPrevStatistics.second;
+    for(uint32_t i = 0; i < 3; i++) header.fOutputSizes[i] = kNetwork->fOutputSizes[i];
+
+    const void* kData[kSnapshotSections] = {roads.data(), lanes.data(), entries.data(), merges.data(), zones.data(),
+                                            busStops.data(), trafficLights.data(), vehicleRecords.data(), strings.data()};
+    header.fCounts[kSnapshotRoads] = roads.size();
+    header.fCounts[kSnapshotLanes] = lanes.size();
+    header.fCounts[kSnapshotEntries] = entries.size();
+    header.fCounts[kSnapshotMerges] = merges.size();
+    header.fCounts[kSnapshotZones] = zones.size();
+    header.fCounts[kSnapshotBusStops] = busStops.size();
+    header.fCounts[kSnapshotTrafficLights] = trafficLights.size();
+    header.fCounts[kSnapshotVehicles] = vehicleRecords.size();
+    header.fCounts[kSnapshotStrings] = strings.size();
+
+    uint64_t offset = sizeof(SnapshotHeader);
+    for(uint32_t i = 0; i < kSnapshotSections; i++)
+    {
+        header.fOffsets[i] = offset;
+        offset += padded(header.fCounts[i] * fgkRecordSizes[i]);
+    }
+    header.fSize = offset;
+
+    std::ofstream file(kPath.c_str(), std::ios::binary);
+    if(not file.is_open()) return false;
+    writeSection(file, &header, sizeof(header));
+    for(uint32_t i = 0; i < kSnapshotSections; i++) writeSection(file, kData[i], header.fCounts[i] * fgkRecordSizes[i]);
+    file.close();
+    return not file.fail();
+}
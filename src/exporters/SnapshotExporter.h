@@ -0,0 +1,162 @@
+//============================================================================
+// @name        : SnapshotExporter.h
+// @author      : Thomas Dooms
+// @date        : 5/26/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : writes the complete state of a network to a binary snapshot that can be mapped back in
+//============================================================================
+
+#ifndef SIMULATION_SNAPSHOTEXPORTER_H
+#define SIMULATION_SNAPSHOTEXPORTER_H
+
+#include <stdint.h>
+#include <string>
+#include "../datatypes/Network.h"
+
+/**
+ * A snapshot is a header followed by sections of fixed size records, every section starts at a multiple of 8 bytes
+ * so the records can be read straight from a mapped file. Roads, signs and vehicles refer to each other by their
+ * index in their section, -1 is no object. Names and license plates are stored in the string section.
+ * The snapshot holds the dynamic state as well, a network that is loaded again continues exactly where it was.
+ */
+enum ESnapshotSection {kSnapshotRoads, kSnapshotLanes, kSnapshotEntries, kSnapshotMerges, kSnapshotZones,
+                       kSnapshotBusStops, kSnapshotTrafficLights, kSnapshotVehicles, kSnapshotStrings, kSnapshotSections};
+
+struct SnapshotHeader
+{
+    char fMagic[8];
+    uint32_t fVersion;
+    uint32_t fEndianness;       // fgkEndianness as written by the machine that made the snapshot
+    uint64_t fSize;             // size of the whole file, so truncated files are detected
+    int32_t fTicksPassed;
+    uint32_t fSteadyCount;
+    double fPrevVelocity;
+    double fPrevFlow;
+    uint64_t fOutputSizes[3];   // sizes of the statistics, simple and impression output when the snapshot is a checkpoint
+    uint64_t fCounts[kSnapshotSections];
+    uint64_t fOffsets[kSnapshotSections];
+};
+
+struct SnapshotRoad
+{
+    uint64_t fName;
+    uint32_t fNameLength;
+    int32_t fNextRoad;
+    double fLength;
+    uint32_t fFirstLane;
+    uint32_t fNumLanes;
+    uint32_t fFirstZone;
+    uint32_t fNumZones;
+    uint32_t fFirstBusStop;
+    uint32_t fNumBusStops;
+    uint32_t fFirstTrafficLight;
+    uint32_t fNumTrafficLights;
+    uint32_t fFirstMerge;
+    uint32_t fNumMerges;
+    uint32_t fMergeTick;
+    uint32_t fSignVersion;
+    uint32_t fNumVehicles;
+    uint32_t fPadding;
+    uint64_t fKernelMismatches;
+};
+
+struct SnapshotLane
+{
+    uint32_t fFirstEntry;
+    uint32_t fNumEntries;
+};
+
+struct SnapshotEntry         // a vehicle in a lane, with the state the lane has stored of it
+{
+    double fPosition;
+    double fVelocity;
+    double fAcceleration;
+    uint32_t fVehicle;
+    uint8_t fFlags;
+    uint8_t fPadding[3];
+};
+
+struct SnapshotMerge         // a merging vehicle in the merge wheel of a road, fLane is its old lane
+{
+    uint32_t fBucket;
+    uint32_t fLane;
+    uint32_t fVehicle;
+    uint32_t fPadding;
+};
+
+struct SnapshotZone
+{
+    double fPosition;
+    double fSpeedLimit;
+};
+
+struct SnapshotBusStop
+{
+    double fPosition;
+    int32_t fStationed;
+    uint32_t fTimer;
+};
+
+struct SnapshotTrafficLight
+{
+    double fPosition;
+    int32_t fInRange;
+    uint32_t fColor;
+    uint32_t fRedTime;
+    uint32_t fGreenTime;
+    uint32_t fTimer;
+    uint32_t fPadding;
+};
+
+struct SnapshotVehicle
+{
+    uint64_t fLicensePlate;
+    uint32_t fLicenseLength;
+    uint8_t fType;
+    uint8_t fMoved;
+    uint8_t fStationed;
+    uint8_t fMerging;
+    uint8_t fLaneChanges;
+    uint8_t fTrafficLightSlowing;
+    uint8_t fBusStopSlowing;
+    uint8_t fPadding;
+    uint32_t fPrevIndex;
+    double fPosition;
+    double fVelocity;
+    double fAcceleration;
+    double fPrevAcceleration[5];
+    double fTrafficLightAccel;
+    double fBusStopAccel;
+    int32_t fTrafficLight;
+    int32_t fBusStop;
+    int32_t fSignRoad;
+    uint32_t fSignVersion;
+    uint32_t fTrafficLightIndex;
+    uint32_t fBusStopIndex;
+    uint32_t fZoneIndex;
+    uint32_t fTimer;
+    uint32_t fDriveTimer;
+    uint32_t fPadding2;
+    double fDistance;
+    double fMaxVelocity;
+};
+
+class SnapshotExporter
+{
+public:
+    /**
+     * writes the network to kPath, the network must be between two ticks. Returns false if the file can not be written.
+     *
+     * REQUIRE(kNetwork->properlyInitialized(), "Network was not initialized when calling save");
+     */
+    static bool save(const Network* kNetwork, const std::string& kPath);
+
+    static const char fgkMagic[8];
+    static const uint32_t fgkVersion;                       // changes every time the layout of the records changes
+    static const uint32_t fgkEndianness;
+    static const uint64_t fgkRecordSizes[kSnapshotSections];
+};
+
+
+#endif //SIMULATION_SNAPSHOTEXPORTER_H
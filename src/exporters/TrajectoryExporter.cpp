@@ -0,0 +1,282 @@
+//============================================================================
+// @name        : TrajectoryExporter.cpp
+// @author      : Thomas Dooms
+// @date        : 5/28/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : writes the state of every vehicle after a tick to a columnar binary trajectory
+//============================================================================
+
+#include <cmath>
+#include <cstring>
+#include "TrajectoryExporter.h"
+#include "ExportPipeline.h"
+#include "../DesignByContract.h"
+
+const char TrajectoryExporter::fgkMagic[8] = {'S', 'I', 'M', 'T', 'R', 'A', 'J', '\0'};
+const uint32_t TrajectoryExporter::fgkVersion = 1;
+const uint32_t TrajectoryExporter::fgkEndianness = 0x01020304;
+const uint32_t TrajectoryExporter::fgkDefaultChunkBlocks = 64;
+const double TrajectoryExporter::fgkResolution[3] = {0.001, 0.001, 0.001};
+
+std::ofstream TrajectoryExporter::fgFile;
+TrajectoryHeader TrajectoryExporter::fgHeader;
+std::vector<TrajectoryChunk> TrajectoryExporter::fgChunks;
+std::vector<std::string> TrajectoryExporter::fgRoads;
+std::vector<std::pair<uint8_t, std::string> > TrajectoryExporter::fgVehicles;
+std::unordered_map<const IVehicle*, uint32_t> TrajectoryExporter::fgIds;
+std::vector<std::pair<const IVehicle*, uint32_t> > TrajectoryExporter::fgOrder;
+std::vector<int64_t> TrajectoryExporter::fgPrevious;
+std::vector<uint64_t> TrajectoryExporter::fgPreviousBlock;
+bool TrajectoryExporter::_initCheck = false;
+
+// the layout is part of the format, a change here needs a new fgkVersion
+static_assert(sizeof(TrajectoryHeader) == 112, "trajectory header layout changed");
+static_assert(sizeof(TrajectoryBlock) == 16, "trajectory block layout changed");
+static_assert(sizeof(TrajectoryChunk) == 16, "trajectory chunk layout changed");
+
+namespace
+{
+    void putVarint(std::string& out, uint64_t value)
+    {
+        while(value >= 0x80)
+        {
+            out += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    // small negative numbers become small positive numbers, so they fit in few bytes as well
+    void putSigned(std::string& out, const int64_t kValue)
+    {
+        putVarint(out, (static_cast<uint64_t>(kValue) << 1) ^ static_cast<uint64_t>(kValue >> 63));
+    }
+
+    void putString(std::ofstream& file, const std::string& kString)
+    {
+        const uint32_t kLength = kString.size();
+        file.write(reinterpret_cast<const char*>(&kLength), sizeof(kLength));
+        file.write(kString.data(), kLength);
+    }
+}
+
+// the vehicles of the network after a tick, encoded and written by the export pipeline
+class TrajectoryExporter::BlockJob : public IExportJob
+{
+public:
+    BlockJob(const Network* kNetwork, const uint32_t kTick) : fTick(kTick), fEncoding(fgHeader.fEncoding)
+    {
+        const std::vector<Road*>& kRoads = kNetwork->getRoads();
+        std::vector<std::pair<const IVehicle*, uint32_t> > order;
+        order.reserve(fgOrder.size());
+        uint32_t cursor = 0;
+        for(uint32_t i = 0; i < kRoads.size(); i++)
+        {
+            const Road* kRoad = kRoads[i];
+            for(uint32_t j = 0; j < kRoad->getNumLanes(); j++)
+            {
+                const Lane& kLane = kRoad->getLane(j);
+                for(uint32_t k = 0; k < kLane.size(); k++)
+                {
+                    if(kLane.getFlags(k) & Lane::kGhost) continue;     // a merging vehicle is written with its new lane
+                    const IVehicle* kVehicle = kLane[k];
+
+                    // most vehicles are copied in the same order as in the previous block, so they are looked for there first
+                    uint32_t next = cursor;
+                    while(next < fgOrder.size() and next < cursor + 4 and fgOrder[next].first != kVehicle) next++;
+                    if(next < fgOrder.size() and fgOrder[next].first == kVehicle)
+                    {
+                        fIds.push_back(fgOrder[next].second);
+                        cursor = next + 1;
+                    }
+                    else
+                    {
+                        // ids are handed out here, the jobs are made in the order of the ticks
+                        const std::pair<std::unordered_map<const IVehicle*, uint32_t>::iterator, bool> kId =
+                                fgIds.insert(std::make_pair(kVehicle, fgVehicles.size()));
+                        if(kId.second) fgVehicles.push_back(std::make_pair(kVehicle->getKind(), kVehicle->getLicensePlate()));
+                        fIds.push_back(kId.first->second);
+                    }
+                    order.push_back(std::make_pair(kVehicle, fIds.back()));
+
+                    fRoads.push_back(i);
+                    fLanes.push_back(j);
+                    fValues[0].push_back(kVehicle->getPosition());
+                    fValues[1].push_back(kVehicle->getVelocity());
+                    fValues[2].push_back(kVehicle->getAcceleration());
+                }
+            }
+        }
+        fNumIds = fgVehicles.size();
+        fgOrder.swap(order);
+    }
+
+    virtual void format()
+    {
+        if(fEncoding != kTrajectoryDelta) return;
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            fRounded[i].resize(fValues[i].size());
+            for(uint32_t j = 0; j < fValues[i].size(); j++) fRounded[i][j] = std::llround(fValues[i][j] / fgkResolution[i]);
+        }
+    }
+
+    // the delta encoding refers to the previous block, so it is done here where the blocks come in order
+    virtual void write()
+    {
+        const uint64_t kBlock = fgHeader.fNumBlocks++;
+        const uint64_t kOffset = fgFile.tellp();
+        const bool kFirst = kBlock % fgHeader.fChunkBlocks == 0;
+        if(kFirst)
+        {
+            const TrajectoryChunk kChunk = {kOffset, fTick, fTick};
+            fgChunks.push_back(kChunk);
+        }
+        else fgChunks.back().fLastTick = fTick;
+
+        const uint32_t kCount = fIds.size();
+        TrajectoryBlock block = {fTick, kCount, 0};
+        if(fEncoding == kTrajectoryRaw)
+        {
+            block.fBytes = kCount * (3 * sizeof(uint32_t) + 3 * sizeof(double));
+            fgFile.write(reinterpret_cast<const char*>(&block), sizeof(block));
+            fgFile.write(reinterpret_cast<const char*>(fIds.data()), kCount * sizeof(uint32_t));
+            fgFile.write(reinterpret_cast<const char*>(fRoads.data()), kCount * sizeof(uint32_t));
+            fgFile.write(reinterpret_cast<const char*>(fLanes.data()), kCount * sizeof(uint32_t));
+            for(uint32_t i = 0; i < 3; i++) fgFile.write(reinterpret_cast<const char*>(fValues[i].data()), kCount * sizeof(double));
+            return;
+        }
+
+        std::string out;
+        out.reserve(kCount * 8);
+        const std::vector<uint32_t>* kColumns[3] = {&fIds, &fRoads, &fLanes};
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            int64_t previous = 0;
+            for(uint32_t j = 0; j < kCount; j++)
+            {
+                putSigned(out, int64_t((*kColumns[i])[j]) - previous);
+                previous = (*kColumns[i])[j];
+            }
+        }
+
+        if(fgPreviousBlock.size() < fNumIds)
+        {
+            fgPrevious.resize(3 * fNumIds, 0);
+            fgPreviousBlock.resize(fNumIds, 0);
+        }
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            for(uint32_t j = 0; j < kCount; j++)
+            {
+                const uint32_t kId = fIds[j];
+                const int64_t kReference = not kFirst and fgPreviousBlock[kId] == kBlock ? fgPrevious[3 * kId + i] : 0;
+                putSigned(out, fRounded[i][j] - kReference);
+            }
+        }
+        for(uint32_t j = 0; j < kCount; j++)
+        {
+            const uint32_t kId = fIds[j];
+            for(uint32_t i = 0; i < 3; i++) fgPrevious[3 * kId + i] = fRounded[i][j];
+            fgPreviousBlock[kId] = kBlock + 1;
+        }
+
+        block.fBytes = out.size();
+        fgFile.write(reinterpret_cast<const char*>(&block), sizeof(block));
+        fgFile.write(out.data(), out.size());
+    }
+
+    virtual uint64_t getSize() const
+    {
+        return sizeof(*this) + fIds.size() * (3 * sizeof(uint32_t) + 3 * sizeof(double) + 3 * sizeof(int64_t));
+    }
+
+private:
+    const uint32_t fTick;
+    const uint32_t fEncoding;
+    uint32_t fNumIds;       // the amount of vehicles that had an id when the job was made
+    std::vector<uint32_t> fIds;
+    std::vector<uint32_t> fRoads;
+    std::vector<uint32_t> fLanes;
+    std::vector<double> fValues[3];     // position, velocity and acceleration
+    std::vector<int64_t> fRounded[3];   // the values in steps of fgkResolution, for the delta encoding
+};
+
+void TrajectoryExporter::init(const Network* const kNetwork, const std::string& kPath, const ETrajectoryEncoding kEncoding,
+                              const uint32_t kChunkBlocks)
+{
+    REQUIRE(kNetwork, "Failed to export trajectory: no network");
+    REQUIRE(kChunkBlocks > 0, "A chunk holds at least one block");
+    int res = system("mkdir outputfiles >/dev/null 2>&1");
+    ENSURE(res == 0 or res == 256, "Failed to create output directory");
+
+    fgFile.open(("outputfiles/" + kPath + ".traj").c_str(), std::ios::binary | std::ios::trunc);
+    _initCheck = fgFile.is_open();
+    ENSURE(properlyInitialized(), "Failed to open file for trajectory output");
+
+    fgHeader = TrajectoryHeader();
+    std::memcpy(fgHeader.fMagic, fgkMagic, sizeof(fgkMagic));
+    fgHeader.fVersion = fgkVersion;
+    fgHeader.fEndianness = fgkEndianness;
+    fgHeader.fEncoding = kEncoding;
+    fgHeader.fChunkBlocks = kChunkBlocks;
+    for(uint32_t i = 0; i < 3; i++) fgHeader.fResolution[i] = fgkResolution[i];
+
+    // the header is written again by finish, a trajectory that is not finished has size 0
+    fgFile.write(reinterpret_cast<const char*>(&fgHeader), sizeof(fgHeader));
+
+    fgChunks.clear();
+    fgRoads.clear();
+    fgVehicles.clear();
+    fgIds.clear();
+    fgOrder.clear();
+    fgPrevious.clear();
+    fgPreviousBlock.clear();
+    for(uint32_t i = 0; i < kNetwork->getRoads().size(); i++) fgRoads.push_back(kNetwork->getRoads()[i]->getName());
+}
+
+void TrajectoryExporter::addSection(const Network* const kNetwork, const uint32_t kTick)
+{
+    REQUIRE(properlyInitialized(), "TrajectoryExporter was not initialized when calling addSection");
+    REQUIRE(kNetwork, "Failed to add section: no network");
+    ExportPipeline::push(new BlockJob(kNetwork, kTick));
+}
+
+void TrajectoryExporter::finish()
+{
+    REQUIRE(properlyInitialized(), "TrajectoryExporter was not initialized when calling finish");
+    ExportPipeline::flush();
+
+    fgHeader.fNumChunks = fgChunks.size();
+    fgHeader.fChunksOffset = fgFile.tellp();
+    fgFile.write(reinterpret_cast<const char*>(fgChunks.data()), fgChunks.size() * sizeof(TrajectoryChunk));
+
+    fgHeader.fNumRoads = fgRoads.size();
+    fgHeader.fRoadsOffset = fgFile.tellp();
+    for(uint32_t i = 0; i < fgRoads.size(); i++) putString(fgFile, fgRoads[i]);
+
+    fgHeader.fNumVehicles = fgVehicles.size();
+    fgHeader.fVehiclesOffset = fgFile.tellp();
+    for(uint32_t i = 0; i < fgVehicles.size(); i++)
+    {
+        fgFile.write(reinterpret_cast<const char*>(&fgVehicles[i].first), sizeof(uint8_t));
+        putString(fgFile, fgVehicles[i].second);
+    }
+
+    fgHeader.fSize = fgFile.tellp();
+    fgFile.seekp(0);
+    fgFile.write(reinterpret_cast<const char*>(&fgHeader), sizeof(fgHeader));
+    fgFile.close();
+
+    fgIds.clear();
+    fgOrder.clear();
+    fgPrevious.clear();
+    fgPreviousBlock.clear();
+    _initCheck = false;
+}
+
+bool TrajectoryExporter::properlyInitialized()
+{
+    return _initCheck;
+}
@@ -0,0 +1,120 @@
+//============================================================================
+// @name        : TrajectoryExporter.h
+// @author      : Thomas Dooms
+// @date        : 5/28/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : writes the state of every vehicle after a tick to a columnar binary trajectory
+//============================================================================
+
+#ifndef SIMULATION_TRAJECTORYEXPORTER_H
+#define SIMULATION_TRAJECTORYEXPORTER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include "../datatypes/Network.h"
+
+/**
+ * A trajectory is a header, a block for every exported tick and the tables the header points to. A block holds
+ * the vehicles of one tick column by column: ids, roads, lanes, positions, velocities and accelerations.
+ * Raw blocks store the columns as they are. Delta blocks store every value as a zigzag varint: the ids, roads and
+ * lanes relative to the previous vehicle of the block and the rounded position, velocity and acceleration relative
+ * to the same vehicle in the previous block of the chunk, so only the first block of a chunk has to be decoded
+ * without the others. The chunk index holds the offset of the first block of every chunk, so any tick is found
+ * without reading the blocks before its chunk.
+ */
+enum ETrajectoryEncoding {kTrajectoryRaw, kTrajectoryDelta};
+
+struct TrajectoryHeader
+{
+    char fMagic[8];
+    uint32_t fVersion;
+    uint32_t fEndianness;       // fgkEndianness as written by the machine that made the trajectory
+    uint32_t fEncoding;
+    uint32_t fChunkBlocks;      // amount of blocks in every chunk except the last one
+    double fResolution[3];      // the step of the position, velocity and acceleration in delta blocks
+    uint64_t fSize;             // size of the whole file, 0 while it is still written
+    uint64_t fNumBlocks;
+    uint64_t fNumChunks;
+    uint64_t fChunksOffset;     // the chunk index
+    uint64_t fNumRoads;
+    uint64_t fRoadsOffset;      // the names of the roads, a road id is an index in this table
+    uint64_t fNumVehicles;
+    uint64_t fVehiclesOffset;   // the type and license plate of the vehicles, a vehicle id is an index in this table
+};
+
+struct TrajectoryBlock
+{
+    uint32_t fTick;
+    uint32_t fCount;            // amount of vehicles in the block
+    uint64_t fBytes;            // size of the columns that follow the block header
+};
+
+struct TrajectoryChunk
+{
+    uint64_t fOffset;           // offset of the first block of the chunk
+    uint32_t fFirstTick;
+    uint32_t fLastTick;
+};
+
+class TrajectoryExporter
+{
+public:
+    /**
+     * creates outputfiles/kPath.traj, a new chunk starts every kChunkBlocks blocks
+     *
+     * REQUIRE(kNetwork, "Failed to export trajectory: no network");
+     * REQUIRE(kChunkBlocks > 0, "A chunk holds at least one block");
+     * ENSURE(res == 0 or res == 256, "Failed to create output directory");
+     * ENSURE(properlyInitialized(), "Failed to open file for trajectory output");
+     */
+    static void init(const Network* kNetwork, const std::string& kPath, ETrajectoryEncoding kEncoding,
+                     uint32_t kChunkBlocks = fgkDefaultChunkBlocks);
+
+    /**
+     * copies the vehicles of the network and hands them to the ExportPipeline to be written as the block of kTick,
+     * a vehicle that is seen for the first time gets the next id
+     *
+     * REQUIRE(properlyInitialized(), "TrajectoryExporter was not initialized when calling addSection");
+     * REQUIRE(kNetwork, "Failed to add section: no network");
+     */
+    static void addSection(const Network* kNetwork, uint32_t kTick);
+
+    /**
+     * writes the tables and the header, the trajectory can only be read after this
+     *
+     * REQUIRE(properlyInitialized(), "TrajectoryExporter was not initialized when calling finish");
+     */
+    static void finish();
+
+    static bool properlyInitialized();
+
+    static const char fgkMagic[8];
+    static const uint32_t fgkVersion;
+    static const uint32_t fgkEndianness;
+    static const uint32_t fgkDefaultChunkBlocks;
+    static const double fgkResolution[3];
+
+private:
+    class BlockJob;
+
+    static std::ofstream fgFile;
+    static TrajectoryHeader fgHeader;
+    static std::vector<TrajectoryChunk> fgChunks;
+    static std::vector<std::string> fgRoads;
+    static std::vector<std::pair<uint8_t, std::string> > fgVehicles;
+    static std::unordered_map<const IVehicle*, uint32_t> fgIds;     // vehicles are only made by the parsers, so they keep their address
+    static std::vector<std::pair<const IVehicle*, uint32_t> > fgOrder;     // the vehicles of the previous block and their ids
+
+    // the rounded state of every vehicle in the previous block of the chunk, only used by the delta encoding
+    static std::vector<int64_t> fgPrevious;
+    static std::vector<uint64_t> fgPreviousBlock;     // the block in which fgPrevious of the vehicle was set, +1
+
+    static bool _initCheck;
+};
+
+
+#endif //SIMULATION_TRAJECTORYEXPORTER_H
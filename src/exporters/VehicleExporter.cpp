@@ -8,31 +8,70 @@
 //============================================================================
 
 #include "VehicleExporter.h"
+#include "NetworkExporter.h"
+#include "ExportPipeline.h"
+#include <sstream>
 
 std::ofstream VehicleExporter::fgFile;
 
-void VehicleExporter::init(const std::string& kPath)
+void VehicleExporter::init(const std::string& kPath, const uint64_t kResume)
 {
     int res = system("mkdir outputfiles >/dev/null 2>&1");
     ENSURE(res == 0 or res == 256, "could not make directory");
-    fgFile.open(("outputfiles/" + kPath + ".txt").c_str());
+    OpenOutput(fgFile, "outputfiles/" + kPath + ".txt", kResume);
     ENSURE(fgFile.is_open(), "output file is not open");
 }
 
+// the statistics of a vehicle that left the network, formatted and written by the export pipeline
+class VehicleExporter::StatisticsJob : public IExportJob
+{
+public:
+    explicit StatisticsJob(const IVehicle* kVehicle) : fLicensePlate(kVehicle->getLicensePlate()), fStatistics(kVehicle->getStatistics()) {}
+
+    virtual void format()
+    {
+        std::ostringstream out;
+        out << "Voertuig: (" + fLicensePlate + ")\n";
+        out << "  -> aantal seconden in simulatie: " << std::get<0>(fStatistics)                                            << " seconden\n";
+        out << "  -> aantal seconden stilstaan   : " << std::get<0>(fStatistics) - std::get<1>(fStatistics)                 << " seconden\n";
+        out << "  -> aantal seconden rijden      : " << std::get<1>(fStatistics)                                            << " seconden\n";
+        out << "  -> gemmidelde snelheid         : " << std::get<2>(fStatistics) / double(std::get<0>(fStatistics)) * 3.6   << " km/h\n";
+        out << "  -> maximale snelheid           : " << std::get<3>(fStatistics)*3.6                                        << " km/h\n";
+        out << "  -> afgelegde weg               : " << std::get<2>(fStatistics)                                            << " m\n\n";
+        fText = out.str();
+    }
+
+    virtual void write()
+    {
+        fgFile << fText;
+    }
+
+    virtual uint64_t getSize() const
+    {
+        return sizeof(*this) + fLicensePlate.size();
+    }
+
+private:
+    const std::string fLicensePlate;
+    const std::tuple<uint32_t, uint32_t, double, double> fStatistics;
+    std::string fText;
+};
+
 void VehicleExporter::addSection(const IVehicle* kVehicle)
 {
-    const std::tuple<uint32_t, uint32_t, double, double> statistics = kVehicle->getStatistics();
-    fgFile << "Voertuig: (" + kVehicle->getLicensePlate() + ")\n";
-    fgFile << "  -> aantal seconden in simulatie: " << std::get<0>(statistics)                                          << " seconden\n";
-    fgFile << "  -> aantal seconden stilstaan   : " << std::get<0>(statistics) - std::get<1>(statistics)                << " seconden\n";
-    fgFile << "  -> aantal seconden rijden      : " << std::get<1>(statistics)                                          << " seconden\n";
-    fgFile << "  -> gemmidelde snelheid         : " << std::get<2>(statistics) / double(std::get<0>(statistics)) * 3.6  << " km/h\n";
-    fgFile << "  -> maximale snelheid           : " << std::get<3>(statistics)*3.6                                      << " km/h\n";
-    fgFile << "  -> afgelegde weg               : " << std::get<2>(statistics)                                          << " m\n\n";
+    ExportPipeline::push(new StatisticsJob(kVehicle));
+}
+
+uint64_t VehicleExporter::getSize()
+{
+    ExportPipeline::flush();
+    fgFile << std::flush;
+    return fgFile.tellp();
 }
 
 void VehicleExporter::finish()
 {
+    ExportPipeline::flush();
     fgFile << std::flush;
     fgFile.close();
 }
\ No newline at end of file
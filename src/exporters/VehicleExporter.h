@@ -19,12 +19,25 @@
 class VehicleExporter
 {
 public:
-    static void init(const std::string& kPath);
-
+    /**
+     * kResume is the size of the output at a checkpoint, the output is continued from there. 0 starts it anew.
+     */
+    static void init(const std::string& kPath, uint64_t kResume = 0);
+
+    /**
+     * copies the statistics of the vehicle and hands them to the ExportPipeline to be written
+     */
     static void addSection(const IVehicle* kVehicle);
 
+    /**
+     * flushes the output and returns its size
+     */
+    static uint64_t getSize();
+
     static void finish();
 private:
+    class StatisticsJob;
+
     static std::ofstream fgFile;
 };
 
@@ -0,0 +1,359 @@
+//============================================================================
+// @name        : generatorMain.cpp
+// @author      : Thomas Dooms
+// @date        : 5/25/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : generates big synthetic networks as NETWERK xml, the same seed always gives the same file
+//============================================================================
+
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "datatypes/vehicles/VehicleTraits.h"
+
+namespace
+{
+    enum ETopology {kChain, kTree, kRing};
+
+    struct GeneratorConfig
+    {
+        uint32_t fRoads;
+        ETopology fTopology;
+        uint32_t fSize;             // roads per chain or ring, children per road of a tree
+        uint32_t fMinLanes;
+        uint32_t fMaxLanes;
+        uint32_t fLength;           // meters per road
+        double fZones;              // per km
+        double fBusStops;           // per km
+        double fTrafficLights;      // per km
+        double fDensity;            // vehicles per km of road
+        uint32_t fMix[4];           // relative amount of cars, buses, motorcycles and trucks
+        uint32_t fSeed;
+    };
+
+    struct RoadSpec
+    {
+        uint32_t fLanes;
+        uint32_t fSpeedLimit;       // km/h
+        int32_t fNext;              // -1 if the road leaves the network
+    };
+
+    struct VehicleKind
+    {
+        const char* fName;
+        double fLength;
+        double fMaxSpeed;           // m/s
+        double fMinAcceleration;    // m/s², negative
+    };
+
+    template<EVehicleType T>
+    VehicleKind kindOf(const char* kName)
+    {
+        const VehicleKind kKind = {kName, VehicleTraits<T>::fgkVehicleLength, VehicleTraits<T>::fgkMaxSpeed, VehicleTraits<T>::fgkMinAcceleration};
+        return kKind;
+    }
+
+    const uint32_t kSpeedLimits[] = {50, 70, 90, 120};
+
+    std::string roadName(const uint32_t kIndex)
+    {
+        return "R" + std::to_string(kIndex);
+    }
+
+    int32_t nextRoad(const GeneratorConfig& kConfig, const uint32_t kIndex)
+    {
+        switch(kConfig.fTopology)
+        {
+            case kChain:
+                return ((kIndex + 1) % kConfig.fSize == 0 or kIndex + 1 == kConfig.fRoads) ? -1 : kIndex + 1;
+            case kTree:
+                return kIndex == 0 ? -1 : (kIndex - 1) / kConfig.fSize;
+            case kRing:
+            {
+                const uint32_t kFirst = kIndex - kIndex % kConfig.fSize;
+                const uint32_t kLength = std::min(kConfig.fSize, kConfig.fRoads - kFirst);
+                return kLength < 2 ? -1 : kFirst + (kIndex - kFirst + 1) % kLength;     // a single road left over is not a ring
+            }
+        }
+        return -1;
+    }
+
+    std::vector<RoadSpec> createRoads(const GeneratorConfig& kConfig, std::mt19937& generator)
+    {
+        std::vector<RoadSpec> roads(kConfig.fRoads);
+        std::uniform_int_distribution<uint32_t> lanes(kConfig.fMinLanes, kConfig.fMaxLanes);
+        std::uniform_int_distribution<uint32_t> limits(0, sizeof(kSpeedLimits) / sizeof(kSpeedLimits[0]) - 1);
+        for(uint32_t i = 0; i < roads.size(); i++)
+        {
+            roads[i].fLanes = lanes(generator);
+            roads[i].fSpeedLimit = kSpeedLimits[limits(generator)];
+            roads[i].fNext = nextRoad(kConfig, i);
+        }
+
+        // a road never has more lanes than the road after it, otherwise the vehicles on the extra lanes are removed
+        bool changed = true;
+        while(changed)
+        {
+            changed = false;
+            for(uint32_t i = 0; i < roads.size(); i++)
+            {
+                if(roads[i].fNext < 0 or roads[roads[i].fNext].fLanes >= roads[i].fLanes) continue;
+                roads[roads[i].fNext].fLanes = roads[i].fLanes;
+                changed = true;
+            }
+        }
+        return roads;
+    }
+
+    // sorted distinct positions between 1 and kLength - 1, kPerKm on average
+    std::vector<uint32_t> createPositions(const double kPerKm, const uint32_t kLength, std::mt19937& generator)
+    {
+        const double kExpected = kPerKm * kLength / 1000;
+        uint32_t count = static_cast<uint32_t>(kExpected);
+        if(std::uniform_real_distribution<double>(0, 1)(generator) < kExpected - count) count++;
+
+        std::vector<uint32_t> positions;
+        if(kLength < 2) return positions;
+        std::uniform_int_distribution<uint32_t> position(1, kLength - 1);
+        for(uint32_t i = 0; i < count; i++) positions.push_back(position(generator));
+
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+        return positions;
+    }
+
+    void writeRoad(std::ostream& out, const uint32_t kIndex, const RoadSpec& kRoad, const uint32_t kLength)
+    {
+        out << "    <BAAN>\n"
+            << "        <naam>" << roadName(kIndex) << "</naam>\n"
+            << "        <snelheidslimiet>" << kRoad.fSpeedLimit << "</snelheidslimiet>\n"
+            << "        <lengte>" << kLength << "</lengte>\n";
+        if(kRoad.fNext >= 0) out << "        <verbinding>" << roadName(kRoad.fNext) << "</verbinding>\n";
+        out << "        <rijstroken>" << kRoad.fLanes << "</rijstroken>\n"
+            << "    </BAAN>\n";
+    }
+
+    void writeSigns(std::ostream& out, const GeneratorConfig& kConfig, const uint32_t kIndex, std::mt19937& generator)
+    {
+        const std::string kName = roadName(kIndex);
+        const std::vector<uint32_t> kLights = createPositions(kConfig.fTrafficLights, kConfig.fLength, generator);
+        const std::vector<uint32_t> kStops = createPositions(kConfig.fBusStops, kConfig.fLength, generator);
+        const std::vector<uint32_t> kZones = createPositions(kConfig.fZones, kConfig.fLength, generator);
+        std::uniform_int_distribution<uint32_t> limits(0, sizeof(kSpeedLimits) / sizeof(kSpeedLimits[0]) - 1);
+
+        for(uint32_t i = 0; i < kLights.size(); i++)
+        {
+            out << "    <VERKEERSTEKEN>\n        <type>VERKEERSLICHT</type>\n        <baan>" << kName
+                << "</baan>\n        <positie>" << kLights[i] << "</positie>\n    </VERKEERSTEKEN>\n";
+        }
+        for(uint32_t i = 0; i < kStops.size(); i++)
+        {
+            out << "    <VERKEERSTEKEN>\n        <type>BUSHALTE</type>\n        <baan>" << kName
+                << "</baan>\n        <positie>" << kStops[i] << "</positie>\n    </VERKEERSTEKEN>\n";
+        }
+        for(uint32_t i = 0; i < kZones.size(); i++)
+        {
+            out << "    <VERKEERSTEKEN>\n        <type>ZONE</type>\n        <baan>" << kName
+                << "</baan>\n        <positie>" << kZones[i] << "</positie>\n        <snelheidslimiet>"
+                << kSpeedLimits[limits(generator)] << "</snelheidslimiet>\n    </VERKEERSTEKEN>\n";
+        }
+    }
+
+    // the highest speed, at most kMaxSpeed, from which a vehicle stops within kRoom meters when it brakes like the
+    // engine does: a velocity between n and n + 1 times the braking covers n * v - braking * n * (n + 1) / 2
+    double stoppingSpeed(const double kRoom, const double kMaxSpeed, const double kMinAcceleration)
+    {
+        if(kRoom < 0) return 0;
+        const double kBraking = -kMinAcceleration;
+        double speed = kBraking;
+        for(uint32_t n = 1; n * kBraking < kMaxSpeed; n++)
+        {
+            const double kSpeed = std::min((n + 1) * kBraking, (kRoom + kBraking * n * (n + 1) / 2) / n);
+            if(kSpeed <= n * kBraking) break;
+            speed = kSpeed;
+        }
+        return std::min(speed, kMaxSpeed);
+    }
+
+    /**
+     * the vehicles are placed from the end of the road to the start with a random gap around 1000 / density.
+     * Every vehicle starts as fast as it can while it can still brake for the vehicle in front of it, so the network
+     * starts without collisions.
+     * Returns the amount of vehicles.
+     */
+    uint64_t writeVehicles(std::ostream& out, const GeneratorConfig& kConfig, const uint32_t kIndex, const RoadSpec& kRoad,
+                           std::mt19937& generator, uint64_t& license)
+    {
+        if(kConfig.fDensity <= 0) return 0;
+
+        static const VehicleKind kKinds[] = {kindOf<kCar>("AUTO"), kindOf<kBus>("BUS"), kindOf<kMotorcycle>("MOTORFIETS"), kindOf<kTruck>("VRACHTWAGEN")};
+        std::discrete_distribution<uint32_t> kinds(kConfig.fMix, kConfig.fMix + 4);
+        std::uniform_real_distribution<double> jitter(0.5, 1.5);
+
+        const std::string kName = roadName(kIndex);
+        const double kMeanGap = 1000 / kConfig.fDensity;
+        const double kSpeedLimit = kRoad.fSpeedLimit / 3.6;
+
+        uint64_t count = 0;
+        double position = kConfig.fLength - 6 - std::uniform_real_distribution<double>(0, kMeanGap)(generator);
+        // the free space in front of the vehicle, the first one leaves room for a vehicle at the start of the next road
+        bool leader = kRoad.fNext >= 0;
+        double room = kConfig.fLength - static_cast<uint32_t>(position) - 7;
+        while(position >= 0)
+        {
+            const VehicleKind& kKind = kKinds[kinds(generator)];
+            // every vehicle starts slow enough to brake for the one in front of it, even if that one stands still
+            double speed = std::min(kSpeedLimit, kKind.fMaxSpeed);
+            if(leader) speed = stoppingSpeed(room, speed, kKind.fMinAcceleration);
+
+            out << "    <VOERTUIG>\n        <type>" << kKind.fName << "</type>\n        <nummerplaat>V" << license++
+                << "</nummerplaat>\n        <baan>" << kName << "</baan>\n        <positie>" << static_cast<uint32_t>(position)
+                << "</positie>\n        <snelheid>" << static_cast<uint32_t>(speed * 3.6) << "</snelheid>\n    </VOERTUIG>\n";
+            count++;
+
+            // the next vehicle keeps at least 6 meters between itself and the back of this vehicle
+            const double kDistance = std::max(kMeanGap * jitter(generator), kKind.fLength + 7);
+            leader = true;
+            room = kDistance - 7;
+            position = static_cast<uint32_t>(position) - kDistance;
+        }
+        return count;
+    }
+}
+
+void usage(const char* name)
+{
+    std::cerr << "usage: " << name << " <file.xml> [-n roads] [-g topology] [-c size] [-l lanes] [-u lanes] [-m length] [-z zones] [-b stops] [-s lights] [-d density] [-v mix] [-x seed]\n"
+              << "  -n roads    : amount of roads (default 10)\n"
+              << "  -g topology : chain, tree or ring (default chain)\n"
+              << "  -c size     : roads per chain or ring, children per road of a tree (default 10, 2 for trees)\n"
+              << "  -l lanes    : minimal amount of lanes of a road (default 1)\n"
+              << "  -u lanes    : maximal amount of lanes of a road (default 3)\n"
+              << "  -m length   : length of every road in meters (default 2000)\n"
+              << "  -z zones    : zones per km (default 0.5)\n"
+              << "  -b stops    : bus stops per km (default 0.5)\n"
+              << "  -s lights   : traffic lights per km (default 0.5)\n"
+              << "  -d density  : vehicles per km of road, the gaps are at least the vehicle length plus 7 meters (default 20)\n"
+              << "  -v mix      : relative amount of cars, buses, motorcycles and trucks (default 80,5,7,8)\n"
+              << "  -x seed     : seed of the random generator (default 1)\n";
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const std::string filename = argv[1];
+    GeneratorConfig config = {10, kChain, 0, 1, 3, 2000, 0.5, 0.5, 0.5, 20, {80, 5, 7, 8}, 1};
+    std::string topology = "chain";
+    std::string mix;
+
+    for(int i = 2; i < argc; i++)
+    {
+        if(i + 1 >= argc or std::strlen(argv[i]) != 2 or argv[i][0] != '-')
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        switch(argv[i][1])
+        {
+            case 'n': config.fRoads = std::atoi(argv[++i]); break;
+            case 'g': topology = argv[++i]; break;
+            case 'c': config.fSize = std::atoi(argv[++i]); break;
+            case 'l': config.fMinLanes = std::atoi(argv[++i]); break;
+            case 'u': config.fMaxLanes = std::atoi(argv[++i]); break;
+            case 'm': config.fLength = std::atoi(argv[++i]); break;
+            case 'z': config.fZones = std::atof(argv[++i]); break;
+            case 'b': config.fBusStops = std::atof(argv[++i]); break;
+            case 's': config.fTrafficLights = std::atof(argv[++i]); break;
+            case 'd': config.fDensity = std::atof(argv[++i]); break;
+            case 'v': mix = argv[++i]; break;
+            case 'x': config.fSeed = std::atoi(argv[++i]); break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if(topology == "chain") config.fTopology = kChain;
+    else if(topology == "tree") config.fTopology = kTree;
+    else if(topology == "ring") config.fTopology = kRing;
+    else
+    {
+        std::cerr << "topology must be chain, tree or ring\n";
+        return 1;
+    }
+    if(config.fSize == 0) config.fSize = config.fTopology == kTree ? 2 : 10;
+    if(not mix.empty() and std::sscanf(mix.c_str(), "%u,%u,%u,%u", &config.fMix[0], &config.fMix[1], &config.fMix[2], &config.fMix[3]) != 4)
+    {
+        std::cerr << "mix must be four numbers separated by commas\n";
+        return 1;
+    }
+
+    if(config.fRoads < 1 or config.fLength < 20)
+    {
+        std::cerr << "there must be at least one road of at least 20 meters\n";
+        return 1;
+    }
+    if(config.fMinLanes < 1 or config.fMinLanes > config.fMaxLanes or config.fMaxLanes >= 100)
+    {
+        std::cerr << "the lanes must be between 1 and 99 and the minimum can not be bigger than the maximum\n";
+        return 1;
+    }
+    if(config.fTopology == kRing and config.fSize < 2)
+    {
+        std::cerr << "a ring needs at least two roads\n";
+        return 1;
+    }
+    if(config.fZones < 0 or config.fBusStops < 0 or config.fTrafficLights < 0 or config.fDensity < 0)
+    {
+        std::cerr << "all densities must be positive\n";
+        return 1;
+    }
+    if(config.fMix[0] + config.fMix[1] + config.fMix[2] + config.fMix[3] == 0)
+    {
+        std::cerr << "the mix needs at least one vehicle kind\n";
+        return 1;
+    }
+
+    std::ofstream out(filename.c_str());
+    if(not out.is_open())
+    {
+        std::cerr << "could not open " << filename << '\n';
+        return 1;
+    }
+
+    std::mt19937 generator(config.fSeed);
+    const std::vector<RoadSpec> kRoads = createRoads(config, generator);
+
+    // the parser links the connections to the roads in the order of the roads that have one, so those come first
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<NETWERK>\n";
+    for(uint32_t i = 0; i < kRoads.size(); i++)
+    {
+        if(kRoads[i].fNext >= 0) writeRoad(out, i, kRoads[i], config.fLength);
+    }
+    for(uint32_t i = 0; i < kRoads.size(); i++)
+    {
+        if(kRoads[i].fNext < 0) writeRoad(out, i, kRoads[i], config.fLength);
+    }
+
+    for(uint32_t i = 0; i < kRoads.size(); i++) writeSigns(out, config, i, generator);
+
+    uint64_t license = 0;
+    uint64_t vehicles = 0;
+    for(uint32_t i = 0; i < kRoads.size(); i++) vehicles += writeVehicles(out, config, i, kRoads[i], generator, license);
+    out << "</NETWERK>\n";
+
+    std::cout << "generated " << kRoads.size() << " roads and " << vehicles << " vehicles\n";
+    return 0;
+}
@@ -9,6 +9,8 @@
 
 #include <QtCore/QTime>
 #include "gui.h"
+#include "../datatypes/Network.h"
+#include "../exporters/NetworkExporter.h"
 
 //--------------------------WINDOW CLASS----------------------------------------
 
@@ -218,6 +220,36 @@ void Window::updateSimpleOutput(std::string output)
     fSimpleOutput->setText(output.c_str());
 }
 
+bool Window::beforeTick(const Network* kNetwork)
+{
+    REQUIRE(this->checkProperlyInitialized(), "Window was not properly initialized when calling beforeTick");
+    switch(fCrState)
+    {
+        case kPlay:
+            return true;
+        case kNext:
+            fCrState = kPause;
+            return true;
+        case kPrint:
+            NetworkExporter::cgExport(kNetwork, kNetwork->getTicksPassed());
+            fCrState = kPause;
+            return false;
+        case kQuit:
+            exit(0);
+        default:
+            Window::delay(500);
+            return false;
+    }
+}
+
+void Window::afterTick(const Network* kNetwork)
+{
+    REQUIRE(this->checkProperlyInitialized(), "Window was not properly initialized when calling afterTick");
+    NetworkExporter::cgExport(kNetwork, 0);
+    updateSimpleOutput(NetworkExporter::addSection(kNetwork, kNetwork->getTicksPassed()));
+    Window::processEvents();
+}
+
 void Window::setCrState(Window::EState fCrState) {
     REQUIRE(this->checkProperlyInitialized(), "Window was not properly initialized when calling setCrState");
     Window::fCrState = fCrState;
@@ -34,9 +34,10 @@
 #include "../DesignByContract.h"
 #include "../datatypes/Road.h"
 #include "../datatypes/TrafficSigns.h"
+#include "../datatypes/ISimulationObserver.h"
 
 
-class Window: public QMainWindow
+class Window: public QMainWindow, public ISimulationObserver
 {
 
     Q_OBJECT
@@ -90,6 +91,14 @@ public:
      * REQUIRE(this->checkProperlyInitialized(), "Window was not properly initialized when calling createRoadButtons");
      */
      void updateSimpleOutput(std::string output);
+    /**
+     * REQUIRE(this->checkProperlyInitialized(), "Window was not properly initialized when calling beforeTick");
+     */
+    bool beforeTick(const Network* kNetwork) override;
+    /**
+     * REQUIRE(this->checkProperlyInitialized(), "Window was not properly initialized when calling afterTick");
+     */
+    void afterTick(const Network* kNetwork) override;
 
     static std::string doubleToPrecision(double d, int precision);
 
@@ -0,0 +1,255 @@
+//============================================================================
+// @name        : headlessMain.cpp
+// @author      : Thomas Dooms
+// @date        : 5/20/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : The main function for batch runs of the simulation, without gui
+//============================================================================
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <string>
+#include <chrono>
+#include "parsers/NetworkParser.h"
+#include "parsers/SnapshotParser.h"
+#include "exporters/NetworkExporter.h"
+#include "exporters/SnapshotExporter.h"
+#include "exporters/ExportPipeline.h"
+#include "exporters/TrajectoryExporter.h"
+#include "exporters/ReplayExporter.h"
+#include "datatypes/ISimulationObserver.h"
+
+class BatchObserver : public ISimulationObserver
+{
+public:
+    BatchObserver(const int kInterval, const bool kTrajectory, const bool kReplay)
+            : fInterval(kInterval), fTrajectory(kTrajectory), fReplay(kReplay) {}
+
+    virtual bool beforeTick(const Network*)
+    {
+        return true;
+    }
+
+    virtual void afterTick(const Network* kNetwork)
+    {
+        if(kNetwork->getTicksPassed() % fInterval != 0) return;
+        if(fTrajectory) TrajectoryExporter::addSection(kNetwork, kNetwork->getTicksPassed());
+        else NetworkExporter::addSection(kNetwork, kNetwork->getTicksPassed());
+        if(fReplay) ReplayExporter::addFrame(kNetwork);
+    }
+
+private:
+    const int fInterval;
+    const bool fTrajectory;     // export to the binary trajectory instead of the text outputs
+    const bool fReplay;         // add the cg image of the network to the replay as well
+};
+
+void usage(const char* name)
+{
+    std::cerr << "usage: " << name << " <file.xml|snapshot> [-t ticks] [-w seconds] [-c ticks] [-d delta] [-e interval] [-j threads] [-b buffered] [-k kernel] [-s simple] [-i impression] [-o snapshot] [-p interval] [-a writers] [-f format] [-v video]\n"
+              << "  -t ticks      : maximum amount of ticks to simulate\n"
+              << "  -w seconds    : maximum wall clock time of the simulation\n"
+              << "  -c ticks      : stop once the network has been steady for this amount of ticks\n"
+              << "  -d delta      : maximal relative change of the mean velocity and flow in a steady tick (default 0.001)\n"
+              << "  -e interval   : export the state of the network every interval ticks, 0 disables it (default)\n"
+              << "  -j threads    : amount of threads used to update the independent parts of the network (default 1)\n"
+              << "  -b buffered   : 1 lets every vehicle react to the state of the previous tick, 0 updates them in order (default)\n"
+              << "  -k kernel     : 1 computes whole lanes at once in buffered mode, 2 checks it against the normal update, 0 disables it (default)\n"
+              << "  -s simple     : name of the simple output file in outputfiles\n"
+              << "  -i impression : name of the impression output file in outputfiles\n"
+              << "  -o snapshot   : write the network to a binary snapshot before simulating, it loads much faster than the xml\n"
+              << "  -p interval   : overwrite the snapshot with a checkpoint every interval ticks, a run that is started from\n"
+              << "                  the checkpoint continues the run and its outputs exactly where the checkpoint was taken\n"
+              << "  -a writers    : format and write the outputs on this amount of background threads, 0 writes them during the tick (default)\n"
+              << "  -f format     : text exports the state to the simple and impression output (default), raw or delta export it\n"
+              << "                  to the binary trajectory outputfiles/<simple>.traj instead, delta is smaller but rounds to 1 mm\n"
+              << "  -v video      : ppm or y4m writes the cg image of the network as a frame of the replay outputfiles/<simple>.ppm\n"
+              << "                  or outputfiles/<simple>.y4m every interval ticks, the frames are rendered by the writers (default none)\n";
+}
+
+// parses the whole of kText as an integer
+bool parseInt(const char* kText, int& value)
+{
+    char* end;
+    const long kValue = std::strtol(kText, &end, 10);
+    if(end == kText or *end != '\0' or kValue < INT_MIN or kValue > INT_MAX) return false;
+    value = static_cast<int>(kValue);
+    return true;
+}
+
+// parses the whole of kText as a number
+bool parseDouble(const char* kText, double& value)
+{
+    char* end;
+    value = std::strtod(kText, &end);
+    return end != kText and *end == '\0';
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const std::string filename = argv[1];
+    std::string simple = "simple";
+    std::string impression = "impression";
+    std::string snapshot;
+    int ticks = -1;
+    double seconds = 0;
+    int steadyTicks = 0;
+    double steadyDelta = 0.001;
+    int interval = 0;
+    int threads = 1;
+    int buffered = 0;
+    int kernel = 0;
+    int checkpoints = 0;
+    int writers = 0;
+    std::string format = "text";
+    std::string video = "none";
+
+    for(int i = 2; i < argc; i++)
+    {
+        if(i + 1 >= argc or std::strlen(argv[i]) != 2 or argv[i][0] != '-')
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        bool valid = true;
+        switch(argv[i][1])
+        {
+            case 't': valid = parseInt(argv[++i], ticks) and ticks >= 0; break;
+            case 'w': valid = parseDouble(argv[++i], seconds); break;
+            case 'c': valid = parseInt(argv[++i], steadyTicks); break;
+            case 'd': valid = parseDouble(argv[++i], steadyDelta); break;
+            case 'e': valid = parseInt(argv[++i], interval); break;
+            case 'j': valid = parseInt(argv[++i], threads); break;
+            case 'b': valid = parseInt(argv[++i], buffered); break;
+            case 'k': valid = parseInt(argv[++i], kernel); break;
+            case 's': simple = argv[++i]; break;
+            case 'i': impression = argv[++i]; break;
+            case 'o': snapshot = argv[++i]; break;
+            case 'p': valid = parseInt(argv[++i], checkpoints); break;
+            case 'a': valid = parseInt(argv[++i], writers); break;
+            case 'f': format = argv[++i]; break;
+            case 'v': video = argv[++i]; break;
+            default: valid = false;
+        }
+        if(not valid)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(interval < 0 or steadyTicks < 0 or seconds < 0 or steadyDelta < 0 or checkpoints < 0 or writers < 0)
+    {
+        std::cerr << "all options must be positive\n";
+        return 1;
+    }
+    if(kernel < kKernelOff or kernel > kKernelValidate)
+    {
+        std::cerr << "kernel must be 0, 1 or 2\n";
+        return 1;
+    }
+    if(checkpoints > 0 and snapshot.empty())
+    {
+        std::cerr << "checkpoints need a snapshot file (-o)\n";
+        return 1;
+    }
+    if(format != "text" and format != "raw" and format != "delta")
+    {
+        std::cerr << "format must be text, raw or delta\n";
+        return 1;
+    }
+    if(format != "text" and checkpoints > 0)
+    {
+        std::cerr << "a trajectory can not be continued from a checkpoint, use the text format with -p\n";
+        return 1;
+    }
+    if(video != "none" and video != "ppm" and video != "y4m")
+    {
+        std::cerr << "video must be none, ppm or y4m\n";
+        return 1;
+    }
+    if(video != "none" and interval == 0)
+    {
+        std::cerr << "a replay needs an export interval (-e)\n";
+        return 1;
+    }
+    if(video != "none" and checkpoints > 0)
+    {
+        std::cerr << "a replay can not be continued from a checkpoint\n";
+        return 1;
+    }
+    if(threads < 1)
+    {
+        std::cerr << "at least one thread is needed\n";
+        return 1;
+    }
+
+    Network* network;
+    if(SnapshotParser::isSnapshot(filename))
+    {
+        SnapshotParser parser;
+        network = parser.parseSnapshot(filename);
+    }
+    else
+    {
+        NetworkParser parser;
+        network = parser.parseFile(filename);
+    }
+    if(network == NULL) return 1;
+
+    if(not snapshot.empty() and not SnapshotExporter::save(network, snapshot))
+    {
+        std::cerr << "Failed to write snapshot " << snapshot << "\n";
+        delete network;
+        return 1;
+    }
+
+    if(ticks >= 0) network->setMaxTicks(ticks);
+    network->setMaxTime(seconds);
+    network->setSteadyState(steadyTicks, steadyDelta);
+    network->setThreads(threads);
+    network->setDoubleBuffered(buffered != 0);
+    network->setKernelMode(static_cast<EKernelMode>(kernel));
+    network->setCheckpoints(checkpoints, snapshot);
+
+    const bool kTrajectory = format != "text";
+    if(kTrajectory) TrajectoryExporter::init(network, simple, format == "raw" ? kTrajectoryRaw : kTrajectoryDelta);
+
+    const bool kReplay = video != "none";
+    if(kReplay) ReplayExporter::init(simple, video == "ppm" ? kReplayPpm : kReplayY4m);
+
+    ExportPipeline::start(writers);
+    BatchObserver observer(interval, kTrajectory, kReplay);
+    const std::chrono::steady_clock::time_point kStart = std::chrono::steady_clock::now();
+    network->startSimulation(interval > 0 ? &observer : NULL, simple, impression);
+    if(kTrajectory) TrajectoryExporter::finish();
+    if(kReplay) ReplayExporter::finish();
+    const std::chrono::duration<double, std::micro> kElapsed = std::chrono::steady_clock::now() - kStart;
+
+    switch(network->getStopReason())
+    {
+        case Network::kEmpty:        std::cout << "reason: the network is empty\n"; break;
+        case Network::kMaxTicks:     std::cout << "reason: the tick budget is spent\n"; break;
+        case Network::kMaxTime:      std::cout << "reason: the time budget is spent\n"; break;
+        case Network::kSteadyState:  std::cout << "reason: the network is in a steady state\n"; break;
+        default: break;
+    }
+
+    const int kTicks = network->getTicksPassed();
+    std::cout << "ticks: " << kTicks << ", mean tick time: " << (kTicks == 0 ? 0 : kElapsed.count() / kTicks) << " us\n";
+
+    if(kernel == kKernelValidate) std::cout << "kernel mismatches: " << network->getKernelMismatches() << "\n";
+
+    delete network;
+    ExportPipeline::stop();
+    return 0;
+}
@@ -34,16 +34,13 @@ int main(int argc, char** argv)
     else throw std::runtime_error("argument count must be > 1, if gui is false");
 
     NetworkParser parser;
-    if (parser.loadFile(filename))
+    if (Network* network = parser.parseFile(filename))
     {
-        Network* network = parser.parseNetwork(parser.getRoot());
-        parser.clear();
-
         if (GUI)
         {
             window->createRoadButtons(network->getRoads());
         }
-        network->startSimulation(window, "simple", "impression", !GUI);
+        network->startSimulation(GUI ? window : NULL, "simple", "impression");
         delete network;
     }
 
@@ -18,118 +18,222 @@
 #include <stdint.h>
 #include "../datatypes/util.h"
 
-Network *NetworkParser::parseNetwork(TiXmlElement *const element) {
-    REQUIRE(this->properlyInitialized(), "NetworkParser was not initialized when calling parseNetwork");
-    REQUIRE(element, "Failed to parse network: no element");
-    RoadParser rp;
-    VehicleParser vp;
-    TrafficSignParser tp;
-    std::vector<Road *> roads;
-    std::map<std::string, std::vector<IVehicle *> > tempRoads;
-    for (TiXmlElement *elem = element->FirstChildElement();
-         elem != NULL; elem = elem->NextSiblingElement()) { //lees roads in
-        const std::string kType = elem->Value();
-        if (kType == "BAAN") {
-            Road *road = rp.parseRoad(elem);
-            if (road) {
-                roads.push_back(road);
-            }
-        }
+namespace {
+    struct PendingSign {
+        ETrafficSigns fType;
+        TrafficLight *fTrafficLight;
+        BusStop *fBusStop;
+        Zone *fZone;
+    };
+
+    //bouwt een netwerk op uit de elementen van een bestand in een enkele doorgang, enkel de verbindingen worden achteraf opgelost
+    class NetworkBuilder {
+    public:
+        NetworkBuilder();
+
+        ~NetworkBuilder();
+
+        void addElement(TiXmlElement *element);
+
+        Network *finish();
+
+        void abort();
+
+    private:
+        NetworkBuilder(const NetworkBuilder &);
+
+        NetworkBuilder &operator=(const NetworkBuilder &);
+
+        static void addSign(Road *road, const PendingSign &kSign);
+
+        Arena *fSignArena; //geheugen van de verkeerstekens, het netwerk neemt het over in finish
+        RoadParser fRoadParser;
+        VehicleParser fVehicleParser;
+        TrafficSignParser fSignParser;
+        std::vector<Road *> fRoads;
+        std::vector<std::pair<Road *, std::string> > fConnections;
+        std::map<std::string, std::vector<IVehicle *> > fVehicles;
+        std::map<std::string, std::vector<PendingSign> > fSigns; //verkeerstekens op wegen die nog niet gelezen zijn
+    };
+
+    NetworkBuilder::NetworkBuilder()
+            : fSignArena(new Arena), fRoadParser(fSignArena), fSignParser(fSignArena) {
     }
-    uint32_t roadNr = 0;
-    for (TiXmlElement *elem = element->FirstChildElement();
-         elem != NULL; elem = elem->NextSiblingElement()) { //lees verbindingen en voertuigen in
-        const std::string kType = elem->Value();
+
+    NetworkBuilder::~NetworkBuilder() {
+        delete fSignArena;
+    }
+
+    void NetworkBuilder::addElement(TiXmlElement *const element) {
+        const std::string kType = element->Value();
         if (kType == "BAAN") {
-            const std::string kConnection = rp.parseConnection(elem);
-            if (!kConnection.empty()) {
-                std::vector<Road *>::iterator found = std::find_if(roads.begin(), roads.end(), Comparator(kConnection));
-                if (found == roads.end()) {
-                    std::cerr << "Inconsistent traffic situation: road " << kConnection << " does not exist"
-                              << std::endl;
-                    roads[roadNr++]->setNextRoad(NULL);
-                } else {
-                    roads[roadNr++]->setNextRoad(*found);
+            Road *road = fRoadParser.parseRoad(element);
+            if (road) {
+                fRoads.push_back(road);
+                const std::string kConnection = fRoadParser.parseConnection(element);
+                if (!kConnection.empty()) {
+                    fConnections.push_back(std::make_pair(road, kConnection));
+                }
+                std::map<std::string, std::vector<PendingSign> >::iterator found = fSigns.find(road->getName());
+                if (found != fSigns.end()) {
+                    for (uint32_t i = 0; i < found->second.size(); i++) {
+                        addSign(road, found->second[i]);
+                    }
+                    fSigns.erase(found);
                 }
             }
         } else if (kType == "VOERTUIG") {
-            IVehicle *vehicle = vp.parseVehicle(elem);
+            IVehicle *vehicle = fVehicleParser.parseVehicle(element);
             if (vehicle) {
-                tempRoads[vp.parseRoad(elem)].push_back(vehicle);
+                fVehicles[fVehicleParser.parseRoad(element)].push_back(vehicle);
             }
         } else if (kType == "VERKEERSTEKEN") {
-            const ETrafficSigns kSign = tp.parseTrafficSign(elem);
-            if (kSign != kError) {
-                std::vector<Road *>::iterator found = std::find_if(roads.begin(), roads.end(),
-                                                                   Comparator(tp.parseRoad(elem)));
-                if (found != roads.end()) {
-                    Road *foundRoad = *found;
-                    switch (kSign) {
-                        case kTrafficLight:
-                            foundRoad->addTrafficLight(tp.getTrafficLight());
-                            break;
-                        case kBusStop:
-                            foundRoad->addBusStop(tp.getBusStop());
-                            break;
-                        case kZone:
-                            foundRoad->addZone(tp.getZone());
-                            break;
-                        default:
-                            break;
-                    }
-                } else {
-                    std::cerr << "Inconsistent traffic situation: road " << tp.parseRoad(elem) << " does not exist"
-                              << std::endl;
-                }
+            PendingSign sign = {fSignParser.parseTrafficSign(element), NULL, NULL, NULL};
+            switch (sign.fType) {
+                case kTrafficLight:
+                    sign.fTrafficLight = fSignParser.getTrafficLight();
+                    break;
+                case kBusStop:
+                    sign.fBusStop = fSignParser.getBusStop();
+                    break;
+                case kZone:
+                    sign.fZone = fSignParser.getZone();
+                    break;
+                default:
+                    return;
+            }
+            const std::string kRoad = fSignParser.parseRoad(element);
+            if (Road *road = fRoadParser.findRoad(kRoad)) {
+                addSign(road, sign);
+            } else {
+                fSigns[kRoad].push_back(sign);
             }
         } else {
             std::cerr << "Failed to recognize element " + kType + ": skipping element" << std::endl;
         }
     }
-    for (std::map<std::string, std::vector<IVehicle *> >::iterator it1 = tempRoads.begin(); //check voor inconsistente verkeersituaties en plaats de auto's op de wegen
-         it1 != tempRoads.end(); it1++) {
-        std::sort(it1->second.rbegin(), it1->second.rend(), comparePositions<IVehicle>);
-        std::vector<Road *>::iterator found = std::find_if(roads.begin(), roads.end(), Comparator(it1->first));
-        if (found != roads.end()) {
-            Road *foundRoad = *found;
-            for (std::vector<IVehicle *>::iterator it2 = it1->second.begin(); it2 != it1->second.end(); it2++) {
-                if ((*it2)->getPosition() >= foundRoad->getRoadLength()) {
-                    std::cerr << "Inconsistent traffic situation: vehicle " << (*it2)->getLicensePlate()
-                              << " is not on road "
-                              << it1->first << std::endl;
-                }
-                std::vector<IVehicle *>::iterator it3 = it2;
-                if (++it3 < it1->second.end() && abs((*it2)->getPosition() - (*it3)->getPosition()) < 5) {
-                    std::cerr << "Inconsistent traffic situation: vehicle " << (*it2)->getLicensePlate()
-                              << " is less than 5m away from vehicle " << (*it3)->getLicensePlate() << " on road "
-                              << it1->first << std::endl;
-                }
-                const double kFromEnd = foundRoad->getRoadLength() - (*it2)->getPosition();
-                if (kFromEnd < 5) {
-                    if (Road *nextRoad = foundRoad->getNextRoad()) {
-                        IVehicle *nextVehicle = NULL;
-                        if (!tempRoads[nextRoad->getName()].empty()) {
-                            nextVehicle = tempRoads[nextRoad->getName()].front();
-                            if (nextVehicle->getPosition() + kFromEnd < 5) {
-                                std::cerr << "Inconsistent traffic situation: vehicle " << (*it2)->getLicensePlate()
-                                          << " is less than 5m away from vehicle " << nextVehicle->getLicensePlate()
-                                          << " on roads " << it1->first << " and " << nextRoad->getName()
-                                          << std::endl;
+
+    Network *NetworkBuilder::finish() {
+        for (uint32_t i = 0; i < fConnections.size(); i++) { //los de verbindingen op
+            const std::string &kConnection = fConnections[i].second;
+            Road *found = fRoadParser.findRoad(kConnection);
+            if (found == NULL) {
+                std::cerr << "Inconsistent traffic situation: road " << kConnection << " does not exist" << std::endl;
+            }
+            fConnections[i].first->setNextRoad(found);
+        }
+        for (std::map<std::string, std::vector<PendingSign> >::iterator it = fSigns.begin(); it != fSigns.end(); it++) {
+            for (uint32_t i = 0; i < it->second.size(); i++) {
+                std::cerr << "Inconsistent traffic situation: road " << it->first << " does not exist" << std::endl;
+            }
+        }
+        fSigns.clear();
+        for (std::map<std::string, std::vector<IVehicle *> >::iterator it1 = fVehicles.begin(); //check voor inconsistente verkeersituaties en plaats de auto's op de wegen
+             it1 != fVehicles.end(); it1++) {
+            std::sort(it1->second.rbegin(), it1->second.rend(), comparePositions<IVehicle>);
+            if (Road *foundRoad = fRoadParser.findRoad(it1->first)) {
+                for (std::vector<IVehicle *>::iterator it2 = it1->second.begin(); it2 != it1->second.end(); it2++) {
+                    if ((*it2)->getPosition() >= foundRoad->getRoadLength()) {
+                        std::cerr << "Inconsistent traffic situation: vehicle " << (*it2)->getLicensePlate()
+                                  << " is not on road "
+                                  << it1->first << std::endl;
+                    }
+                    std::vector<IVehicle *>::iterator it3 = it2;
+                    if (++it3 < it1->second.end() && abs((*it2)->getPosition() - (*it3)->getPosition()) < 5) {
+                        std::cerr << "Inconsistent traffic situation: vehicle " << (*it2)->getLicensePlate()
+                                  << " is less than 5m away from vehicle " << (*it3)->getLicensePlate() << " on road "
+                                  << it1->first << std::endl;
+                    }
+                    const double kFromEnd = foundRoad->getRoadLength() - (*it2)->getPosition();
+                    if (kFromEnd < 5) {
+                        if (Road *nextRoad = foundRoad->getNextRoad()) {
+                            IVehicle *nextVehicle = NULL;
+                            if (!fVehicles[nextRoad->getName()].empty()) {
+                                nextVehicle = fVehicles[nextRoad->getName()].front();
+                                if (nextVehicle->getPosition() + kFromEnd < 5) {
+                                    std::cerr << "Inconsistent traffic situation: vehicle " << (*it2)->getLicensePlate()
+                                              << " is less than 5m away from vehicle " << nextVehicle->getLicensePlate()
+                                              << " on roads " << it1->first << " and " << nextRoad->getName()
+                                              << std::endl;
+                                }
                             }
                         }
                     }
+                    foundRoad->enqueue(*it2);
                 }
-                foundRoad->enqueue(*it2);
+            } else {
+                std::cerr << "Inconsistent traffic situation: road " << it1->first << " does not exist" << std::endl;
             }
-        } else {
-            std::cerr << "Inconsistent traffic situation: road " << it1->first << " does not exist" << std::endl;
         }
+        Network *network = new Network(fRoads, fSignArena);
+        fSignArena = NULL;
+        return network;
     }
-    fNetwork = new Network(roads);
+
+    void NetworkBuilder::abort() {
+        for (uint32_t i = 0; i < fRoads.size(); i++) {
+            delete fRoads[i];
+        }
+        for (std::map<std::string, std::vector<IVehicle *> >::iterator it1 = fVehicles.begin(); it1 != fVehicles.end(); it1++) {
+            for (uint32_t i = 0; i < it1->second.size(); i++) {
+                delete it1->second[i];
+            }
+        }
+        fRoads.clear();
+        fVehicles.clear();
+        fSigns.clear();
+    }
+
+    void NetworkBuilder::addSign(Road *const road, const PendingSign &kSign) {
+        switch (kSign.fType) {
+            case kTrafficLight:
+                road->addTrafficLight(kSign.fTrafficLight);
+                break;
+            case kBusStop:
+                road->addBusStop(kSign.fBusStop);
+                break;
+            case kZone:
+                road->addZone(kSign.fZone);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+Network *NetworkParser::parseNetwork(TiXmlElement *const element) {
+    REQUIRE(this->properlyInitialized(), "NetworkParser was not initialized when calling parseNetwork");
+    REQUIRE(element, "Failed to parse network: no element");
+    NetworkBuilder builder;
+    for (TiXmlElement *elem = element->FirstChildElement(); elem != NULL; elem = elem->NextSiblingElement()) {
+        builder.addElement(elem);
+    }
+    fNetwork = builder.finish();
     ENSURE(fNetwork, "Failed to parse network: no network");
     return fNetwork;
 }
 
+Network *NetworkParser::parseFile(const std::string &kFilename) {
+    REQUIRE(this->properlyInitialized(), "NetworkParser was not initialized when calling parseFile");
+    if (!openFile(kFilename)) {
+        return NULL;
+    }
+    NetworkBuilder builder;
+    TiXmlElement *elem = NULL;
+    while (nextElement(elem)) {
+        if (elem == NULL) {
+            fNetwork = builder.finish();
+            clear();
+            ENSURE(fNetwork, "Failed to parse network: no network");
+            return fNetwork;
+        }
+        builder.addElement(elem);
+    }
+    builder.abort();
+    clear();
+    return NULL;
+}
+
 Network *NetworkParser::getNetwork() const {
     REQUIRE(this->properlyInitialized(), "NetworkParser was not initialized when calling getNetwork");
     ENSURE(fNetwork, "Failed to parse network: no network");
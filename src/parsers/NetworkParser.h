@@ -31,6 +31,14 @@ public:
      */
     Network *parseNetwork(TiXmlElement *element);
 
+    /**
+     * 	Parses a network while streaming through the file, so the whole document is never in memory.
+     * 	Returns NULL if the file is malformed.
+     * 	REQUIRE(this->properlyInitialized(), "NetworkParser was not initialized when calling parseFile");
+     *	ENSURE(fNetwork, "Failed to parse network: no network");
+     */
+    Network *parseFile(const std::string &kFilename);
+
     /**
      * 	REQUIRE(this->properlyInitialized(), "NetworkParser was not initialized when calling getNetwork");
      *	ENSURE(fNetwork, "Failed to parse network: no network");
@@ -13,8 +13,9 @@
 #include <algorithm>
 #include <iostream>
 
-RoadParser::RoadParser() {
+RoadParser::RoadParser(Arena *const signArena) {
     fRoad = NULL;
+    fSignArena = signArena;
     ENSURE(this->properlyInitialized(), "RoadParser was not initialized when constructed");
 }
 
@@ -28,7 +29,9 @@ Road *RoadParser::parseRoad(TiXmlElement *const element) {
                   << ": name cannot be empty" << std::endl;
         return NULL;
     }
-    if (!fNames.insert(kName).second) {
+    const std::pair<std::unordered_map<std::string, Road *>::iterator, bool> kInserted =
+            fRoads.insert(std::make_pair(kName, (Road *) NULL));
+    if (!kInserted.second) {
         std::cerr << "Failed to parse road with name " << kName
                   << ": name already in use" << std::endl;
         return NULL;
@@ -64,10 +67,11 @@ Road *RoadParser::parseRoad(TiXmlElement *const element) {
         lanes = 1;
     }
     std::vector<const Zone *> zones;
-    zones.push_back(new Zone(0, kMaxSpeed));
+    zones.push_back(new (fSignArena) Zone(0, kMaxSpeed));
     std::vector<const BusStop *> stops;
     std::vector<const TrafficLight *> lights;
     fRoad = new Road(kName, NULL, kLength, lanes, zones, stops, lights);
+    kInserted.first->second = fRoad;
     ENSURE(fRoad, "Failed to parse road: no road");
     return fRoad;
 }
@@ -83,3 +87,9 @@ std::string RoadParser::parseConnection(TiXmlElement *element) {
     REQUIRE(element, "Failed to parse connection: no element");
     return readElement(element, "verbinding");
 }
+
+Road *RoadParser::findRoad(const std::string &kName) const {
+    REQUIRE(this->properlyInitialized(), "RoadParser was not initialized when calling findRoad");
+    const std::unordered_map<std::string, Road *>::const_iterator kFound = fRoads.find(kName);
+    return kFound == fRoads.end() ? NULL : kFound->second;
+}
@@ -11,7 +11,7 @@
 #define SIMULATION_ROADPARSER_H
 
 
-#include <set>
+#include <unordered_map>
 #include "tinyxml/tinyxml.h"
 #include "../datatypes/Road.h"
 #include "VAbstractParser.h"
@@ -20,9 +20,10 @@ class RoadParser : public VAbstractParser {
 public:
 
 	/**
+	 * 	The zones of the parsed roads are allocated from signArena, or from the heap when it is NULL.
 	 * 	ENSURE(this->properlyInitialized(), "RoadParser was not initialized when constructed");
 	 */
-	RoadParser();
+	explicit RoadParser(Arena *signArena = NULL);
 
 	/**
 	 * 	REQUIRE(this->properlyInitialized(), "RoadParser was not initialized when calling parseRoad");
@@ -43,10 +44,17 @@ public:
 	 */
 	std::string parseConnection(TiXmlElement *element);
 
+	/**
+	 * 	Returns the parsed road with this name, NULL if there is none.
+	 * 	REQUIRE(this->properlyInitialized(), "RoadParser was not initialized when calling findRoad");
+	 */
+	Road *findRoad(const std::string &kName) const;
+
 private:
 	Road *fRoad;
+	Arena *fSignArena;
 
-	std::set<std::string> fNames;
+	std::unordered_map<std::string, Road *> fRoads;	// every name that was used, NULL if its road failed to parse
 
 };
 
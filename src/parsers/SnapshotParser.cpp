@@ -0,0 +1,383 @@
+//============================================================================
+// @name        : SnapshotParser.cpp
+// @author      : Thomas Dooms
+// @date        : 5/26/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : builds a network from a binary snapshot that is mapped into memory
+//============================================================================
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "SnapshotParser.h"
+#include "../datatypes/vehicles/Car.h"
+#include "../datatypes/vehicles/Bus.h"
+#include "../datatypes/vehicles/Motorcycle.h"
+#include "../datatypes/vehicles/Truck.h"
+#include "../DesignByContract.h"
+
+namespace
+{
+    template<typename T>
+    const T* section(const char* kData, const ESnapshotSection kSection)
+    {
+        const SnapshotHeader* kHeader = reinterpret_cast<const SnapshotHeader*>(kData);
+        return reinterpret_cast<const T*>(kData + kHeader->fOffsets[kSection]);
+    }
+
+    bool validIndex(const int32_t kIndex, const uint64_t kCount)
+    {
+        return kIndex == -1 or (kIndex >= 0 and static_cast<uint64_t>(kIndex) < kCount);
+    }
+
+    bool validString(const uint64_t kOffset, const uint32_t kLength, const uint64_t kCount)
+    {
+        return kLength > 0 and kOffset <= kCount and kLength <= kCount - kOffset;
+    }
+
+    // written as a negation so NaN is not accepted
+    bool nonNegative(const double kValue)
+    {
+        return not (kValue < 0) and kValue == kValue;
+    }
+}
+
+SnapshotParser::SnapshotParser()
+{
+    fNetwork = NULL;
+    _initCheck = this;
+    ENSURE(this->properlyInitialized(), "SnapshotParser was not initialized when constructed");
+}
+
+bool SnapshotParser::properlyInitialized() const
+{
+    return _initCheck == this;
+}
+
+bool SnapshotParser::isSnapshot(const std::string& kFilename)
+{
+    char magic[sizeof(SnapshotExporter::fgkMagic)];
+    std::ifstream file(kFilename.c_str(), std::ios::binary);
+    file.read(magic, sizeof(magic));
+    return file.good() and std::memcmp(magic, SnapshotExporter::fgkMagic, sizeof(magic)) == 0;
+}
+
+Network* SnapshotParser::parseSnapshot(const std::string& kFilename)
+{
+    REQUIRE(this->properlyInitialized(), "SnapshotParser was not initialized when calling parseSnapshot");
+    fNetwork = NULL;
+
+    const int kFile = open(kFilename.c_str(), O_RDONLY);
+    if(kFile == -1)
+    {
+        std::cerr << "Failed to load snapshot: can not open " << kFilename << std::endl;
+        return NULL;
+    }
+    struct stat info;
+    if(fstat(kFile, &info) == -1 or info.st_size < static_cast<off_t>(sizeof(SnapshotHeader)))
+    {
+        close(kFile);
+        std::cerr << "Failed to load snapshot: file is too small" << std::endl;
+        return NULL;
+    }
+    const uint64_t kSize = info.st_size;
+    void* const kMapped = mmap(NULL, kSize, PROT_READ, MAP_PRIVATE, kFile, 0);
+    close(kFile);
+    if(kMapped == MAP_FAILED)
+    {
+        std::cerr << "Failed to load snapshot: can not map " << kFilename << std::endl;
+        return NULL;
+    }
+
+    const char* kData = static_cast<const char*>(kMapped);
+    const std::string kError = validate(kData, kSize);
+    if(kError.empty()) fNetwork = build(kData);
+    else std::cerr << "Failed to load snapshot: " << kError << std::endl;
+
+    munmap(kMapped, kSize);
+    return fNetwork;
+}
+
+Network* SnapshotParser::getNetwork() const
+{
+    REQUIRE(this->properlyInitialized(), "SnapshotParser was not initialized when calling getNetwork");
+    ENSURE(fNetwork, "Failed to parse snapshot: no network");
+    return fNetwork;
+}
+
+std::string SnapshotParser::validate(const char* const kData, const uint64_t kSize)
+{
+    const SnapshotHeader* kHeader = reinterpret_cast<const SnapshotHeader*>(kData);
+    if(std::memcmp(kHeader->fMagic, SnapshotExporter::fgkMagic, sizeof(kHeader->fMagic)) != 0) return "not a snapshot";
+    if(kHeader->fVersion != SnapshotExporter::fgkVersion) return "unsupported version";
+    if(kHeader->fEndianness != SnapshotExporter::fgkEndianness) return "snapshot was made on a machine with another byte order";
+    if(kHeader->fSize != kSize) return "file is truncated";
+
+    for(uint32_t i = 0; i < kSnapshotSections; i++)
+    {
+        const uint64_t kOffset = kHeader->fOffsets[i];
+        if(kOffset % 8 != 0 or kOffset < sizeof(SnapshotHeader) or kOffset > kSize) return "section outside of the file";
+        if(kHeader->fCounts[i] > (kSize - kOffset) / SnapshotExporter::fgkRecordSizes[i]) return "section outside of the file";
+        if(i != kSnapshotStrings and kHeader->fCounts[i] > UINT32_MAX) return "section is too large";
+    }
+
+    const uint64_t* kCounts = kHeader->fCounts;
+    const SnapshotRoad* kRoads = section<SnapshotRoad>(kData, kSnapshotRoads);
+    const SnapshotLane* kLanes = section<SnapshotLane>(kData, kSnapshotLanes);
+    const SnapshotEntry* kEntries = section<SnapshotEntry>(kData, kSnapshotEntries);
+    const SnapshotMerge* kMerges = section<SnapshotMerge>(kData, kSnapshotMerges);
+    const SnapshotZone* kZones = section<SnapshotZone>(kData, kSnapshotZones);
+    const SnapshotBusStop* kBusStops = section<SnapshotBusStop>(kData, kSnapshotBusStops);
+    const SnapshotTrafficLight* kTrafficLights = section<SnapshotTrafficLight>(kData, kSnapshotTrafficLights);
+    const SnapshotVehicle* kVehicles = section<SnapshotVehicle>(kData, kSnapshotVehicles);
+    const uint64_t kNumVehicles = kCounts[kSnapshotVehicles];
+
+    // every road owns the next part of each section, so no object can be shared or left over
+    uint64_t lanes = 0, zones = 0, busStops = 0, trafficLights = 0, merges = 0, entries = 0;
+    for(uint64_t i = 0; i < kCounts[kSnapshotRoads]; i++)
+    {
+        const SnapshotRoad& kRoad = kRoads[i];
+        if(not validString(kRoad.fName, kRoad.fNameLength, kCounts[kSnapshotStrings])) return "invalid road name";
+        if(not validIndex(kRoad.fNextRoad, kCounts[kSnapshotRoads])) return "invalid next road";
+        if(not (kRoad.fLength > 0)) return "invalid road length";
+        if(kRoad.fNumLanes == 0 or kRoad.fNumLanes >= 100) return "invalid amount of lanes";
+        if(kRoad.fNumZones == 0) return "road without a speed zone";
+        if(kRoad.fMergeTick > Road::fgkMergeTicks) return "invalid merge tick";
+
+        if(kRoad.fFirstLane != lanes or kRoad.fFirstZone != zones or kRoad.fFirstBusStop != busStops or
+           kRoad.fFirstTrafficLight != trafficLights or kRoad.fFirstMerge != merges) return "sections do not match the roads";
+        lanes += kRoad.fNumLanes;
+        zones += kRoad.fNumZones;
+        busStops += kRoad.fNumBusStops;
+        trafficLights += kRoad.fNumTrafficLights;
+        merges += kRoad.fNumMerges;
+        if(lanes > kCounts[kSnapshotLanes] or zones > kCounts[kSnapshotZones] or busStops > kCounts[kSnapshotBusStops] or
+           trafficLights > kCounts[kSnapshotTrafficLights] or merges > kCounts[kSnapshotMerges]) return "sections do not match the roads";
+        if(kZones[kRoad.fFirstZone].fPosition != 0) return "road without a speed zone at position 0";
+
+        for(uint32_t j = kRoad.fFirstLane; j < kRoad.fFirstLane + kRoad.fNumLanes; j++)
+        {
+            if(kLanes[j].fFirstEntry != entries) return "lanes do not match the entries";
+            entries += kLanes[j].fNumEntries;
+            if(entries > kCounts[kSnapshotEntries]) return "lanes do not match the entries";
+        }
+    }
+    if(lanes != kCounts[kSnapshotLanes] or zones != kCounts[kSnapshotZones] or busStops != kCounts[kSnapshotBusStops] or
+       trafficLights != kCounts[kSnapshotTrafficLights] or merges != kCounts[kSnapshotMerges] or
+       entries != kCounts[kSnapshotEntries]) return "sections do not match the roads";
+
+    for(uint64_t i = 0; i < kCounts[kSnapshotZones]; i++)
+    {
+        if(not nonNegative(kZones[i].fPosition) or not nonNegative(kZones[i].fSpeedLimit)) return "invalid speed zone";
+    }
+    for(uint64_t i = 0; i < kCounts[kSnapshotBusStops]; i++)
+    {
+        if(not nonNegative(kBusStops[i].fPosition) or not validIndex(kBusStops[i].fStationed, kNumVehicles)) return "invalid bus stop";
+    }
+    for(uint64_t i = 0; i < kCounts[kSnapshotTrafficLights]; i++)
+    {
+        const SnapshotTrafficLight& kLight = kTrafficLights[i];
+        if(not nonNegative(kLight.fPosition) or not validIndex(kLight.fInRange, kNumVehicles) or
+           kLight.fColor > TrafficLight::kGreen) return "invalid traffic light";
+    }
+
+    // every vehicle is in exactly one lane, a merging vehicle has a ghost in its old lane as well
+    std::vector<bool> placed(kNumVehicles, false);
+    std::vector<int64_t> ghosts(kNumVehicles, -1);
+    std::vector<bool> merging(kNumVehicles, false);
+    for(uint64_t i = 0; i < kCounts[kSnapshotRoads]; i++)
+    {
+        const SnapshotRoad& kRoad = kRoads[i];
+        for(uint32_t j = 0; j < kRoad.fNumLanes; j++)
+        {
+            const SnapshotLane& kLane = kLanes[kRoad.fFirstLane + j];
+            for(uint32_t k = kLane.fFirstEntry; k < kLane.fFirstEntry + kLane.fNumEntries; k++)
+            {
+                const SnapshotEntry& kEntry = kEntries[k];
+                if(kEntry.fVehicle >= kNumVehicles or kEntry.fFlags > (Lane::kStationed | Lane::kMerging | Lane::kGhost)) return "invalid lane entry";
+                if(not (kEntry.fFlags & Lane::kGhost))
+                {
+                    if(placed[kEntry.fVehicle]) return "vehicle is in more than one lane";
+                    placed[kEntry.fVehicle] = true;
+                }
+                else
+                {
+                    if(ghosts[kEntry.fVehicle] != -1) return "vehicle merges from more than one lane";
+                    ghosts[kEntry.fVehicle] = kRoad.fFirstLane + j;
+                }
+            }
+        }
+        for(uint32_t j = kRoad.fFirstMerge; j < kRoad.fFirstMerge + kRoad.fNumMerges; j++)
+        {
+            const SnapshotMerge& kMerge = kMerges[j];
+            if(kMerge.fBucket > Road::fgkMergeTicks or kMerge.fLane >= kRoad.fNumLanes or kMerge.fVehicle >= kNumVehicles or
+               ghosts[kMerge.fVehicle] != kRoad.fFirstLane + kMerge.fLane) return "invalid merging vehicle";
+            if(merging[kMerge.fVehicle]) return "vehicle merges more than once";
+            merging[kMerge.fVehicle] = true;
+        }
+    }
+
+    // and every ghost is removed by the merge wheel of its road
+    for(uint64_t i = 0; i < kNumVehicles; i++)
+    {
+        if(ghosts[i] != -1 and not merging[i]) return "ghost of a vehicle that does not merge";
+    }
+
+    for(uint64_t i = 0; i < kNumVehicles; i++)
+    {
+        const SnapshotVehicle& kVehicle = kVehicles[i];
+        if(not placed[i]) return "vehicle is not in a lane";
+        if(not validString(kVehicle.fLicensePlate, kVehicle.fLicenseLength, kCounts[kSnapshotStrings])) return "invalid license plate";
+        if(kVehicle.fType > kTruck) return "invalid vehicle type";
+        if(not nonNegative(kVehicle.fPosition) or not nonNegative(kVehicle.fVelocity)) return "invalid vehicle position or velocity";
+        if(kVehicle.fPrevIndex >= 5) return "invalid vehicle acceleration history";
+        if(not validIndex(kVehicle.fTrafficLight, kCounts[kSnapshotTrafficLights]) or
+           not validIndex(kVehicle.fBusStop, kCounts[kSnapshotBusStops]) or
+           not validIndex(kVehicle.fSignRoad, kCounts[kSnapshotRoads])) return "invalid vehicle reference";
+        if(kVehicle.fSignRoad != -1)
+        {
+            const SnapshotRoad& kRoad = kRoads[kVehicle.fSignRoad];
+            if(kVehicle.fTrafficLightIndex > kRoad.fNumTrafficLights or kVehicle.fBusStopIndex > kRoad.fNumBusStops) return "invalid vehicle sign cursor";
+        }
+    }
+    return "";
+}
+
+Network* SnapshotParser::build(const char* const kData)
+{
+    const SnapshotHeader* kHeader = reinterpret_cast<const SnapshotHeader*>(kData);
+    const uint64_t* kCounts = kHeader->fCounts;
+    const SnapshotRoad* kRoads = section<SnapshotRoad>(kData, kSnapshotRoads);
+    const SnapshotLane* kLanes = section<SnapshotLane>(kData, kSnapshotLanes);
+    const SnapshotEntry* kEntries = section<SnapshotEntry>(kData, kSnapshotEntries);
+    const SnapshotMerge* kMerges = section<SnapshotMerge>(kData, kSnapshotMerges);
+    const SnapshotZone* kZoneRecords = section<SnapshotZone>(kData, kSnapshotZones);
+    const SnapshotBusStop* kBusStopRecords = section<SnapshotBusStop>(kData, kSnapshotBusStops);
+    const SnapshotTrafficLight* kTrafficLightRecords = section<SnapshotTrafficLight>(kData, kSnapshotTrafficLights);
+    const SnapshotVehicle* kVehicleRecords = section<SnapshotVehicle>(kData, kSnapshotVehicles);
+    const char* kStrings = section<char>(kData, kSnapshotStrings);
+
+    Arena* signArena = new Arena;
+    std::vector<const Zone*> zones(kCounts[kSnapshotZones]);
+    for(uint64_t i = 0; i < zones.size(); i++) zones[i] = new (signArena) Zone(kZoneRecords[i].fPosition, kZoneRecords[i].fSpeedLimit);
+
+    std::vector<BusStop*> busStops(kCounts[kSnapshotBusStops]);
+    for(uint64_t i = 0; i < busStops.size(); i++)
+    {
+        busStops[i] = new (signArena) BusStop(kBusStopRecords[i].fPosition);
+        busStops[i]->fTimer = kBusStopRecords[i].fTimer;
+    }
+
+    std::vector<TrafficLight*> trafficLights(kCounts[kSnapshotTrafficLights]);
+    for(uint64_t i = 0; i < trafficLights.size(); i++)
+    {
+        const SnapshotTrafficLight& kRecord = kTrafficLightRecords[i];
+        trafficLights[i] = new (signArena) TrafficLight(kRecord.fPosition);
+        trafficLights[i]->fColor = static_cast<TrafficLight::EColor>(kRecord.fColor);
+        trafficLights[i]->fRedTime = kRecord.fRedTime;
+        trafficLights[i]->fGreenTime = kRecord.fGreenTime;
+        trafficLights[i]->fTimer = kRecord.fTimer;
+    }
+
+    std::vector<Road*> roads(kCounts[kSnapshotRoads]);
+    for(uint64_t i = 0; i < roads.size(); i++)
+    {
+        const SnapshotRoad& kRecord = kRoads[i];
+        const std::vector<const Zone*> kZones(zones.begin() + kRecord.fFirstZone, zones.begin() + kRecord.fFirstZone + kRecord.fNumZones);
+        const std::vector<const BusStop*> kBusStops(busStops.begin() + kRecord.fFirstBusStop, busStops.begin() + kRecord.fFirstBusStop + kRecord.fNumBusStops);
+        const std::vector<const TrafficLight*> kTrafficLights(trafficLights.begin() + kRecord.fFirstTrafficLight, trafficLights.begin() + kRecord.fFirstTrafficLight + kRecord.fNumTrafficLights);
+
+        roads[i] = new Road(std::string(kStrings + kRecord.fName, kRecord.fNameLength), NULL, kRecord.fLength, kRecord.fNumLanes, kZones, kBusStops, kTrafficLights);
+        roads[i]->fSignVersion = kRecord.fSignVersion;
+        roads[i]->fMergeTick = kRecord.fMergeTick;
+        roads[i]->fNumVehicles = kRecord.fNumVehicles;
+        roads[i]->fKernelMismatches = kRecord.fKernelMismatches;
+    }
+
+    std::vector<IVehicle*> vehicles(kCounts[kSnapshotVehicles]);
+    for(uint64_t i = 0; i < vehicles.size(); i++)
+    {
+        const SnapshotVehicle& kRecord = kVehicleRecords[i];
+        const std::string kLicense(kStrings + kRecord.fLicensePlate, kRecord.fLicenseLength);
+        switch(kRecord.fType)
+        {
+            case kCar:          vehicles[i] = new Car       (kLicense, kRecord.fPosition, kRecord.fVelocity); break;
+            case kBus:          vehicles[i] = new Bus       (kLicense, kRecord.fPosition, kRecord.fVelocity); break;
+            case kMotorcycle:   vehicles[i] = new Motorcycle(kLicense, kRecord.fPosition, kRecord.fVelocity); break;
+            default:            vehicles[i] = new Truck     (kLicense, kRecord.fPosition, kRecord.fVelocity); break;
+        }
+
+        IVehicle* vehicle = vehicles[i];
+        vehicle->setMoved(kRecord.fMoved, 0);                  // the restored network starts again at epoch 0
+        vehicle->fStationed = kRecord.fStationed;
+        vehicle->fMerging = kRecord.fMerging;
+        vehicle->fLaneChanges = kRecord.fLaneChanges;
+        vehicle->fAcceleration = kRecord.fAcceleration;
+        for(uint32_t j = 0; j < 5; j++) vehicle->fPrevAcceleration[j] = kRecord.fPrevAcceleration[j];
+        vehicle->fPrevIndex = kRecord.fPrevIndex;
+        vehicle->fTrafficLightAccel = std::tuple<bool, double, const TrafficLight*>(kRecord.fTrafficLightSlowing, kRecord.fTrafficLightAccel,
+                                                                                    kRecord.fTrafficLight == -1 ? NULL : trafficLights[kRecord.fTrafficLight]);
+        vehicle->fBusStopAccel = std::tuple<bool, double, const BusStop*>(kRecord.fBusStopSlowing, kRecord.fBusStopAccel,
+                                                                          kRecord.fBusStop == -1 ? NULL : busStops[kRecord.fBusStop]);
+        vehicle->fSignRoad = kRecord.fSignRoad == -1 ? NULL : roads[kRecord.fSignRoad];
+        vehicle->fSignVersion = kRecord.fSignVersion;
+        vehicle->fTrafficLightIndex = kRecord.fTrafficLightIndex;
+        vehicle->fBusStopIndex = kRecord.fBusStopIndex;
+        vehicle->fZoneIndex = kRecord.fZoneIndex;
+        vehicle->fTimer = kRecord.fTimer;
+        vehicle->fDriveTimer = kRecord.fDriveTimer;
+        vehicle->fDistance = kRecord.fDistance;
+        vehicle->fMaxVelocity = kRecord.fMaxVelocity;
+    }
+
+    for(uint64_t i = 0; i < busStops.size(); i++)
+    {
+        if(kBusStopRecords[i].fStationed != -1) busStops[i]->fStationed = vehicles[kBusStopRecords[i].fStationed];
+    }
+    for(uint64_t i = 0; i < trafficLights.size(); i++)
+    {
+        if(kTrafficLightRecords[i].fInRange != -1) trafficLights[i]->fkInRange = vehicles[kTrafficLightRecords[i].fInRange];
+    }
+
+    for(uint64_t i = 0; i < roads.size(); i++)
+    {
+        const SnapshotRoad& kRecord = kRoads[i];
+        Road* road = roads[i];
+        if(kRecord.fNextRoad != -1) road->setNextRoad(roads[kRecord.fNextRoad]);
+
+        // the lanes keep the state of the previous tick, which can differ from the vehicles themselves
+        for(uint32_t j = 0; j < kRecord.fNumLanes; j++)
+        {
+            const SnapshotLane& kLaneRecord = kLanes[kRecord.fFirstLane + j];
+            Lane& lane = road->fLanes[j];
+            for(uint32_t k = 0; k < kLaneRecord.fNumEntries; k++)
+            {
+                const SnapshotEntry& kEntry = kEntries[kLaneRecord.fFirstEntry + k];
+                lane.pushBack(vehicles[kEntry.fVehicle]);
+                const uint32_t kPosition = lane.fHead + k;
+                lane.fPositions[kPosition] = kEntry.fPosition;
+                lane.fVelocities[kPosition] = kEntry.fVelocity;
+                lane.fAccelerations[kPosition] = kEntry.fAcceleration;
+                lane.fFlags[kPosition] = kEntry.fFlags;
+            }
+        }
+
+        for(uint32_t j = kRecord.fFirstMerge; j < kRecord.fFirstMerge + kRecord.fNumMerges; j++)
+        {
+            const SnapshotMerge& kMerge = kMerges[j];
+            road->fMergeWheel[kMerge.fBucket].push_back(std::pair<uint32_t, const IVehicle*>(kMerge.fLane, vehicles[kMerge.fVehicle]));
+        }
+    }
+
+    Network* network = new Network(roads, signArena);
+    network->fTicksPassed = kHeader->fTicksPassed;
+    network->fSteadyCount = kHeader->fSteadyCount;
+    network->fPrevStatistics = std::pair<double, double>(kHeader->fPrevVelocity, kHeader->fPrevFlow);
+    for(uint32_t i = 0; i < 3; i++) network->fOutputSizes[i] = kHeader->fOutputSizes[i];
+    return network;
+}
@@ -0,0 +1,63 @@
+//============================================================================
+// @name        : SnapshotParser.h
+// @author      : Thomas Dooms
+// @date        : 5/26/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : builds a network from a binary snapshot that is mapped into memory
+//============================================================================
+
+#ifndef SIMULATION_SNAPSHOTPARSER_H
+#define SIMULATION_SNAPSHOTPARSER_H
+
+#include <string>
+#include "../datatypes/Network.h"
+#include "../exporters/SnapshotExporter.h"
+
+class SnapshotParser
+{
+public:
+    /**
+     * ENSURE(this->properlyInitialized(), "SnapshotParser was not initialized when constructed");
+     */
+    SnapshotParser();
+
+    bool properlyInitialized() const;
+
+    /**
+     * true if the file starts like a snapshot, this does not check the rest of the file
+     */
+    static bool isSnapshot(const std::string& kFilename);
+
+    /**
+     * maps the snapshot into memory and builds the network it describes, in exactly the state it was saved in.
+     * Every reference in the file is checked before anything is built, returns NULL if the file is not a valid snapshot.
+     *
+     * REQUIRE(this->properlyInitialized(), "SnapshotParser was not initialized when calling parseSnapshot");
+     */
+    Network* parseSnapshot(const std::string& kFilename);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "SnapshotParser was not initialized when calling getNetwork");
+     * ENSURE(fNetwork, "Failed to parse snapshot: no network");
+     */
+    Network* getNetwork() const;
+
+private:
+    /**
+     * returns the reason why the mapped snapshot can not be built, or an empty string if it is valid
+     */
+    static std::string validate(const char* kData, uint64_t kSize);
+
+    /**
+     * builds the network from a mapped snapshot that has been validated
+     */
+    static Network* build(const char* kData);
+
+    Network* fNetwork;
+
+    const SnapshotParser* _initCheck;
+};
+
+
+#endif //SIMULATION_SNAPSHOTPARSER_H
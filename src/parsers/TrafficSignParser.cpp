@@ -10,10 +10,11 @@
 #include "TrafficSignParser.h"
 #include "../DesignByContract.h"
 
-TrafficSignParser::TrafficSignParser() {
+TrafficSignParser::TrafficSignParser(Arena *const signArena) {
     fTrafficLight = NULL;
     fBusStop = NULL;
     fZone = NULL;
+    fSignArena = signArena;
     ENSURE(this->properlyInitialized(), "TrafficSignParser was not initialized when constructed");
 }
 
@@ -56,15 +57,15 @@ ETrafficSigns TrafficSignParser::parseTrafficSign(TiXmlElement *element) {
             return kError;
         }
         const double kMaxSpeed = std::atof(kMax.c_str()) / 3.6;;
-        fZone = new Zone(kPosition, kMaxSpeed);
+        fZone = new (fSignArena) Zone(kPosition, kMaxSpeed);
         ENSURE(fZone, "Failed to parse traffic sign: no traffic sign");
         return kZone;
     } else if (kType == "BUSHALTE") {
-        fBusStop = new BusStop(kPosition);
+        fBusStop = new (fSignArena) BusStop(kPosition);
         ENSURE(kBusStop, "Failed to parse traffic sign: no traffic sign");
         return kBusStop;
     } else if (kType == "VERKEERSLICHT") {
-        fTrafficLight = new TrafficLight(kPosition);
+        fTrafficLight = new (fSignArena) TrafficLight(kPosition);
         ENSURE(fTrafficLight, "Failed to parse traffic sign: no traffic sign");
         return kTrafficLight;
     } else {
@@ -20,9 +20,10 @@ class TrafficSignParser : public VAbstractParser {
 public:
 
     /**
+     *  The parsed traffic signs are allocated from signArena, or from the heap when it is NULL.
      *  ENSURE(this->properlyInitialized(), "TrafficSignParser was not initialized when constructed");
      */
-    TrafficSignParser();
+    explicit TrafficSignParser(Arena *signArena = NULL);
 
     /**
      *  REQUIRE(this->properlyInitialized(), "TrafficSignParser was not initialized when calling parseTrafficSign");
@@ -60,6 +61,7 @@ private:
     TrafficLight *fTrafficLight;
     BusStop *fBusStop;
     Zone *fZone;
+    Arena *fSignArena;
 
 };
 
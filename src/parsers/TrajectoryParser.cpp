@@ -0,0 +1,307 @@
+//============================================================================
+// @name        : TrajectoryParser.cpp
+// @author      : Thomas Dooms
+// @date        : 5/28/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : reads the ticks of a binary trajectory in any order
+//============================================================================
+
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include "TrajectoryParser.h"
+#include "../DesignByContract.h"
+
+namespace
+{
+    bool fail(const std::string& kReason)
+    {
+        std::cerr << "Failed to load trajectory: " << kReason << std::endl;
+        return false;
+    }
+
+    bool getVarint(const char*& data, const char* const kEnd, uint64_t& value)
+    {
+        value = 0;
+        for(uint32_t shift = 0; shift < 64 and data != kEnd; shift += 7)
+        {
+            const uint8_t kByte = *data++;
+            value |= uint64_t(kByte & 0x7f) << shift;
+            if(not (kByte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool getSigned(const char*& data, const char* const kEnd, int64_t& value)
+    {
+        uint64_t encoded;
+        if(not getVarint(data, kEnd, encoded)) return false;
+        value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+        return true;
+    }
+
+    bool getString(std::ifstream& file, const uint64_t kEnd, std::string& string)
+    {
+        uint32_t length;
+        if(not file.read(reinterpret_cast<char*>(&length), sizeof(length))) return false;
+        if(length > kEnd - std::min<uint64_t>(file.tellg(), kEnd)) return false;
+        string.resize(length);
+        return length == 0 or file.read(&string[0], length);
+    }
+
+    bool lessTick(const uint32_t kTick, const TrajectoryChunk& kChunk)
+    {
+        return kTick < kChunk.fFirstTick;
+    }
+}
+
+TrajectoryParser::TrajectoryParser()
+{
+    fHeader = TrajectoryHeader();
+    fChunk = 0;
+    fBlock = 0;
+    fTick = 0;
+    _initCheck = this;
+    ENSURE(this->properlyInitialized(), "TrajectoryParser was not initialized when constructed");
+}
+
+bool TrajectoryParser::properlyInitialized() const
+{
+    return _initCheck == this;
+}
+
+bool TrajectoryParser::isTrajectory(const std::string& kFilename)
+{
+    char magic[sizeof(TrajectoryExporter::fgkMagic)];
+    std::ifstream file(kFilename.c_str(), std::ios::binary);
+    file.read(magic, sizeof(magic));
+    return file.good() and std::memcmp(magic, TrajectoryExporter::fgkMagic, sizeof(magic)) == 0;
+}
+
+bool TrajectoryParser::open(const std::string& kFilename)
+{
+    REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling open");
+    fFile.close();
+    fFile.clear();
+    fChunks.clear();
+    fRoads.clear();
+    fVehicles.clear();
+    if(load(kFilename)) return true;
+
+    // nothing can be read from a trajectory that failed to load
+    fChunks.clear();
+    fRoads.clear();
+    fVehicles.clear();
+    return false;
+}
+
+bool TrajectoryParser::load(const std::string& kFilename)
+{
+    fFile.open(kFilename.c_str(), std::ios::binary);
+    if(not fFile.is_open()) return fail("can not open " + kFilename);
+    fFile.seekg(0, std::ios::end);
+    const uint64_t kSize = fFile.tellg();
+    fFile.seekg(0);
+    if(kSize < sizeof(TrajectoryHeader) or not fFile.read(reinterpret_cast<char*>(&fHeader), sizeof(fHeader))) return fail("file is too small");
+
+    if(std::memcmp(fHeader.fMagic, TrajectoryExporter::fgkMagic, sizeof(fHeader.fMagic)) != 0) return fail("not a trajectory");
+    if(fHeader.fVersion != TrajectoryExporter::fgkVersion) return fail("unsupported version");
+    if(fHeader.fEndianness != TrajectoryExporter::fgkEndianness) return fail("trajectory was made on a machine with another byte order");
+    if(fHeader.fSize == 0) return fail("the trajectory was not finished");
+    if(fHeader.fSize != kSize) return fail("file is truncated");
+    if(fHeader.fEncoding > kTrajectoryDelta) return fail("unknown encoding");
+    if(fHeader.fChunkBlocks == 0 or fHeader.fNumChunks != (fHeader.fNumBlocks + fHeader.fChunkBlocks - 1) / fHeader.fChunkBlocks) return fail("chunk index does not match the blocks");
+    if(fHeader.fNumVehicles > UINT32_MAX or fHeader.fNumRoads > UINT32_MAX) return fail("table is too large");
+    if(fHeader.fChunksOffset < sizeof(TrajectoryHeader) or fHeader.fChunksOffset > kSize or
+       fHeader.fNumChunks > (kSize - fHeader.fChunksOffset) / sizeof(TrajectoryChunk)) return fail("chunk index outside of the file");
+    if(fHeader.fRoadsOffset > kSize or fHeader.fVehiclesOffset > kSize) return fail("table outside of the file");
+
+    fChunks.resize(fHeader.fNumChunks);
+    fFile.seekg(fHeader.fChunksOffset);
+    if(not fFile.read(reinterpret_cast<char*>(fChunks.data()), fChunks.size() * sizeof(TrajectoryChunk))) return fail("chunk index outside of the file");
+    for(uint64_t i = 0; i < fChunks.size(); i++)
+    {
+        const TrajectoryChunk& kChunk = fChunks[i];
+        if(kChunk.fOffset < sizeof(TrajectoryHeader) or kChunk.fOffset >= fHeader.fChunksOffset) return fail("chunk outside of the file");
+        if(kChunk.fFirstTick > kChunk.fLastTick) return fail("invalid chunk");
+        if(i > 0 and (kChunk.fOffset <= fChunks[i - 1].fOffset or kChunk.fFirstTick <= fChunks[i - 1].fLastTick)) return fail("chunks are not in order");
+    }
+
+    fFile.seekg(fHeader.fRoadsOffset);
+    fRoads.resize(fHeader.fNumRoads);
+    for(uint64_t i = 0; i < fRoads.size(); i++)
+    {
+        if(not getString(fFile, kSize, fRoads[i])) return fail("invalid road name");
+    }
+
+    fFile.seekg(fHeader.fVehiclesOffset);
+    for(uint64_t i = 0; i < fHeader.fNumVehicles; i++)
+    {
+        uint8_t type;
+        std::string licensePlate;
+        if(not fFile.read(reinterpret_cast<char*>(&type), sizeof(type)) or type > kTruck) return fail("invalid vehicle type");
+        if(not getString(fFile, kSize, licensePlate)) return fail("invalid license plate");
+        fVehicles.push_back(std::make_pair(static_cast<EVehicleType>(type), licensePlate));
+    }
+
+    fChunk = fChunks.size();
+    fPrevious.assign(3 * fVehicles.size(), 0);
+    fPreviousBlock.assign(fVehicles.size(), 0);
+    return true;
+}
+
+ETrajectoryEncoding TrajectoryParser::getEncoding() const
+{
+    REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getEncoding");
+    return static_cast<ETrajectoryEncoding>(fHeader.fEncoding);
+}
+
+const std::vector<std::string>& TrajectoryParser::getRoads() const
+{
+    REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getRoads");
+    return fRoads;
+}
+
+const std::vector<std::pair<EVehicleType, std::string> >& TrajectoryParser::getVehicles() const
+{
+    REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getVehicles");
+    return fVehicles;
+}
+
+const std::vector<TrajectoryChunk>& TrajectoryParser::getChunks() const
+{
+    REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getChunks");
+    return fChunks;
+}
+
+std::vector<uint32_t> TrajectoryParser::getTicks()
+{
+    REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getTicks");
+    std::vector<uint32_t> ticks;
+    fChunk = fChunks.size();
+    fFile.clear();
+    for(uint64_t i = 0; i < fChunks.size(); i++)
+    {
+        fFile.seekg(fChunks[i].fOffset);
+        const uint64_t kBlocks = std::min<uint64_t>(fHeader.fChunkBlocks, fHeader.fNumBlocks - i * fHeader.fChunkBlocks);
+        for(uint64_t j = 0; j < kBlocks; j++)
+        {
+            TrajectoryBlock block;
+            if(not fFile.read(reinterpret_cast<char*>(&block), sizeof(block)) or
+               block.fBytes > fHeader.fChunksOffset - std::min<uint64_t>(fFile.tellg(), fHeader.fChunksOffset)) return ticks;
+            ticks.push_back(block.fTick);
+            fFile.seekg(block.fBytes, std::ios::cur);
+        }
+    }
+    return ticks;
+}
+
+bool TrajectoryParser::readTick(const uint32_t kTick, TrajectoryFrame& frame)
+{
+    REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling readTick");
+    const std::vector<TrajectoryChunk>::const_iterator kFound = std::upper_bound(fChunks.begin(), fChunks.end(), kTick, lessTick);
+    if(kFound == fChunks.begin()) return false;
+    const uint64_t kChunk = kFound - fChunks.begin() - 1;
+    if(kTick > fChunks[kChunk].fLastTick) return false;
+
+    // the delta encoding refers to the previous block, so a chunk is read from its start unless the read can continue
+    if(kChunk != fChunk or fBlock == 0 or fTick >= kTick)
+    {
+        fFile.clear();
+        fFile.seekg(fChunks[kChunk].fOffset);
+        fChunk = kChunk;
+        fBlock = 0;
+    }
+
+    const uint64_t kBlocks = std::min<uint64_t>(fHeader.fChunkBlocks, fHeader.fNumBlocks - kChunk * fHeader.fChunkBlocks);
+    while(fBlock < kBlocks)
+    {
+        if(not readBlock(frame))
+        {
+            fChunk = fChunks.size();
+            std::cerr << "Failed to read trajectory: the block of tick " << kTick << " is corrupt" << std::endl;
+            return false;
+        }
+        if(frame.fTick >= kTick) return frame.fTick == kTick;
+    }
+    return false;
+}
+
+bool TrajectoryParser::readBlock(TrajectoryFrame& frame)
+{
+    TrajectoryBlock block;
+    if(not fFile.read(reinterpret_cast<char*>(&block), sizeof(block))) return false;
+    if(block.fBytes > fHeader.fChunksOffset - std::min<uint64_t>(fFile.tellg(), fHeader.fChunksOffset)) return false;
+    if(fBlock > 0 and block.fTick <= fTick) return false;
+
+    std::string data(block.fBytes, '\0');
+    if(block.fBytes > 0 and not fFile.read(&data[0], block.fBytes)) return false;
+
+    const uint32_t kCount = block.fCount;
+    frame.fTick = block.fTick;
+    frame.fVehicles.resize(kCount);
+    frame.fRoads.resize(kCount);
+    frame.fLanes.resize(kCount);
+    frame.fPositions.resize(kCount);
+    frame.fVelocities.resize(kCount);
+    frame.fAccelerations.resize(kCount);
+    std::vector<uint32_t>* columns[3] = {&frame.fVehicles, &frame.fRoads, &frame.fLanes};
+    std::vector<double>* values[3] = {&frame.fPositions, &frame.fVelocities, &frame.fAccelerations};
+
+    if(fHeader.fEncoding == kTrajectoryRaw)
+    {
+        if(block.fBytes != uint64_t(kCount) * (3 * sizeof(uint32_t) + 3 * sizeof(double))) return false;
+        const char* kData = data.data();
+        for(uint32_t i = 0; i < 3; i++, kData += kCount * sizeof(uint32_t)) std::memcpy(columns[i]->data(), kData, kCount * sizeof(uint32_t));
+        for(uint32_t i = 0; i < 3; i++, kData += kCount * sizeof(double)) std::memcpy(values[i]->data(), kData, kCount * sizeof(double));
+    }
+    else
+    {
+        // every value takes at least one byte
+        if(block.fBytes < uint64_t(kCount) * 6) return false;
+        const char* kData = data.data();
+        const char* const kEnd = kData + data.size();
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            int64_t previous = 0;
+            for(uint32_t j = 0; j < kCount; j++)
+            {
+                int64_t delta;
+                if(not getSigned(kData, kEnd, delta)) return false;
+                previous += delta;
+                if(previous < 0 or previous > int64_t(UINT32_MAX)) return false;
+                (*columns[i])[j] = previous;
+            }
+        }
+        for(uint32_t j = 0; j < kCount; j++)
+        {
+            if(frame.fVehicles[j] >= fVehicles.size()) return false;
+        }
+
+        const uint64_t kBlock = fChunk * fHeader.fChunkBlocks + fBlock;
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            for(uint32_t j = 0; j < kCount; j++)
+            {
+                // a vehicle is only once in a block, so its reference can be replaced right away
+                const uint32_t kId = frame.fVehicles[j];
+                int64_t delta;
+                if(not getSigned(kData, kEnd, delta)) return false;
+                const int64_t kReference = fBlock > 0 and fPreviousBlock[kId] == kBlock ? fPrevious[3 * kId + i] : 0;
+                fPrevious[3 * kId + i] = kReference + delta;
+                (*values[i])[j] = (kReference + delta) * fHeader.fResolution[i];
+            }
+        }
+        if(kData != kEnd) return false;
+        for(uint32_t j = 0; j < kCount; j++) fPreviousBlock[frame.fVehicles[j]] = kBlock + 1;
+    }
+
+    for(uint32_t j = 0; j < kCount; j++)
+    {
+        if(frame.fVehicles[j] >= fVehicles.size() or frame.fRoads[j] >= fRoads.size()) return false;
+    }
+    fTick = block.fTick;
+    fBlock++;
+    return true;
+}
@@ -0,0 +1,121 @@
+//============================================================================
+// @name        : TrajectoryParser.h
+// @author      : Thomas Dooms
+// @date        : 5/28/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : reads the ticks of a binary trajectory in any order
+//============================================================================
+
+#ifndef SIMULATION_TRAJECTORYPARSER_H
+#define SIMULATION_TRAJECTORYPARSER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include "../exporters/TrajectoryExporter.h"
+
+/**
+ * the vehicles of one tick, the columns have an entry for every vehicle
+ */
+struct TrajectoryFrame
+{
+    uint32_t fTick;
+    std::vector<uint32_t> fVehicles;    // index in getVehicles
+    std::vector<uint32_t> fRoads;       // index in getRoads
+    std::vector<uint32_t> fLanes;
+    std::vector<double> fPositions;
+    std::vector<double> fVelocities;
+    std::vector<double> fAccelerations;
+};
+
+class TrajectoryParser
+{
+public:
+    /**
+     * ENSURE(this->properlyInitialized(), "TrajectoryParser was not initialized when constructed");
+     */
+    TrajectoryParser();
+
+    bool properlyInitialized() const;
+
+    /**
+     * true if the file starts like a trajectory, this does not check the rest of the file
+     */
+    static bool isTrajectory(const std::string& kFilename);
+
+    /**
+     * reads the header, the chunk index and the tables of the trajectory. Returns false if the file is not a
+     * finished trajectory, the blocks themselves are only checked when they are read.
+     *
+     * REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling open");
+     */
+    bool open(const std::string& kFilename);
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getEncoding");
+     */
+    ETrajectoryEncoding getEncoding() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getRoads");
+     */
+    const std::vector<std::string>& getRoads() const;
+
+    /**
+     * the type and license plate of every vehicle
+     *
+     * REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getVehicles");
+     */
+    const std::vector<std::pair<EVehicleType, std::string> >& getVehicles() const;
+
+    /**
+     * REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getChunks");
+     */
+    const std::vector<TrajectoryChunk>& getChunks() const;
+
+    /**
+     * the ticks of all blocks, only the block headers are read
+     *
+     * REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling getTicks");
+     */
+    std::vector<uint32_t> getTicks();
+
+    /**
+     * reads the block of kTick into frame. Only the chunk of the tick is read, reading the ticks of a chunk in
+     * increasing order continues where the previous read stopped. Returns false if the tick is not in the trajectory
+     * or its block is corrupt.
+     *
+     * REQUIRE(this->properlyInitialized(), "TrajectoryParser was not initialized when calling readTick");
+     */
+    bool readTick(uint32_t kTick, TrajectoryFrame& frame);
+
+private:
+    /**
+     * reads the header and the tables into the parser, returns false if the file is not a finished trajectory
+     */
+    bool load(const std::string& kFilename);
+
+    /**
+     * reads the next block of the chunk into frame and keeps the state the delta encoding refers to
+     */
+    bool readBlock(TrajectoryFrame& frame);
+
+    std::ifstream fFile;
+    TrajectoryHeader fHeader;
+    std::vector<TrajectoryChunk> fChunks;
+    std::vector<std::string> fRoads;
+    std::vector<std::pair<EVehicleType, std::string> > fVehicles;
+
+    // where the previous read stopped
+    uint64_t fChunk;                    // the chunk that is read, fChunks.size() if none is
+    uint64_t fBlock;                    // the next block in that chunk
+    uint32_t fTick;                     // the tick of the previous block, only valid when fBlock > 0
+    std::vector<int64_t> fPrevious;     // the rounded state of every vehicle in the previous block
+    std::vector<uint64_t> fPreviousBlock;
+
+    const TrajectoryParser* _initCheck;
+};
+
+
+#endif //SIMULATION_TRAJECTORYPARSER_H
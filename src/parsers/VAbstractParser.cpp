@@ -8,6 +8,8 @@
 //============================================================================
 
 #include <iostream>
+#include <algorithm>
+#include <stdint.h>
 #include "VAbstractParser.h"
 #include "../DesignByContract.h"
 
@@ -22,6 +24,138 @@ bool VAbstractParser::loadFile(const std::string &kFilename) {
     return true;
 }
 
+bool VAbstractParser::openFile(const std::string &kFilename) {
+    REQUIRE(this->properlyInitialized(), "Parser was not initialized when calling openFile");
+    clear();
+    fStream.open(kFilename.c_str(), std::ios::binary);
+    if (!fStream.is_open()) {
+        std::cerr << "Failed to open file\n";
+        return false;
+    }
+    for (size_t pos = findMarkup(0); pos != std::string::npos; pos = findMarkup(pos)) { //sla de declaratie en commentaar over
+        EMarkup markup;
+        const size_t kEnd = skipMarkup(pos, markup);
+        if (kEnd == std::string::npos || markup == kClose) {
+            break;
+        }
+        if (markup != kSkipped) {
+            fRootName = readName(pos + 1);
+            fRootOpen = markup == kOpen;
+            fOffset = kEnd;
+            return true;
+        }
+        pos = kEnd;
+    }
+    std::cerr << "Error document empty\n";
+    return false;
+}
+
+bool VAbstractParser::nextElement(TiXmlElement *&element) {
+    REQUIRE(this->properlyInitialized(), "Parser was not initialized when calling nextElement");
+    REQUIRE(fStream.is_open(), "Failed to read element: no file opened");
+    element = NULL;
+    if (fOffset >= fBuffer.size() / 2) { //gooi het gelezen deel van de buffer weg
+        fBuffer.erase(0, fOffset);
+        fOffset = 0;
+    }
+    size_t pos = fOffset;
+    while (fRootOpen) {
+        pos = findMarkup(pos);
+        EMarkup markup = kSkipped;
+        size_t end = pos == std::string::npos ? pos : skipMarkup(pos, markup);
+        if (end == std::string::npos || (markup == kClose && readName(pos + 2) != fRootName)) {
+            break;
+        }
+        if (markup == kClose) {
+            fRootOpen = false;
+            fOffset = end;
+            return true;
+        }
+        if (markup == kSkipped) {
+            pos = end;
+            continue;
+        }
+        const size_t kBegin = pos;
+        for (uint32_t depth = markup == kOpen; depth > 0 && end != std::string::npos;) { //zoek de sluitende tag
+            pos = findMarkup(end);
+            end = pos == std::string::npos ? pos : skipMarkup(pos, markup);
+            if (markup == kOpen) depth++;
+            if (markup == kClose) depth--;
+        }
+        if (end == std::string::npos) {
+            break;
+        }
+        fDoc.Clear();
+        fDoc.Parse(fBuffer.substr(kBegin, end - kBegin).c_str());
+        fOffset = end;
+        if (fDoc.Error()) {
+            std::cerr << fDoc.ErrorDesc();
+            return false;
+        }
+        element = fDoc.FirstChildElement();
+        return true;
+    }
+    if (!fRootOpen) {
+        return true;
+    }
+    std::cerr << "Error reading end tag\n";
+    return false;
+}
+
+bool VAbstractParser::fill() {
+    char chunk[1 << 16];
+    fStream.read(chunk, sizeof(chunk));
+    fBuffer.append(chunk, fStream.gcount());
+    return fStream.gcount() > 0;
+}
+
+size_t VAbstractParser::findMarkup(size_t pos) {
+    while (true) {
+        const size_t kFound = fBuffer.find('<', pos);
+        if (kFound != std::string::npos) return kFound;
+        pos = fBuffer.size();
+        if (!fill()) return std::string::npos;
+    }
+}
+
+size_t VAbstractParser::skipPast(size_t pos, const std::string &kToken) {
+    while (true) {
+        const size_t kFound = fBuffer.find(kToken, pos);
+        if (kFound != std::string::npos) return kFound + kToken.size();
+        pos = std::max(fBuffer.size(), kToken.size()) - kToken.size();
+        if (!fill()) return std::string::npos;
+    }
+}
+
+size_t VAbstractParser::skipMarkup(size_t pos, EMarkup &markup) {
+    while (fBuffer.size() < pos + 9 && fill());
+    markup = kSkipped;
+    if (fBuffer.compare(pos, 4, "<!--") == 0) return skipPast(pos + 4, "-->");
+    if (fBuffer.compare(pos, 9, "<![CDATA[") == 0) return skipPast(pos + 9, "]]>");
+    if (fBuffer.compare(pos, 2, "<?") == 0) return skipPast(pos + 2, "?>");
+    if (fBuffer.compare(pos, 2, "<!") == 0) return skipPast(pos + 2, ">");
+    char quote = 0;
+    for (size_t i = pos + 1;; i++) { //een '>' tussen aanhalingstekens sluit de tag niet af
+        if (i == fBuffer.size() && !fill()) return std::string::npos;
+        const char kChar = fBuffer[i];
+        if (quote) {
+            if (kChar == quote) quote = 0;
+        } else if (kChar == '"' || kChar == '\'') {
+            quote = kChar;
+        } else if (kChar == '>') {
+            if (fBuffer[pos + 1] == '/') markup = kClose;
+            else if (fBuffer[i - 1] == '/') markup = kEmpty;
+            else markup = kOpen;
+            return i + 1;
+        }
+    }
+}
+
+std::string VAbstractParser::readName(size_t pos) {
+    const size_t kEnd = fBuffer.find_first_of(" \t\r\n/>", pos);
+    return fBuffer.substr(pos, kEnd - pos);
+}
+
 TiXmlElement *VAbstractParser::getRoot() const {
 	REQUIRE(this->properlyInitialized(), "Parser was not initialized when calling getRoot");
 	ENSURE(fRoot, "Failed to get root: no root element");
@@ -47,6 +181,12 @@ void VAbstractParser::clear() {
 	REQUIRE(this->properlyInitialized(), "Parser was not initialized when calling clear");
 	fDoc.Clear();
 	fRoot = NULL;
+	fStream.close();
+	fStream.clear();
+	fBuffer.clear();
+	fOffset = 0;
+	fRootName.clear();
+	fRootOpen = false;
 }
 
 bool VAbstractParser::properlyInitialized() const {
@@ -56,6 +196,8 @@ bool VAbstractParser::properlyInitialized() const {
 VAbstractParser::VAbstractParser() {
 	_initCheck = this;
 	fRoot = NULL;
+	fOffset = 0;
+	fRootOpen = false;
 	ENSURE(this->properlyInitialized(), "Parser was not initialized when constructed");
 }
 
@@ -11,6 +11,7 @@
 #define SIMULATION_VABSTRACTPARSER_H
 
 #include "tinyxml/tinyxml.h"
+#include <fstream>
 #include <string>
 
 class VAbstractParser {
@@ -22,6 +23,20 @@ public:
      */
     bool loadFile(const std::string &kFilename);
 
+    /**
+     * 	Opens a file to read the children of its root element one by one with nextElement, without loading the whole document.
+     * 	REQUIRE(this->properlyInitialized(), "Parser was not initialized when calling openFile");
+     */
+    bool openFile(const std::string &kFilename);
+
+    /**
+     * 	Reads the next child element of the root, element is NULL after the last child.
+     * 	The element stays valid until the next call. Returns false if the file is malformed.
+     * 	REQUIRE(this->properlyInitialized(), "Parser was not initialized when calling nextElement");
+     * 	REQUIRE(fStream.is_open(), "Failed to read element: no file opened");
+     */
+    bool nextElement(TiXmlElement *&element);
+
     /**
      * 	REQUIRE(this->properlyInitialized(), "Parser was not initialized when calling getRoot");
      *	ENSURE(fRoot, "Failed to get root: no root element");
@@ -53,8 +68,29 @@ public:
     const std::string readElement(TiXmlElement *element, const std::string &kTag);
 
 private:
+    enum EMarkup {
+        kSkipped, kOpen, kClose, kEmpty
+    };
+
+    bool fill();
+
+    size_t findMarkup(size_t pos);
+
+    size_t skipPast(size_t pos, const std::string &kToken);
+
+    size_t skipMarkup(size_t pos, EMarkup &markup);
+
+    std::string readName(size_t pos);
+
     TiXmlElement *fRoot;
     TiXmlDocument fDoc;
+
+    std::ifstream fStream;
+    std::string fBuffer;
+    size_t fOffset;         // start of the part of fBuffer that is not parsed yet
+    std::string fRootName;
+    bool fRootOpen;
+
     VAbstractParser *_initCheck;
 };
 
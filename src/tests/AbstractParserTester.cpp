@@ -42,6 +42,39 @@ TEST_F(AbstractParserTester, LoadFile) {
                             "outputfiles/testoutputs/AbstractParserTester-LoadFile-expected.txt"));
 }
 
+TEST_F(AbstractParserTester, OpenFile) {
+    VAbstractParser parser;
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(parser.openFile(""));
+    EXPECT_FALSE(parser.openFile("FakeFile"));
+    for (uint32_t i = 4; i <= 10; i++) { //elk foutief bestand faalt ergens tijdens het lezen
+        const std::string kFile = "inputfiles/testinputs/test" + std::to_string(i) + ".xml";
+        bool good = parser.openFile(kFile);
+        TiXmlElement *element = NULL;
+        while (good) {
+            good = parser.nextElement(element);
+            if (!element) break;
+        }
+        EXPECT_FALSE(good) << kFile;
+    }
+    testing::internal::GetCapturedStderr();
+
+    EXPECT_TRUE(parser.openFile("inputfiles/testinputs/test11.xml"));
+    std::vector<std::string> types;
+    TiXmlElement *element = NULL;
+    while (parser.nextElement(element) && element) {
+        types.push_back(element->Value());
+        if (types.size() == 1) {
+            EXPECT_STREQ(parser.readElement(element, "nummerplaat").c_str(), "1THK180");
+        }
+    }
+    EXPECT_EQ(7u, types.size());
+    EXPECT_EQ("VOERTUIG", types.front());
+    EXPECT_EQ("FIETS", types.back());
+    parser.clear();
+    EXPECT_DEATH(parser.nextElement(element), "Failed to read element: no file opened");
+}
+
 TEST_F(AbstractParserTester, GetRoot) {
     VAbstractParser parser;
     EXPECT_DEATH(parser.getRoot(), "Failed to get root: no root element");
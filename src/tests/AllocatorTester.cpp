@@ -0,0 +1,94 @@
+//============================================================================
+// @name        : AllocatorTester.cpp
+// @author      : Thomas Dooms
+// @date        : 5/25/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description :
+//============================================================================
+
+#include <gtest/gtest.h>
+#include "../datatypes/Allocator.h"
+#include "../datatypes/TrafficSigns.h"
+#include "../datatypes/vehicles/Car.h"
+#include "../datatypes/vehicles/Bus.h"
+
+class AllocatorTester : public ::testing::Test
+{
+protected:
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_F(AllocatorTester, AllocatorPool)
+{
+    Pool pool(24, 4);
+    EXPECT_TRUE(pool.properlyInitialized());
+    EXPECT_EQ(pool.getBlockSize(), 24u);
+    EXPECT_EQ(pool.getNumUsed(), 0u);
+
+    // blocks of one chunk follow each other
+    std::vector<char*> blocks;
+    for(uint32_t i = 0; i < 10; i++) blocks.push_back(static_cast<char*>(pool.allocate()));
+    EXPECT_EQ(pool.getNumUsed(), 10u);
+    for(uint32_t i = 1; i < 4; i++) EXPECT_EQ(blocks[i] - blocks[i - 1], blocks[1] - blocks[0]);
+    EXPECT_GE(blocks[1] - blocks[0], 24);
+
+    // freed blocks are handed out first
+    pool.deallocate(blocks[5]);
+    pool.deallocate(blocks[2]);
+    EXPECT_EQ(pool.getNumUsed(), 8u);
+    EXPECT_EQ(pool.allocate(), blocks[2]);
+    EXPECT_EQ(pool.allocate(), blocks[5]);
+    EXPECT_EQ(pool.getNumUsed(), 10u);
+
+    for(uint32_t i = 0; i < blocks.size(); i++) pool.deallocate(blocks[i]);
+    EXPECT_EQ(pool.getNumUsed(), 0u);
+}
+
+TEST_F(AllocatorTester, AllocatorArena)
+{
+    Arena arena(64);
+    EXPECT_TRUE(arena.properlyInitialized());
+    EXPECT_EQ(arena.getNumBytes(), 0u);
+
+    char* first = static_cast<char*>(arena.allocate(8));
+    char* second = static_cast<char*>(arena.allocate(8));
+    EXPECT_EQ(static_cast<std::size_t>(second - first), alignof(std::max_align_t));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % alignof(std::max_align_t), 0u);
+
+    // objects bigger than a chunk do not waste the current chunk
+    char* big = static_cast<char*>(arena.allocate(1000));
+    char* third = static_cast<char*>(arena.allocate(8));
+    EXPECT_NE(big, third);
+    EXPECT_EQ(static_cast<std::size_t>(third - second), alignof(std::max_align_t));
+    EXPECT_GE(arena.getNumBytes(), 1024u);
+}
+
+TEST_F(AllocatorTester, AllocatorObjects)
+{
+    // a freed vehicle is replaced by the next vehicle of the same kind
+    Car* car = new Car("A", 0, 0);
+    Bus* bus = new Bus("B", 0, 0);
+    void* address = car;
+    delete car;
+    car = new Car("C", 10, 5);
+    EXPECT_EQ(static_cast<void*>(car), address);
+    EXPECT_EQ(car->getLicensePlate(), "C");
+
+    IVehicle* vehicle = bus;
+    delete vehicle;
+    delete car;
+
+    // traffic signs from an arena are given back with the arena, the others are deleted one by one
+    Arena arena;
+    Zone* zone = new (&arena) Zone(0, 50);
+    BusStop* stop = new (&arena) BusStop(20);
+    EXPECT_TRUE(zone->properlyInitialized());
+    EXPECT_TRUE(stop->properlyInitialized());
+    EXPECT_GE(arena.getNumBytes(), sizeof(Zone) + sizeof(BusStop));
+
+    TrafficLight* light = new TrafficLight(10);
+    EXPECT_TRUE(light->properlyInitialized());
+    delete light;
+}
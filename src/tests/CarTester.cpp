@@ -27,13 +27,31 @@ TEST_F(CarTester, constructor)
     EXPECT_DEATH(Car car("AAA-123",  0, -1), "Velocity must be greater than 0");
 }
 
+TEST_F(CarTester, kind)
+{
+    Car car("AAA-123", 0, 0);
+    Truck truck("BBB-123", 0, 0);
+
+    ASSERT_EQ(car.getKind(), kCar);
+    ASSERT_EQ(truck.getKind(), kTruck);
+    ASSERT_EQ(car.getType(), "auto");
+    ASSERT_EQ(truck.getType(), "vrachtwagen");
+
+    ASSERT_EQ(car.getConstants().fLength, car.getVehicleLength());
+    ASSERT_EQ(car.getConstants().fMaxSpeed, car.getMaxSpeed());
+    ASSERT_EQ(truck.getConstants().fMinAcceleration, truck.getMinAcceleration());
+    ASSERT_TRUE(car.getConstants().fCanChangeLane);
+    ASSERT_FALSE(truck.getConstants().fCanChangeLane);
+    ASSERT_EQ(&car.getConstants(), &Car("CCC-123", 0, 0).getConstants());
+}
+
 TEST_F(CarTester, move1)
 {
     IVehicle* car = new Car("AAA-123", 0, 0);
     const Zone* zone = new Zone(0, 100);
     Road road("E19", NULL, 5000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
     road.enqueue(car);
-    car->move(0,0, &road);
+    car->move(0,0, &road, 0);
 
     ASSERT_EQ(car->getPosition(), car->getMaxAcceleration());
     ASSERT_EQ(car->getVelocity(), car->getMaxAcceleration());
@@ -46,7 +64,7 @@ TEST_F(CarTester, move2)
     const Zone* zone = new Zone(0, 30);
     Road road("E19", NULL, 5000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
     road.enqueue(car);
-    car->move(0, 0, &road);
+    car->move(0, 0, &road, 0);
 
     ASSERT_EQ(car->getPosition(), 30);
     ASSERT_EQ(car->getVelocity(), 30);
@@ -65,6 +83,6 @@ TEST_F(CarTester, move3)
     road.enqueue(bus1);
     road.enqueue(car1);
 
-    EXPECT_DEATH(car1->move(0, 2, &road), "distance between vehicles must be greater than minVehicleDist");
+    EXPECT_DEATH(car1->move(0, 2, &road, 0), "distance between vehicles must be greater than minVehicleDist");
 }
 
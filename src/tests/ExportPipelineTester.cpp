@@ -0,0 +1,94 @@
+//============================================================================
+// @name        : ExportPipelineTester.cpp
+// @author      : Thomas Dooms
+// @date        : 5/27/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : Tests for ExportPipeline.
+//============================================================================
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include "../exporters/ExportPipeline.h"
+#include "../exporters/NetworkExporter.h"
+#include "Utils.h"
+
+namespace
+{
+    // formats slower the lower its number, so the jobs are formatted out of order
+    class OrderJob : public IExportJob
+    {
+    public:
+        OrderJob(uint32_t number, std::vector<uint32_t>& written) : fNumber(number), fWritten(written) {}
+
+        virtual void format() { std::this_thread::sleep_for(std::chrono::microseconds((fNumber * 7919) % 50)); }
+
+        virtual void write() { fWritten.push_back(fNumber); }
+
+        virtual uint64_t getSize() const { return 100; }
+
+    private:
+        const uint32_t fNumber;
+        std::vector<uint32_t>& fWritten;
+    };
+
+    class SectionObserver : public ISimulationObserver
+    {
+    public:
+        virtual bool beforeTick(const Network*) { return true; }
+
+        virtual void afterTick(const Network* kNetwork) { NetworkExporter::addSection(kNetwork, kNetwork->getTicksPassed()); }
+    };
+
+    std::string run()
+    {
+        Network* network = ParseTestNetwork("test13.xml");
+        if(network == NULL) return "";
+        SectionObserver observer;
+        const std::string kOutput = RunSimulation(network, &observer, "ExportPipelineTester");
+        delete network;
+
+        return kOutput + ReadFile("outputfiles/statistics.txt") + ReadFile("outputfiles/testoutputs/ExportPipelineTester-Simple.txt") +
+               ReadFile("outputfiles/testoutputs/ExportPipelineTester-Impression.txt");
+    }
+}
+
+class ExportPipelineTester : public ::testing::Test
+{
+protected:
+    virtual void SetUp() {}
+    virtual void TearDown() { ExportPipeline::stop(); }
+};
+
+TEST_F(ExportPipelineTester, Order)
+{
+    EXPECT_DEATH(ExportPipeline::push(NULL), "Cannot push an empty job");
+    EXPECT_DEATH(ExportPipeline::start(1, 0), "The pipeline needs room for at least one job");
+
+    std::vector<uint32_t> written;
+    ExportPipeline::push(new OrderJob(0, written));
+    EXPECT_EQ(1u, written.size());
+
+    // room for 3 jobs, so the pipeline pushes back often
+    ExportPipeline::start(4, 300);
+    EXPECT_EQ(4u, ExportPipeline::getWriters());
+    for(uint32_t i = 1; i < 1000; i++) ExportPipeline::push(new OrderJob(i, written));
+    ExportPipeline::flush();
+    ASSERT_EQ(1000u, written.size());
+    for(uint32_t i = 0; i < written.size(); i++) EXPECT_EQ(i, written[i]);
+
+    for(uint32_t i = 1000; i < 1100; i++) ExportPipeline::push(new OrderJob(i, written));
+    ExportPipeline::stop();
+    EXPECT_EQ(0u, ExportPipeline::getWriters());
+    EXPECT_EQ(1100u, written.size());
+}
+
+TEST_F(ExportPipelineTester, SameOutput)
+{
+    const std::string kExpected = run();
+    EXPECT_FALSE(kExpected.empty());
+    ExportPipeline::start(3);
+    EXPECT_EQ(kExpected, run());
+    ExportPipeline::start(1, 1);
+    EXPECT_EQ(kExpected, run());
+}
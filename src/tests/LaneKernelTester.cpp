@@ -0,0 +1,83 @@
+//============================================================================
+// @name        : LaneKernelTester.cpp
+// @author      : Thomas Dooms
+// @date        : 5/24/19
+// @version     :
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description :
+//============================================================================
+
+#include <cstring>
+#include <random>
+#include <gtest/gtest.h>
+#include "../datatypes/LaneKernel.h"
+
+class LaneKernelTester : public ::testing::Test
+{
+protected:
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+
+    static LaneBatch makeBatch(uint32_t kSize, uint32_t kSeed)
+    {
+        std::mt19937 generator(kSeed);
+        std::uniform_real_distribution<double> distribution(0, 1);
+
+        LaneBatch batch;
+        double leader = 5000;
+        for(uint32_t i = 0; i < kSize; i++)
+        {
+            const double kPosition = leader - 5 - 40 * distribution(generator);
+            const double kLength = (i % 5 == 0) ? 0 : 3 + 10 * distribution(generator);
+            batch.push(kPosition, 30 * distribution(generator), leader, 30 * distribution(generator), kLength,
+                       5 + 30 * distribution(generator), 0, 15 + 20 * distribution(generator), -2 - 6 * distribution(generator), 1 + 2 * distribution(generator));
+            leader = kPosition;
+        }
+        return batch;
+    }
+};
+
+TEST_F(LaneKernelTester, LaneKernelScalar)
+{
+    LaneBatch batch;
+    batch.push(100, 10, 150, 10, 4, 20, 0, 30, -4, 2);      // follows at a comfortable distance
+    batch.push(100, 10, 0, 0, 0, 20, 0, 30, -4, 2);         // no leader
+    batch.push(100, 10, 120, 0, 4, 20, 0, 30, -4, 2);       // leader is standing still close by
+    batch.push(100, 25, 0, 0, 0, 20, 0, 30, -4, 2);         // faster than the speed limit
+    followLeaders(batch, kScalar);
+
+    EXPECT_DOUBLE_EQ(batch.fAccelerations[0], 2);
+    EXPECT_DOUBLE_EQ(batch.fAccelerations[1], 2);
+    EXPECT_DOUBLE_EQ(batch.fAccelerations[2], -2.5);
+    EXPECT_DOUBLE_EQ(batch.fAccelerations[3], -4);
+    EXPECT_DOUBLE_EQ(batch.fVelocities[0], 12);
+    EXPECT_DOUBLE_EQ(batch.fPositions[0], 112);
+    EXPECT_DOUBLE_EQ(batch.fVelocities[2], 7.5);
+    EXPECT_DOUBLE_EQ(batch.fPositions[3], 121);
+
+    batch.clear();
+    EXPECT_EQ(batch.size(), 0u);
+    followLeaders(batch, kScalar);
+}
+
+TEST_F(LaneKernelTester, LaneKernelBitIdentical)
+{
+    // every size up to a few registers, so the remainder is tested as well
+    for(uint32_t set = kSSE2; set <= getInstructionSet(); set++)
+    {
+        for(uint32_t size = 0; size < 40; size++)
+        {
+            LaneBatch expected = makeBatch(size, size);
+            LaneBatch result = makeBatch(size, size);
+            followLeaders(expected, kScalar);
+            followLeaders(result, static_cast<EInstructionSet>(set));
+
+            for(uint32_t i = 0; i < size; i++)
+            {
+                EXPECT_EQ(std::memcmp(&expected.fAccelerations[i], &result.fAccelerations[i], sizeof(double)), 0);
+                EXPECT_EQ(std::memcmp(&expected.fVelocities[i], &result.fVelocities[i], sizeof(double)), 0);
+                EXPECT_EQ(std::memcmp(&expected.fPositions[i], &result.fPositions[i], sizeof(double)), 0);
+            }
+        }
+    }
+}
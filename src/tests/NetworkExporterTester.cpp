@@ -125,13 +125,11 @@ TEST_F(NetworkExporterTester, CgExport) {
 
     EXPECT_DEATH(NetworkExporter::cgExport(NULL, 0), "Failed to export to cg: no network");
 
+    // an empty network has nothing to draw
+    int res = system("rm outputfiles/cg.bmp >/dev/null 2>&1");
     NetworkExporter::cgExport(&test, 0);
     NetworkExporter::finish();
-    int res = system(
-            "mv outputfiles/cg.ini \"outputfiles/testoutputs/NetworkExporterTester-CGExport(empty).txt\" >/dev/null 2>&1");
-    EXPECT_EQ(0, res);
-    EXPECT_TRUE(FileCompare("outputfiles/testoutputs/NetworkExporterTester-CGExport(empty).txt",
-                            "outputfiles/testoutputs/NetworkExporterTester-CGExport(empty)-expected.txt"));
+    EXPECT_FALSE(FileExists("outputfiles/cg.bmp"));
 
     NetworkParser parser;
     bool loaded = parser.loadFile("inputfiles/testinputs/test13.xml");
@@ -141,21 +139,54 @@ TEST_F(NetworkExporterTester, CgExport) {
         Network *network = parser.parseNetwork(parser.getRoot());
         NetworkExporter::init(network, "test", "test");
         NetworkExporter::cgExport(network, 0);
+        NetworkExporter::cgExport(network, 3);
+        NetworkExporter::finish();
         testing::internal::GetCapturedStdout();
-        res = system(
-                "mv outputfiles/cg.ini \"outputfiles/testoutputs/NetworkExporterTester-CGExport(full).txt\" >/dev/null 2>&1");
-        EXPECT_EQ(0, res);
         res = system(
                 "mv outputfiles/cg.bmp \"outputfiles/testoutputs/NetworkExporterTester-CGExport(full).bmp\" >/dev/null 2>&1");
         EXPECT_EQ(0, res);
-        EXPECT_TRUE(FileCompare("outputfiles/testoutputs/NetworkExporterTester-CGExport(full).txt",
-                                "outputfiles/testoutputs/NetworkExporterTester-CGExport(full)-expected.txt"));
         EXPECT_TRUE(FileCompare("outputfiles/testoutputs/NetworkExporterTester-CGExport(full).bmp",
                                 "outputfiles/testoutputs/NetworkExporterTester-CGExport(full)-expected.bmp"));
+        EXPECT_TRUE(FileCompare("outputfiles/tick3.bmp",
+                                "outputfiles/testoutputs/NetworkExporterTester-CGExport(full)-expected.bmp"));
+        res = system("rm outputfiles/tick3.bmp >/dev/null 2>&1");
+        EXPECT_EQ(0, res);
 
-        NetworkExporter::finish();
         delete network;
     }
     res = system("rm outputfiles/test.txt >/dev/null 2>&1");
     EXPECT_EQ(0, res % 256);
 }
+
+TEST_F(NetworkExporterTester, CgExportCache) {
+    const uint32_t kTicks = 10;
+    NetworkParser parser;
+    ASSERT_TRUE(parser.loadFile("inputfiles/testinputs/test13.xml"));
+    testing::internal::CaptureStdout();
+
+    // one export draws every frame on the roads it keeps
+    Network *network = parser.parseNetwork(parser.getRoot());
+    ASSERT_TRUE(network);
+    NetworkExporter::init(network, "test", "test");
+    for (uint32_t i = 1; i <= kTicks; i++) {
+        network->update();
+        NetworkExporter::cgExport(network, i);
+    }
+    NetworkExporter::finish();
+    delete network;
+
+    // which looks the same as drawing the roads anew for every frame
+    network = parser.parseNetwork(parser.getRoot());
+    ASSERT_TRUE(network);
+    for (uint32_t i = 1; i <= kTicks; i++) {
+        network->update();
+        NetworkExporter::init(network, "test", "test");
+        NetworkExporter::cgExport(network, 0);
+        NetworkExporter::finish();
+        EXPECT_TRUE(FileCompare("outputfiles/cg.bmp", "outputfiles/tick" + std::to_string(i) + ".bmp"));
+    }
+    testing::internal::GetCapturedStdout();
+    delete network;
+    int res = system("rm outputfiles/cg.bmp outputfiles/tick*.bmp outputfiles/test.txt >/dev/null 2>&1");
+    EXPECT_EQ(0, res % 256);
+}
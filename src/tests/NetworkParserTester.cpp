@@ -34,9 +34,9 @@ TEST_F(NetworkParserTester, ParseNetwork) {
         Network *network = parser.parseNetwork(parser.getRoot());
         EXPECT_TRUE(network);
         testing::internal::CaptureStdout();
-        network->startSimulation(NULL, "simple", "impression", true);
+        network->startSimulation(NULL, "simple", "impression");
         testing::internal::GetCapturedStdout();
-        EXPECT_EQ(230, network->getTicksPassed());
+        EXPECT_EQ(231, network->getTicksPassed());
         delete network;
     }
     testing::internal::CaptureStderr();
@@ -56,6 +56,47 @@ TEST_F(NetworkParserTester, ParseNetwork) {
     }
 }
 
+TEST_F(NetworkParserTester, ParseFile) {
+    NetworkParser parser;
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(parser.parseFile("FakeFile"));
+    EXPECT_FALSE(parser.parseFile("inputfiles/testinputs/test9.xml"));
+    testing::internal::GetCapturedStderr();
+
+    Network *network = parser.parseFile("inputfiles/testinputs/test1.xml");
+    EXPECT_TRUE(network);
+    if (network) {
+        testing::internal::CaptureStdout();
+        network->startSimulation(NULL, "simple", "impression");
+        testing::internal::GetCapturedStdout();
+        EXPECT_EQ(231, network->getTicksPassed());
+        delete network;
+    }
+
+    testing::internal::CaptureStderr();
+    Network *temp = parser.parseFile("inputfiles/testinputs/test11.xml");
+    delete temp;
+    std::ofstream out("outputfiles/testoutputs/NetworkParserTester-ParseFile.txt");
+    EXPECT_TRUE(out.is_open());
+    out << testing::internal::GetCapturedStderr();
+    out.close();
+    EXPECT_TRUE(FileCompare("outputfiles/testoutputs/NetworkParserTester-ParseFile.txt",
+                            "outputfiles/testoutputs/NetworkParserTester-ParseNetwork-expected.txt"));
+
+    //verkeerstekens, voertuigen en verbindingen mogen voor hun baan staan
+    network = parser.parseFile("inputfiles/testinputs/test14.xml");
+    EXPECT_TRUE(network);
+    if (network) {
+        const std::vector<Road *> &kRoads = network->getRoads();
+        EXPECT_EQ(2u, kRoads.size());
+        EXPECT_EQ(NULL, kRoads[0]->getNextRoad());
+        EXPECT_EQ(kRoads[0], kRoads[1]->getNextRoad());
+        EXPECT_EQ(1u, kRoads[1]->getBusStops().size());
+        EXPECT_EQ(1u, kRoads[1]->getNumVehicles());
+        delete network;
+    }
+}
+
 TEST_F(NetworkParserTester, GetNetwork) {
     NetworkParser parser;
     EXPECT_DEATH(parser.getNetwork(), "Failed to parse network: no network");
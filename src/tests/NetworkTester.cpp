@@ -7,9 +7,12 @@
 // @description :
 //============================================================================
 
+#include <algorithm>
 #include <gtest/gtest.h>
 #include "../datatypes/Network.h"
 #include "../datatypes/vehicles/Car.h"
+#include "../datatypes/vehicles/Bus.h"
+#include "../datatypes/vehicles/Truck.h"
 
 class NetworkTester : public ::testing::Test
 {
@@ -18,6 +21,31 @@ protected:
 
     virtual void SetUp(){}
     virtual void TearDown(){}
+
+    // three corridors that do not interact, the first one has a road that merges into it
+    static std::vector<Road*> makeCorridors()
+    {
+        std::vector<Road*> roads;
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            const std::vector<const Zone*> kZones(1, new Zone(0, 20 + 5 * i));
+            Road* next = new Road("B" + std::to_string(i), NULL, 1000, 1, kZones, std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
+            Road* road = new Road("A" + std::to_string(i), next, 500, 1, kZones, std::vector<const BusStop*>(1, new BusStop(250)), std::vector<const TrafficLight*>(1, new TrafficLight(400)));
+            roads.push_back(road);
+            roads.push_back(next);
+            for(uint32_t j = 0; j < 6; j++)
+            {
+                const std::string kName = std::to_string(i) + "-" + std::to_string(j);
+                if(j % 3 == 0) road->enqueue(new Bus("B" + kName, 300 - 50 * j, 10));
+                else if(j % 3 == 1) road->enqueue(new Truck("T" + kName, 300 - 50 * j, 5));
+                else next->enqueue(new Car("C" + kName, 600 - 80 * j, 15));
+            }
+        }
+        const std::vector<const Zone*> kZones(1, new Zone(0, 30));
+        roads.push_back(new Road("M", roads[1], 300, 1, kZones, std::vector<const BusStop*>(), std::vector<const TrafficLight*>()));
+        roads.back()->enqueue(new Car("M", 100, 20));
+        return roads;
+    }
 };
 
 TEST_F(NetworkTester, NetworkSimulation1)
@@ -27,7 +55,7 @@ TEST_F(NetworkTester, NetworkSimulation1)
     roads.push_back(new Road("E13", NULL, 150, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>()));
     Network network(roads);
     testing::internal::CaptureStdout();
-    network.startSimulation(NULL, "simple", "impression", true);
+    network.startSimulation(NULL, "simple", "impression");
     testing::internal::GetCapturedStdout();
     EXPECT_EQ(network.getTicksPassed(), 1);
 }
@@ -40,8 +68,186 @@ TEST_F(NetworkTester, NetworkSimulation2)
     roads[0]->enqueue(new Car("ABC", 0, 0));
     Network network(roads);
     testing::internal::CaptureStdout();
-    network.startSimulation(NULL, "simple", "impression", true);
+    network.startSimulation(NULL, "simple", "impression");
     testing::internal::GetCapturedStdout();
     EXPECT_GT(network.getTicksPassed(), 0);
     EXPECT_EQ(roads[0]->isEmpty(), true);
 }
+
+class CountingObserver : public ISimulationObserver
+{
+public:
+    CountingObserver() : fBefore(0), fAfter(0) {}
+    virtual bool beforeTick(const Network*) { return ++fBefore % 2 == 0; }
+    virtual void afterTick(const Network*) { fAfter++; }
+
+    int fBefore;
+    int fAfter;
+};
+
+TEST_F(NetworkTester, NetworkSimulation3)
+{
+    std::vector<Road*> roads;
+    const Zone* zone = new Zone(0, 10);
+    roads.push_back(new Road("E13", NULL, 5000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>()));
+    roads[0]->enqueue(new Car("ABC", 0, 0));
+    Network network(roads);
+    EXPECT_DEATH(network.setMaxTicks(-1), "Amount of ticks must be a positive integer");
+    network.setMaxTicks(10);
+    EXPECT_EQ(network.getMaxTicks(), 10);
+
+    CountingObserver observer;
+    testing::internal::CaptureStdout();
+    network.startSimulation(&observer, "simple", "impression");
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(network.getTicksPassed(), 10);
+    EXPECT_EQ(observer.fAfter, 10);
+    EXPECT_EQ(observer.fBefore, 20);
+}
+
+TEST_F(NetworkTester, NetworkSimulation4)
+{
+    std::vector<Road*> roads;
+    const Zone* zone = new Zone(0, 10);
+    roads.push_back(new Road("E13", NULL, 50000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>()));
+    roads[0]->enqueue(new Car("ABC", 0, 0));
+    Network network(roads);
+    EXPECT_DEATH(network.setMaxTime(-1), "Amount of seconds must be positive");
+    EXPECT_DEATH(network.setSteadyState(5, -1), "Threshold must be positive");
+    network.setSteadyState(5, 0);
+
+    testing::internal::CaptureStdout();
+    network.startSimulation(NULL, "simple", "impression");
+    testing::internal::GetCapturedStdout();
+
+    // the car reaches the speed limit after 5 ticks, after which nothing changes anymore
+    EXPECT_EQ(network.getStopReason(), Network::kSteadyState);
+    EXPECT_EQ(network.getTicksPassed(), 10);
+    EXPECT_EQ(network.getStatistics().first, 10);
+}
+
+TEST_F(NetworkTester, NetworkSimulation5)
+{
+    std::vector<Road*> roads;
+    const Zone* zone = new Zone(0, 10);
+    roads.push_back(new Road("E13", NULL, 50000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>()));
+    roads[0]->enqueue(new Car("ABC", 0, 0));
+    Network network(roads);
+    network.setMaxTicks(20);
+
+    testing::internal::CaptureStdout();
+    network.startSimulation(NULL, "simple", "impression");
+    testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(network.getStopReason(), Network::kMaxTicks);
+    EXPECT_EQ(network.getTicksPassed(), 20);
+}
+
+TEST_F(NetworkTester, NetworkThreads)
+{
+    std::vector<Road*> roads = makeCorridors();
+    RoadScheduler* scheduler = new RoadScheduler(roads, 4);
+    EXPECT_EQ(scheduler->getNumComponents(), 3u);
+    EXPECT_EQ(scheduler->getNumThreads(), 3u);
+    delete scheduler;
+    for(uint32_t i = 0; i < roads.size(); i++) delete roads[i];
+
+    Network sequential(makeCorridors());
+    Network parallel(makeCorridors());
+    EXPECT_DEATH(parallel.setThreads(0), "Amount of threads must be greater than 0");
+    parallel.setThreads(4);
+    EXPECT_EQ(parallel.getThreads(), 4u);
+
+    for(uint32_t tick = 0; tick < 120; tick++)
+    {
+        EXPECT_EQ(sequential.update(), parallel.update());
+        for(uint32_t i = 0; i < sequential.getRoads().size(); i++)
+        {
+            const Lane& kExpected = (*sequential.getRoads()[i])[0];
+            const Lane& kActual = (*parallel.getRoads()[i])[0];
+            ASSERT_EQ(kExpected.size(), kActual.size());
+            for(uint32_t j = 0; j < kExpected.size(); j++)
+            {
+                EXPECT_EQ(kExpected[j]->getLicensePlate(), kActual[j]->getLicensePlate());
+                EXPECT_EQ(kExpected[j]->getPosition(), kActual[j]->getPosition());
+                EXPECT_EQ(kExpected[j]->getVelocity(), kActual[j]->getVelocity());
+            }
+        }
+    }
+}
+
+TEST_F(NetworkTester, NetworkDoubleBuffered)
+{
+    std::vector<Road*> reversed = makeCorridors();
+    std::reverse(reversed.begin(), reversed.end());
+
+    Network ordered(makeCorridors());
+    Network backwards(reversed);
+    Network parallel(makeCorridors());
+    EXPECT_FALSE(ordered.isDoubleBuffered());
+    ordered.setDoubleBuffered(true);
+    backwards.setDoubleBuffered(true);
+    parallel.setDoubleBuffered(true);
+    parallel.setThreads(4);
+    EXPECT_TRUE(ordered.isDoubleBuffered());
+
+    // the order in which the roads are updated does not matter anymore
+    const uint32_t kRoads = ordered.getRoads().size();
+    for(uint32_t tick = 0; tick < 120; tick++)
+    {
+        const bool kDone = ordered.update();
+        EXPECT_EQ(kDone, backwards.update());
+        EXPECT_EQ(kDone, parallel.update());
+        for(uint32_t i = 0; i < kRoads; i++)
+        {
+            const Lane& kExpected = ordered.getRoads()[i]->getLane(0);
+            const Lane& kBackwards = backwards.getRoads()[kRoads - 1 - i]->getLane(0);
+            const Lane& kParallel = parallel.getRoads()[i]->getLane(0);
+            ASSERT_EQ(kExpected.size(), kBackwards.size());
+            ASSERT_EQ(kExpected.size(), kParallel.size());
+            for(uint32_t j = 0; j < kExpected.size(); j++)
+            {
+                EXPECT_EQ(kExpected[j]->getLicensePlate(), kBackwards[j]->getLicensePlate());
+                EXPECT_EQ(kExpected.getPosition(j), kBackwards.getPosition(j));
+                EXPECT_EQ(kExpected.getVelocity(j), kBackwards.getVelocity(j));
+                EXPECT_EQ(kExpected.getPosition(j), kParallel.getPosition(j));
+                EXPECT_EQ(kExpected[j]->getPosition(), kExpected.getPosition(j));
+            }
+        }
+    }
+}
+
+TEST_F(NetworkTester, NetworkLaneKernel)
+{
+    Network scalar(makeCorridors());
+    Network kernel(makeCorridors());
+    Network validate(makeCorridors());
+    scalar.setDoubleBuffered(true);
+    kernel.setDoubleBuffered(true);
+    validate.setDoubleBuffered(true);
+    EXPECT_EQ(kernel.getKernelMode(), kKernelOff);
+    kernel.setKernelMode(kKernelOn);
+    validate.setKernelMode(kKernelValidate);
+    EXPECT_EQ(kernel.getKernelMode(), kKernelOn);
+
+    const uint32_t kRoads = scalar.getRoads().size();
+    for(uint32_t tick = 0; tick < 120; tick++)
+    {
+        const bool kDone = scalar.update();
+        EXPECT_EQ(kDone, kernel.update());
+        EXPECT_EQ(kDone, validate.update());
+        for(uint32_t i = 0; i < kRoads; i++)
+        {
+            const Lane& kExpected = scalar.getRoads()[i]->getLane(0);
+            const Lane& kKernel = kernel.getRoads()[i]->getLane(0);
+            ASSERT_EQ(kExpected.size(), kKernel.size());
+            for(uint32_t j = 0; j < kExpected.size(); j++)
+            {
+                EXPECT_EQ(kExpected.getPosition(j), kKernel.getPosition(j));
+                EXPECT_EQ(kExpected.getVelocity(j), kKernel.getVelocity(j));
+                EXPECT_EQ(kExpected.getAcceleration(j), kKernel.getAcceleration(j));
+            }
+        }
+    }
+    EXPECT_EQ(validate.getKernelMismatches(), 0u);
+}
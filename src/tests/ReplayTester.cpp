@@ -0,0 +1,189 @@
+//============================================================================
+// @name        : ReplayTester.cpp
+// @author      : Thomas Dooms
+// @date        : 5/28/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : Tests for ReplayExporter.
+//============================================================================
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <cstring>
+#include "../exporters/NetworkExporter.h"
+#include "../exporters/ExportPipeline.h"
+#include "../exporters/ReplayExporter.h"
+#include "Utils.h"
+
+namespace
+{
+    // adds a frame to the replay after every tick and exports the same frame as a bmp to compare it with
+    class ReplayObserver : public ISimulationObserver
+    {
+    public:
+        virtual bool beforeTick(const Network*) { return true; }
+
+        virtual void afterTick(const Network* kNetwork)
+        {
+            ReplayExporter::addFrame(kNetwork);
+            NetworkExporter::cgExport(kNetwork, kNetwork->getTicksPassed());
+            fTicks.push_back(kNetwork->getTicksPassed());
+        }
+
+        std::vector<uint32_t> fTicks;
+    };
+
+    struct Frame
+    {
+        uint32_t fWidth;
+        uint32_t fHeight;
+        std::string fPixels;    // rgb, the top row first
+    };
+}
+
+class ReplayTester : public ::testing::Test
+{
+protected:
+    virtual void SetUp() {}
+
+    virtual void TearDown() { ExportPipeline::stop(); }
+
+    static ReplayObserver run(const EReplayFormat kFormat, const uint32_t kWriters)
+    {
+        Network* network = ParseTestNetwork("test13.xml");
+        ReplayObserver observer;
+        EXPECT_TRUE(network);
+        if(network == NULL) return observer;
+        network->setMaxTicks(8);
+
+        ExportPipeline::start(kWriters);
+        ReplayExporter::init("testoutputs/ReplayTester", kFormat);
+        RunSimulation(network, &observer, "ReplayTester");
+        EXPECT_EQ(observer.fTicks.size(), ReplayExporter::getFrames());
+        ReplayExporter::finish();
+        ExportPipeline::stop();
+        delete network;
+        return observer;
+    }
+
+    // the pixels of a 24 bit bmp, which stores its rows bottom up in bgr and pads them to 4 bytes
+    static Frame readBmp(const std::string& kPath)
+    {
+        const std::string kBmp = ReadFile(kPath);
+        Frame frame = {0, 0, ""};
+        if(kBmp.size() < 54) return frame;
+        uint32_t offset;
+        std::memcpy(&offset, kBmp.data() + 10, sizeof(offset));
+        std::memcpy(&frame.fWidth, kBmp.data() + 18, sizeof(frame.fWidth));
+        std::memcpy(&frame.fHeight, kBmp.data() + 22, sizeof(frame.fHeight));
+        const uint32_t kStride = (3 * frame.fWidth + 3) / 4 * 4;
+        for(uint32_t y = frame.fHeight; y > 0; y--)
+        {
+            for(uint32_t x = 0; x < frame.fWidth; x++)
+            {
+                const char* kPixel = kBmp.data() + offset + (y - 1) * kStride + 3 * x;
+                frame.fPixels += kPixel[2];
+                frame.fPixels += kPixel[1];
+                frame.fPixels += kPixel[0];
+            }
+        }
+        return frame;
+    }
+
+    static void removeFrames(const ReplayObserver& kObserver)
+    {
+        for(uint32_t i = 0; i < kObserver.fTicks.size(); i++)
+        {
+            std::remove(("outputfiles/tick" + std::to_string(kObserver.fTicks[i]) + ".bmp").c_str());
+        }
+    }
+};
+
+TEST_F(ReplayTester, Ppm)
+{
+    for(uint32_t writers = 0; writers <= 3; writers += 3)
+    {
+        const ReplayObserver kObserver = run(kReplayPpm, writers);
+        ASSERT_EQ(8u, kObserver.fTicks.size());
+
+        // every frame is a whole ppm image, in the order of the ticks
+        std::istringstream replay(ReadFile("outputfiles/testoutputs/ReplayTester.ppm"));
+        for(uint32_t i = 0; i < kObserver.fTicks.size(); i++)
+        {
+            const Frame kExpected = readBmp("outputfiles/tick" + std::to_string(kObserver.fTicks[i]) + ".bmp");
+            std::string magic;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t max = 0;
+            replay >> magic >> width >> height >> max;
+            replay.get();
+            EXPECT_EQ("P6", magic);
+            EXPECT_EQ(255u, max);
+            ASSERT_EQ(kExpected.fWidth, width);
+            ASSERT_EQ(kExpected.fHeight, height);
+            std::string pixels(3 * width * height, '\0');
+            replay.read(&pixels[0], pixels.size());
+            EXPECT_TRUE(kExpected.fPixels == pixels) << "frame " << i;
+        }
+        EXPECT_EQ(EOF, replay.peek());
+        removeFrames(kObserver);
+    }
+}
+
+TEST_F(ReplayTester, Y4m)
+{
+    for(uint32_t writers = 0; writers <= 3; writers += 3)
+    {
+        const ReplayObserver kObserver = run(kReplayY4m, writers);
+        ASSERT_EQ(8u, kObserver.fTicks.size());
+
+        // the stream has the size of the first frame
+        const std::string kReplay = ReadFile("outputfiles/testoutputs/ReplayTester.y4m");
+        const Frame kFirst = readBmp("outputfiles/tick" + std::to_string(kObserver.fTicks[0]) + ".bmp");
+        const std::string kHeader = "YUV4MPEG2 W" + std::to_string(kFirst.fWidth) + " H" + std::to_string(kFirst.fHeight) + " F25:1 Ip A1:1 C444\n";
+        ASSERT_EQ(kHeader, kReplay.substr(0, kHeader.size()));
+        const uint64_t kPlane = uint64_t(kFirst.fWidth) * kFirst.fHeight;
+        const uint64_t kFrameSize = 6 + 3 * kPlane;
+        ASSERT_EQ(kHeader.size() + kObserver.fTicks.size() * kFrameSize, kReplay.size());
+
+        for(uint32_t i = 0; i < kObserver.fTicks.size(); i++)
+        {
+            const Frame kExpected = readBmp("outputfiles/tick" + std::to_string(kObserver.fTicks[i]) + ".bmp");
+            const uint64_t kStart = kHeader.size() + i * kFrameSize;
+            EXPECT_EQ("FRAME\n", kReplay.substr(kStart, 6));
+
+            // the luma of the centred image, every pixel that fits in the stream
+            const int64_t kLeft = (int64_t(kFirst.fWidth) - kExpected.fWidth) / 2;
+            const int64_t kTop = (int64_t(kFirst.fHeight) - kExpected.fHeight) / 2;
+            uint32_t mismatches = 0;
+            for(uint32_t y = 0; y < kExpected.fHeight; y++)
+            {
+                for(uint32_t x = 0; x < kExpected.fWidth; x++)
+                {
+                    const int64_t kRow = kTop + y;
+                    const int64_t kColumn = kLeft + x;
+                    if(kRow < 0 or kRow >= kFirst.fHeight or kColumn < 0 or kColumn >= kFirst.fWidth) continue;
+                    const uint8_t* kPixel = reinterpret_cast<const uint8_t*>(&kExpected.fPixels[3 * (uint64_t(y) * kExpected.fWidth + x)]);
+                    const int kY = ((66 * kPixel[0] + 129 * kPixel[1] + 25 * kPixel[2] + 128) >> 8) + 16;
+                    if(static_cast<uint8_t>(kReplay[kStart + 6 + kRow * kFirst.fWidth + kColumn]) != kY) mismatches++;
+                }
+            }
+            EXPECT_EQ(0u, mismatches) << "frame " << i;
+        }
+        removeFrames(kObserver);
+    }
+}
+
+TEST_F(ReplayTester, Invalid)
+{
+    EXPECT_DEATH(ReplayExporter::init("testoutputs/ReplayTester", kReplayY4m, 0), "A replay plays at least one frame every second");
+    EXPECT_DEATH(ReplayExporter::addFrame(NULL), "ReplayExporter was not initialized when calling addFrame");
+    EXPECT_DEATH(ReplayExporter::getFrames(), "ReplayExporter was not initialized when calling getFrames");
+    EXPECT_DEATH(ReplayExporter::finish(), "ReplayExporter was not initialized when calling finish");
+
+    ReplayExporter::init("testoutputs/ReplayTester", kReplayPpm);
+    EXPECT_DEATH(ReplayExporter::addFrame(NULL), "NetworkExporter was not initialized when calling addFrame");
+    EXPECT_EQ(0u, ReplayExporter::getFrames());
+    ReplayExporter::finish();
+    EXPECT_FALSE(ReplayExporter::properlyInitialized());
+}
@@ -59,6 +59,27 @@ TEST_F(RoadParserTester, GetRoad) {
     EXPECT_DEATH(parser.getRoad(), "Failed to parse road: no road");
 }
 
+TEST_F(RoadParserTester, FindRoad) {
+    RoadParser parser;
+    testing::internal::CaptureStderr();
+    bool loaded = parser.loadFile("inputfiles/testinputs/test2.xml");
+    EXPECT_EQ(true, loaded);
+    if (loaded) {
+        EXPECT_EQ(NULL, parser.findRoad("E19"));
+        std::vector<Road *> roads;
+        for (TiXmlElement *elem = parser.getRoot()->FirstChildElement(); elem != NULL; elem = elem->NextSiblingElement()) {
+            roads.push_back(parser.parseRoad(elem));
+        }
+        EXPECT_TRUE(roads[0]);
+        EXPECT_EQ(roads[0], parser.findRoad("E19"));
+        EXPECT_EQ(NULL, parser.findRoad("E20"));
+        EXPECT_EQ(NULL, parser.findRoad("E313"));
+        EXPECT_EQ(NULL, parser.findRoad(""));
+        delete roads[0];
+    }
+    testing::internal::GetCapturedStderr();
+}
+
 TEST_F(RoadParserTester, ParseConnection) {
     RoadParser parser;
     EXPECT_DEATH(parser.parseConnection(NULL), "Failed to parse connection: no element");
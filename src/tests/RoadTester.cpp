@@ -7,6 +7,7 @@
 // @description :
 //============================================================================
 
+#include <set>
 #include <gtest/gtest.h>
 #include "../datatypes/Road.h"
 #include "../datatypes/vehicles/Car.h"
@@ -45,7 +46,7 @@ TEST_F(RoadTester, RoadUpdate1)
     IVehicle* testCar = new Car("12R3", 30, 30);
 
     testRoad->enqueue(testCar);
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(0);
     ASSERT_FALSE(testRoad->isEmpty());
 }
 
@@ -56,7 +57,7 @@ TEST_F(RoadTester, RoadUpdate2)
     IVehicle* testCar = new Car("12R3", 50, 60);
 
     testRoad->enqueue(testCar);
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(0);
     ASSERT_TRUE(testRoad->isEmpty());
 }
 
@@ -67,9 +68,9 @@ TEST_F(RoadTester, RoadUpdate3)
     IVehicle* testCar = new Car("12R3", 50, 60);
 
     testRoad->enqueue(testCar);
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(0);
     testRoad->checkAndReset();
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(1);
     ASSERT_TRUE(testRoad->isEmpty());
 
     delete testRoad;
@@ -88,10 +89,10 @@ TEST_F(RoadTester, RoadUpdate4)
     IVehicle* testCar = new Car("12R3", 0, 130);
 
     testRoad->enqueue(testCar);
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(0);
     testRoad->checkAndReset();
     ASSERT_FALSE(testRoad->isEmpty());
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(1);
     ASSERT_TRUE(testRoad->isEmpty());
 
 
@@ -105,13 +106,13 @@ TEST_F(RoadTester, RoadUpdate5)
     IVehicle* testCar = new Car("12R3", 0, 69);
 
     testRoad->enqueue(testCar);
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(0);
     ASSERT_FALSE(testRoad->isEmpty());
     testRoad->checkAndReset();
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(1);
     ASSERT_FALSE(testRoad->isEmpty());
     testRoad->checkAndReset();
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(2);
     ASSERT_TRUE(testRoad->isEmpty());
 
 
@@ -127,13 +128,13 @@ TEST_F(RoadTester, RoadUpdate6)
 
     testRoad->enqueue(testCar);
 
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(0);
     ASSERT_FALSE(testRoad->isEmpty());
     testRoad->checkAndReset();
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(1);
     ASSERT_FALSE(testRoad->isEmpty());
     testRoad->checkAndReset();
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(2);
     ASSERT_TRUE(testRoad->isEmpty());
 
     delete testRoad;
@@ -150,7 +151,7 @@ TEST_F(RoadTester, RoadUpdate7)
     IVehicle* testCar1 = new Car("AE-12", 40, 120);
 
     testRoad3->enqueue(testCar1);
-    testRoad3->updateVehicles();
+    testRoad3->updateVehicles(0);
 
     ASSERT_TRUE(testRoad3->isEmpty());
     ASSERT_TRUE(testRoad2->isEmpty());
@@ -173,7 +174,7 @@ TEST_F(RoadTester, RoadUpdate8)
     testRoad->enqueue(testCar0);
     testRoad->enqueue(testCar1);
 
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(0);
     ASSERT_EQ(testCar0->getPosition(), 210+testCar0->getMaxAcceleration());
     ASSERT_EQ(testCar1->getPosition(), 30+testCar1->getMaxAcceleration());
 
@@ -189,7 +190,7 @@ TEST_F(RoadTester, RoadUpdate9)
     Car* testCar = new Car("12R3", 0, 120);
 
     testRoad->enqueue(testCar);
-    testRoad->updateVehicles();
+    testRoad->updateVehicles(0);
 
     ASSERT_EQ(testCar->getAcceleration(), testCar->getMinAcceleration());
 }
@@ -206,7 +207,7 @@ TEST_F(RoadTester, RoadUpdate10)
     Car* testCar0 = new Car("12R3", 20, 80);
 
     testRoad1->enqueue(testCar0);
-    testRoad1->updateVehicles();
+    testRoad1->updateVehicles(0);
 
     ASSERT_EQ(testCar0->getPosition(), 10+testCar0->getMinAcceleration());
     ASSERT_TRUE(testRoad1->isEmpty());
@@ -230,7 +231,7 @@ TEST_F(RoadTester, RoadUpdate11)
     Car* testCar0 = new Car("12R3", 25, 200);
 
     testRoad1->enqueue(testCar0);
-    testRoad1->updateVehicles();
+    testRoad1->updateVehicles(0);
 
     ASSERT_TRUE(testRoad1->isEmpty());
     ASSERT_TRUE(testRoad0->isEmpty());
@@ -254,7 +255,7 @@ TEST_F(RoadTester, RoadUpdate12)
     testRoad1->enqueue(testCar0);
     testRoad1->enqueue(testCar1);
 
-    testRoad1->updateVehicles();
+    testRoad1->updateVehicles(0);
 
     ASSERT_EQ(testCar0->getPosition(), 50+testCar0->getMinAcceleration());
     ASSERT_EQ(testCar1->getPosition(), 20+testCar1->getMinAcceleration());
@@ -264,4 +265,275 @@ TEST_F(RoadTester, RoadUpdate12)
 
     delete testRoad0;
     delete testRoad1;
-}
\ No newline at end of file
+}
+TEST_F(RoadTester, RoadEpoch)
+{
+    const Zone* zone = new Zone(0, 50);
+    Road* testRoad = new Road("E14", NULL, 200, 2, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
+    IVehicle* testCar0 = new Car("E0", 120, 10);
+    IVehicle* testCar1 = new Car("E1", 60, 10);
+
+    EXPECT_EQ(testRoad->getNumVehicles(), 0u);
+    testRoad->enqueue(testCar0);
+    testRoad->enqueue(testCar1);
+    EXPECT_EQ(testRoad->getNumVehicles(), 2u);
+    EXPECT_FALSE(testCar0->getMoved(0));
+
+    testRoad->updateVehicles(0);
+    EXPECT_TRUE(testCar0->getMoved(0));
+    EXPECT_TRUE(testCar1->getMoved(0));
+    EXPECT_FALSE(testCar0->getMoved(1));
+    EXPECT_FALSE(testCar1->getMoved(1));
+
+    // the road keeps counting a vehicle once while it is on two lanes
+    for(uint32_t i = 0; i < 20 and not testRoad->isEmpty(); i++)
+    {
+        std::set<const IVehicle*> vehicles;
+        for(uint32_t j = 0; j < testRoad->getNumLanes(); j++)
+        {
+            const Lane& kLane = testRoad->getLane(j);
+            for(uint32_t k = 0; k < kLane.size(); k++) vehicles.insert(kLane[k]);
+        }
+        EXPECT_EQ(testRoad->getNumVehicles(), vehicles.size());
+        testRoad->updateVehicles(i + 1);
+        testRoad->checkAndReset();
+    }
+    EXPECT_TRUE(testRoad->isEmpty());
+    EXPECT_EQ(testRoad->getNumVehicles(), 0u);
+
+    delete testRoad;
+}
+
+TEST_F(RoadTester, RoadLane)
+{
+    Lane lane;
+    ASSERT_TRUE(lane.properlyInitialized());
+    ASSERT_TRUE(lane.empty());
+    EXPECT_DEATH(lane.front(), "Assertion `Lane cannot be empty when calling front' failed.");
+
+    Car* testCar0 = new Car("12R3", 50, 10);
+    Car* testCar1 = new Car("AE-12", 10, 20);
+    Car* testCar2 = new Car("AE-13", 30, 15);
+
+    lane.pushBack(testCar0);
+    lane.pushBack(testCar1);
+    lane.insert(1, testCar2);
+
+    ASSERT_EQ(lane.size(), 3u);
+    ASSERT_EQ(lane[1], testCar2);
+    ASSERT_EQ(lane.getPosition(1), 30);
+    ASSERT_EQ(lane.getVelocity(2), 20);
+    ASSERT_EQ(&lane.getConstants(0), &testCar0->getConstants());
+    ASSERT_EQ(lane.find(testCar1), 2u);
+
+    testCar2->setPosition(35);
+    ASSERT_EQ(lane.getPosition(1), 30);
+    lane.store(1);
+    ASSERT_EQ(lane.getPosition(1), 35);
+
+    lane.setGhost(1);
+    testCar1->setPosition(40);
+    lane.storeAll();
+    ASSERT_EQ(lane.getPosition(2), 40);
+    ASSERT_EQ(lane.getFlags(1), Lane::kGhost);
+    ASSERT_EQ(lane.getFlags(2), 0);
+
+    lane.erase(0);
+    ASSERT_EQ(lane.front(), testCar2);
+    ASSERT_EQ(lane.getPosition(0), 35);
+    ASSERT_EQ(lane.find(testCar0), lane.size());
+    EXPECT_DEATH(lane.getVelocity(2), "Assertion `Index is out of range' failed.");
+
+    delete testCar0;
+    delete testCar1;
+    delete testCar2;
+}
+
+TEST_F(RoadTester, RoadLaneQueue)
+{
+    // vehicles enter at the back and leave at the front many times, the lane must stay in order
+    Lane lane;
+    std::vector<Car*> cars;
+    for(uint32_t i = 0; i < 100; i++) cars.push_back(new Car("Q" + std::to_string(i), 1000 - i, i));
+
+    uint32_t front = 0;
+    for(uint32_t i = 0; i < 100; i++)
+    {
+        lane.pushBack(cars[i]);
+        if(i % 3 == 2)
+        {
+            lane.erase(0);
+            front++;
+        }
+        ASSERT_EQ(lane.size(), i + 1 - front);
+        ASSERT_EQ(lane.front(), cars[front]);
+        ASSERT_EQ(lane.back(), cars[i]);
+    }
+    for(uint32_t i = 0; i < lane.size(); i++)
+    {
+        ASSERT_EQ(lane[i], cars[front + i]);
+        ASSERT_EQ(lane.getVelocity(i), front + i);
+        ASSERT_EQ(lane.find(cars[front + i]), i);
+    }
+
+    // the room that is left at the front is used again
+    lane.erase(0);
+    lane.insert(0, cars[front]);
+    ASSERT_EQ(lane.front(), cars[front]);
+    ASSERT_EQ(lane.getPosition(0), 1000 - front);
+    ASSERT_EQ(lane.getFlags(0), 0);
+
+    while(!lane.empty()) lane.erase(0);
+    lane.pushBack(cars[0]);
+    ASSERT_EQ(lane.size(), 1u);
+    ASSERT_EQ(lane.front(), cars[0]);
+
+    for(uint32_t i = 0; i < cars.size(); i++) delete cars[i];
+}
+
+TEST_F(RoadTester, RoadLaneSearch)
+{
+    Lane lane;
+    std::vector<Car*> cars;
+    for(uint32_t i = 0; i < 9; i++)
+    {
+        cars.push_back(new Car("S" + std::to_string(i), 900 - 100 * i, 10));
+        lane.pushBack(cars.back());
+    }
+    EXPECT_EQ(lane.findBehind(950), 0u);
+    EXPECT_EQ(lane.findBehind(850), 1u);
+    EXPECT_EQ(lane.findBehind(800), 2u);
+    EXPECT_EQ(lane.findBehind(50), 9u);
+
+    for(uint32_t i = 0; i < cars.size(); i++)
+    {
+        EXPECT_EQ(lane.find(cars[i], 0), i);
+        EXPECT_EQ(lane.find(cars[i], 4), i);
+        EXPECT_EQ(lane.find(cars[i], 20), i);
+    }
+    Car other("S9", 0, 0);
+    EXPECT_EQ(lane.find(&other, 3), lane.size());
+
+    for(uint32_t i = 0; i < cars.size(); i++) delete cars[i];
+}
+
+TEST_F(RoadTester, RoadLaneUpdate)
+{
+    const Zone* zone = new Zone(0, 160);
+    Road* testRoad = new Road("E13", NULL, 1000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
+
+    Car* testCar0 = new Car("12R3", 100, 20);
+    Car* testCar1 = new Car("AE-12", 0, 30);
+
+    testRoad->enqueue(testCar0);
+    testRoad->enqueue(testCar1);
+
+    testRoad->updateVehicles(0);
+
+    const Lane& lane = testRoad->getLane(0);
+    for(uint32_t i = 0; i < lane.size(); i++)
+    {
+        ASSERT_EQ(lane.getPosition(i), lane[i]->getPosition());
+        ASSERT_EQ(lane.getVelocity(i), lane[i]->getVelocity());
+        ASSERT_EQ(lane.getAcceleration(i), lane[i]->getAcceleration());
+    }
+    delete testRoad;
+}
+
+TEST_F(RoadTester, RoadSignCursor)
+{
+    const Zone* zone = new Zone(0, 100);
+    std::vector<const BusStop*> stops;
+    stops.push_back(new BusStop(100));
+    stops.push_back(new BusStop(300));
+    Road road("E13", NULL, 500, 1, std::vector<const Zone*>(1, zone), stops, std::vector<const TrafficLight*>(1, new TrafficLight(200)));
+
+    uint32_t stop = 0;
+    uint32_t light = 0;
+    for(double position = 0; position < 500; position += 7)
+    {
+        EXPECT_EQ(road.getBusStop(position, stop).first, road.getBusStop(position).first);
+        EXPECT_EQ(road.getTrafficLight(position, light).first, road.getTrafficLight(position).first);
+    }
+    EXPECT_EQ(road.getBusStop(450, stop).first, (const BusStop*)NULL);
+    EXPECT_EQ(road.getBusStop(150, stop).first, stops[1]);
+
+    const uint32_t kVersion = road.getSignVersion();
+    road.addBusStop(new BusStop(200));
+    EXPECT_NE(road.getSignVersion(), kVersion);
+    stop = 0;
+    EXPECT_EQ(road.getBusStop(150, stop).first->getPosition(), 200);
+    EXPECT_EQ(stop, 1u);
+}
+
+TEST_F(RoadTester, RoadSpeedProfile)
+{
+    std::vector<const Zone*> zones;
+    zones.push_back(new Zone(0, 50));
+    zones.push_back(new Zone(100, 50));
+    zones.push_back(new Zone(200, 30));
+    Road road("E13", NULL, 500, 1, zones, std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
+
+    EXPECT_EQ(road.getSpeedLimit(0), 50);
+    EXPECT_EQ(road.getSpeedLimit(150), 50);
+    EXPECT_EQ(road.getSpeedLimit(200), 30);
+
+    uint32_t index = 0;
+    for(double position = 0; position < 500; position += 9)
+    {
+        EXPECT_EQ(road.getSpeedLimit(position, index), road.getSpeedLimit(position));
+    }
+
+    road.enqueue(new Car("A", 250, 10));
+    road.enqueue(new Car("B", 120, 10));
+    road.enqueue(new Car("C", 10, 10));
+    std::vector<double> limits;
+    road.getSpeedLimits(0, limits);
+    ASSERT_EQ(limits.size(), 3u);
+    EXPECT_EQ(limits[0], 30);
+    EXPECT_EQ(limits[1], 50);
+    EXPECT_EQ(limits[2], 50);
+
+    zones[1]->setSpeedLimit(40);
+    EXPECT_EQ(road.getSpeedLimit(150), 40);
+    EXPECT_EQ(road.getSpeedLimit(150, index), 40);
+    EXPECT_EQ(road.getSpeedLimit(50), 50);
+
+    road.addZone(new Zone(300, 20));
+    road.getSpeedLimits(0, limits);
+    EXPECT_EQ(road.getSpeedLimit(350, index), 20);
+    EXPECT_EQ(limits[1], 40);
+}
+
+TEST_F(RoadTester, RoadRing)
+{
+    Road* roadA = new Road("A", NULL, 300, 1, std::vector<const Zone*>(1, new Zone(0, 20)), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
+    Road* roadB = new Road("B", roadA, 200, 1, std::vector<const Zone*>(1, new Zone(0, 20)), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
+    roadA->setNextRoad(roadB);
+
+    // the searches stop when they come back to the road they started on
+    IVehicle* testCar = new Car("R0", 100, 10);
+    roadA->enqueue(testCar);
+    EXPECT_EQ(roadA->getNextVehicle(0, 0).first, (const IVehicle*)NULL);
+    EXPECT_EQ(roadA->getNextLane(0).first, (const Lane*)NULL);
+    EXPECT_EQ(roadA->getBusStop(150).first, (const BusStop*)NULL);
+    EXPECT_EQ(roadA->getTrafficLight(150).first, (const TrafficLight*)NULL);
+
+    IVehicle* otherCar = new Car("R1", 20, 10);
+    roadB->enqueue(otherCar);
+    EXPECT_EQ(roadA->getNextVehicle(0, 0).first, otherCar);
+    EXPECT_EQ(roadA->getNextVehicle(0, 0).second, 300);
+
+    // the vehicles keep driving around without leaving the network
+    for(uint32_t i = 0; i < 100; i++)
+    {
+        roadA->updateVehicles(i);
+        roadB->updateVehicles(i);
+        ASSERT_EQ(roadA->getNumVehicles() + roadB->getNumVehicles(), 2u);
+        ASSERT_TRUE(testCar->getMoved(i));
+        ASSERT_TRUE(otherCar->getMoved(i));
+    }
+
+    delete roadA;
+    delete roadB;
+}
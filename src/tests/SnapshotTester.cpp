@@ -0,0 +1,215 @@
+//============================================================================
+// @name        : SnapshotTester.cpp
+// @author      : Thomas Dooms
+// @date        : 5/26/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : Tests for SnapshotExporter and SnapshotParser.
+//============================================================================
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../parsers/NetworkParser.h"
+#include "../parsers/SnapshotParser.h"
+#include "../exporters/SnapshotExporter.h"
+#include "../exporters/NetworkExporter.h"
+#include "Utils.h"
+
+// exports the state of the network after every tick, like the batch runs do
+class SectionObserver : public ISimulationObserver {
+public:
+    virtual bool beforeTick(const Network *) { return true; }
+
+    virtual void afterTick(const Network *kNetwork) {
+        NetworkExporter::addSection(kNetwork, kNetwork->getTicksPassed());
+    }
+};
+
+class SnapshotTester : public ::testing::Test {
+protected:
+    friend class SnapshotParser;
+
+    virtual void SetUp() {}
+
+    virtual void TearDown() {}
+
+    // the state of every vehicle as it is stored in the lanes and in the vehicle itself
+    static std::string state(const Network *kNetwork) {
+        std::ostringstream out;
+        out.precision(17);
+        for (uint32_t i = 0; i < kNetwork->getRoads().size(); i++) {
+            const Road *kRoad = kNetwork->getRoads()[i];
+            out << kRoad->getName() << " " << kRoad->getNumVehicles() << "\n";
+            for (uint32_t j = 0; j < kRoad->getNumLanes(); j++) {
+                const Lane &kLane = kRoad->getLane(j);
+                for (uint32_t k = 0; k < kLane.size(); k++) {
+                    out << j << " " << kLane[k]->getLicensePlate() << " " << kLane.getPosition(k) << " "
+                        << kLane.getVelocity(k) << " " << static_cast<int>(kLane.getFlags(k)) << " "
+                        << kLane[k]->getPosition() << " " << kLane[k]->getVelocity() << " "
+                        << kLane[k]->getAcceleration() << "\n";
+                }
+            }
+        }
+        return out.str();
+    }
+
+    static std::string outputs() {
+        return ReadFile("outputfiles/statistics.txt") + ReadFile("outputfiles/testoutputs/SnapshotTester-Simple.txt") +
+               ReadFile("outputfiles/testoutputs/SnapshotTester-Impression.txt");
+    }
+};
+
+TEST_F(SnapshotTester, RoundTrip) {
+    const char *kFiles[] = {"inputfiles/testinputs/test1.xml", "inputfiles/testinputs/test13.xml"};
+    for (uint32_t i = 0; i < 4; i++) {
+        NetworkParser parser;
+        testing::internal::CaptureStderr();
+        Network *original = parser.parseFile(kFiles[i % 2]);
+        testing::internal::GetCapturedStderr();
+        ASSERT_TRUE(original);
+        original->setDoubleBuffered(i >= 2);
+        for (uint32_t j = 0; j < 20; j++) original->update();
+
+        EXPECT_TRUE(SnapshotExporter::save(original, "outputfiles/testoutputs/SnapshotTester-RoundTrip.snap"));
+        EXPECT_TRUE(SnapshotParser::isSnapshot("outputfiles/testoutputs/SnapshotTester-RoundTrip.snap"));
+        SnapshotParser snapshotParser;
+        Network *restored = snapshotParser.parseSnapshot("outputfiles/testoutputs/SnapshotTester-RoundTrip.snap");
+        ASSERT_TRUE(restored);
+        restored->setDoubleBuffered(i >= 2);
+        EXPECT_EQ(restored, snapshotParser.getNetwork());
+        EXPECT_EQ(original->getTicksPassed(), restored->getTicksPassed());
+        EXPECT_EQ(state(original), state(restored));
+
+        // saving the restored network gives the same file, so nothing of the state is lost
+        EXPECT_TRUE(SnapshotExporter::save(restored, "outputfiles/testoutputs/SnapshotTester-RoundTrip2.snap"));
+        EXPECT_EQ(ReadFile("outputfiles/testoutputs/SnapshotTester-RoundTrip.snap"),
+                  ReadFile("outputfiles/testoutputs/SnapshotTester-RoundTrip2.snap"));
+
+        // and the restored network continues exactly like the original
+        for (uint32_t j = 0; j < 50; j++) {
+            const bool kDone = original->update();
+            EXPECT_EQ(kDone, restored->update());
+            EXPECT_EQ(state(original), state(restored));
+            if (kDone) break;
+        }
+        delete original;
+        delete restored;
+    }
+}
+
+TEST_F(SnapshotTester, Invalid) {
+    SnapshotParser parser;
+    EXPECT_DEATH(parser.getNetwork(), "Failed to parse snapshot: no network");
+    EXPECT_FALSE(SnapshotParser::isSnapshot("inputfiles/testinputs/test1.xml"));
+    EXPECT_FALSE(SnapshotParser::isSnapshot("FakeFile"));
+
+    Network *network = ParseTestNetwork("test13.xml");
+    ASSERT_TRUE(network);
+    EXPECT_TRUE(SnapshotExporter::save(network, "outputfiles/testoutputs/SnapshotTester-Invalid.snap"));
+    delete network;
+    const std::string kData = ReadFile("outputfiles/testoutputs/SnapshotTester-Invalid.snap");
+    const SnapshotHeader *kHeader = reinterpret_cast<const SnapshotHeader *>(kData.data());
+
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(parser.parseSnapshot("FakeFile"));
+
+    WriteFile("outputfiles/testoutputs/SnapshotTester-Invalid.snap", kData.substr(0, kData.size() - 8));
+    EXPECT_FALSE(parser.parseSnapshot("outputfiles/testoutputs/SnapshotTester-Invalid.snap"));
+
+    std::string corrupt = kData;
+    reinterpret_cast<SnapshotHeader *>(&corrupt[0])->fVersion = SnapshotExporter::fgkVersion + 1;
+    WriteFile("outputfiles/testoutputs/SnapshotTester-Invalid.snap", corrupt);
+    EXPECT_FALSE(parser.parseSnapshot("outputfiles/testoutputs/SnapshotTester-Invalid.snap"));
+
+    corrupt = kData;
+    SnapshotRoad *road = reinterpret_cast<SnapshotRoad *>(&corrupt[kHeader->fOffsets[kSnapshotRoads]]);
+    road->fNextRoad = kHeader->fCounts[kSnapshotRoads];
+    WriteFile("outputfiles/testoutputs/SnapshotTester-Invalid.snap", corrupt);
+    EXPECT_FALSE(parser.parseSnapshot("outputfiles/testoutputs/SnapshotTester-Invalid.snap"));
+
+    corrupt = kData;
+    road = reinterpret_cast<SnapshotRoad *>(&corrupt[kHeader->fOffsets[kSnapshotRoads]]);
+    road->fNumLanes++;
+    WriteFile("outputfiles/testoutputs/SnapshotTester-Invalid.snap", corrupt);
+    EXPECT_FALSE(parser.parseSnapshot("outputfiles/testoutputs/SnapshotTester-Invalid.snap"));
+
+    corrupt = kData;
+    SnapshotEntry *entry = reinterpret_cast<SnapshotEntry *>(&corrupt[kHeader->fOffsets[kSnapshotEntries]]);
+    entry->fVehicle = kHeader->fCounts[kSnapshotVehicles];
+    WriteFile("outputfiles/testoutputs/SnapshotTester-Invalid.snap", corrupt);
+    EXPECT_FALSE(parser.parseSnapshot("outputfiles/testoutputs/SnapshotTester-Invalid.snap"));
+    testing::internal::GetCapturedStderr();
+
+    WriteFile("outputfiles/testoutputs/SnapshotTester-Invalid.snap", kData);
+    network = parser.parseSnapshot("outputfiles/testoutputs/SnapshotTester-Invalid.snap");
+    EXPECT_TRUE(network);
+    delete network;
+}
+
+TEST_F(SnapshotTester, Checkpoint) {
+    const char *kCheckpoint = "outputfiles/testoutputs/SnapshotTester-Checkpoint.snap";
+    SectionObserver observer;
+    Network *network = ParseTestNetwork("test13.xml");
+    ASSERT_TRUE(network);
+    network->setMaxTicks(300);
+    RunSimulation(network, &observer, "SnapshotTester");
+    const std::string kExpected = outputs();
+    const std::string kExpectedState = state(network);
+    const int kExpectedTicks = network->getTicksPassed();
+    EXPECT_LT(105, kExpectedTicks);
+    delete network;
+
+    // the run is stopped 5 ticks after its last checkpoint, as if it was killed
+    network = ParseTestNetwork("test13.xml");
+    ASSERT_TRUE(network);
+    network->setMaxTicks(105);
+    network->setCheckpoints(50, kCheckpoint);
+    RunSimulation(network, &observer, "SnapshotTester");
+    delete network;
+    EXPECT_NE(kExpected, outputs());
+
+    SnapshotParser snapshotParser;
+    network = snapshotParser.parseSnapshot(kCheckpoint);
+    ASSERT_TRUE(network);
+    EXPECT_EQ(100, network->getTicksPassed());
+    network->setMaxTicks(300);
+    RunSimulation(network, &observer, "SnapshotTester");
+    EXPECT_EQ(kExpectedTicks, network->getTicksPassed());
+    EXPECT_EQ(kExpectedState, state(network));
+    EXPECT_EQ(kExpected, outputs());
+    delete network;
+}
+
+TEST_F(SnapshotTester, Ghost) {
+    const char *kPath = "outputfiles/testoutputs/SnapshotTester-Ghost.snap";
+    Network *network = ParseTestNetwork("test13.xml");
+    ASSERT_TRUE(network);
+    std::string data;
+    for (uint32_t i = 0; i < 300; i++) {
+        network->update();
+        EXPECT_TRUE(SnapshotExporter::save(network, kPath));
+        data = ReadFile(kPath);
+        if (reinterpret_cast<const SnapshotHeader *>(data.data())->fCounts[kSnapshotMerges] != 0) break;
+    }
+    delete network;
+    ASSERT_NE(0u, reinterpret_cast<const SnapshotHeader *>(data.data())->fCounts[kSnapshotMerges]);
+
+    SnapshotParser parser;
+    network = parser.parseSnapshot(kPath);
+    EXPECT_TRUE(network);
+    delete network;
+
+    // without its merge record the ghost of the last merging vehicle would never be removed
+    std::string corrupt = data;
+    SnapshotHeader *header = reinterpret_cast<SnapshotHeader *>(&corrupt[0]);
+    SnapshotRoad *roads = reinterpret_cast<SnapshotRoad *>(&corrupt[header->fOffsets[kSnapshotRoads]]);
+    const uint64_t kLast = --header->fCounts[kSnapshotMerges];
+    for (uint64_t i = 0; i < header->fCounts[kSnapshotRoads]; i++) {
+        if (roads[i].fFirstMerge > kLast) roads[i].fFirstMerge--;
+        else if (roads[i].fFirstMerge + roads[i].fNumMerges > kLast) roads[i].fNumMerges--;
+    }
+    WriteFile(kPath, corrupt);
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(parser.parseSnapshot(kPath));
+    EXPECT_NE(std::string::npos, testing::internal::GetCapturedStderr().find("ghost of a vehicle that does not merge"));
+}
@@ -0,0 +1,184 @@
+//============================================================================
+// @name        : TrajectoryTester.cpp
+// @author      : Thomas Dooms
+// @date        : 5/28/19
+// @version     : 1.0
+// @copyright   : BA1 Informatica - Thomas Dooms - University of Antwerp
+// @description : Tests for TrajectoryExporter and TrajectoryParser.
+//============================================================================
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include "../parsers/TrajectoryParser.h"
+#include "../exporters/TrajectoryExporter.h"
+#include "Utils.h"
+
+namespace
+{
+    struct VehicleState
+    {
+        std::string fLicensePlate;
+        std::string fRoad;
+        uint32_t fLane;
+        double fValues[3];
+    };
+
+    // exports the trajectory after every tick and keeps what it should contain
+    class TrajectoryObserver : public ISimulationObserver
+    {
+    public:
+        virtual bool beforeTick(const Network*) { return true; }
+
+        virtual void afterTick(const Network* kNetwork)
+        {
+            TrajectoryExporter::addSection(kNetwork, kNetwork->getTicksPassed());
+            fTicks.push_back(kNetwork->getTicksPassed());
+            fStates.push_back(std::vector<VehicleState>());
+            for(uint32_t i = 0; i < kNetwork->getRoads().size(); i++)
+            {
+                const Road* kRoad = kNetwork->getRoads()[i];
+                for(uint32_t j = 0; j < kRoad->getNumLanes(); j++)
+                {
+                    const Lane& kLane = kRoad->getLane(j);
+                    for(uint32_t k = 0; k < kLane.size(); k++)
+                    {
+                        if(kLane.getFlags(k) & Lane::kGhost) continue;
+                        const VehicleState kState = {kLane[k]->getLicensePlate(), kRoad->getName(), j,
+                                                     {kLane[k]->getPosition(), kLane[k]->getVelocity(), kLane[k]->getAcceleration()}};
+                        fStates.back().push_back(kState);
+                    }
+                }
+            }
+        }
+
+        std::vector<uint32_t> fTicks;
+        std::vector<std::vector<VehicleState> > fStates;
+    };
+}
+
+class TrajectoryTester : public ::testing::Test
+{
+protected:
+    virtual void SetUp() {}
+
+    virtual void TearDown() {}
+
+    static TrajectoryObserver run(const ETrajectoryEncoding kEncoding, const uint32_t kChunkBlocks)
+    {
+        Network* network = ParseTestNetwork("test13.xml");
+        TrajectoryObserver observer;
+        EXPECT_TRUE(network);
+        if(network == NULL) return observer;
+
+        TrajectoryExporter::init(network, "testoutputs/TrajectoryTester", kEncoding, kChunkBlocks);
+        RunSimulation(network, &observer, "TrajectoryTester");
+        TrajectoryExporter::finish();
+        delete network;
+        return observer;
+    }
+
+    static void compare(TrajectoryParser& parser, const TrajectoryObserver& kObserver, const uint32_t kIndex)
+    {
+        TrajectoryFrame frame;
+        ASSERT_TRUE(parser.readTick(kObserver.fTicks[kIndex], frame));
+        EXPECT_EQ(kObserver.fTicks[kIndex], frame.fTick);
+        const std::vector<VehicleState>& kStates = kObserver.fStates[kIndex];
+        ASSERT_EQ(kStates.size(), frame.fVehicles.size());
+
+        // raw blocks are exact, delta blocks are rounded to the resolution
+        const double kError = parser.getEncoding() == kTrajectoryRaw ? 0 : 0.0005 + 1e-9;
+        for(uint32_t i = 0; i < kStates.size(); i++)
+        {
+            EXPECT_EQ(kStates[i].fLicensePlate, parser.getVehicles()[frame.fVehicles[i]].second);
+            EXPECT_EQ(kStates[i].fRoad, parser.getRoads()[frame.fRoads[i]]);
+            EXPECT_EQ(kStates[i].fLane, frame.fLanes[i]);
+            EXPECT_LE(std::fabs(kStates[i].fValues[0] - frame.fPositions[i]), kError);
+            EXPECT_LE(std::fabs(kStates[i].fValues[1] - frame.fVelocities[i]), kError);
+            EXPECT_LE(std::fabs(kStates[i].fValues[2] - frame.fAccelerations[i]), kError);
+        }
+    }
+};
+
+TEST_F(TrajectoryTester, RoundTrip)
+{
+    const std::string kPath = "outputfiles/testoutputs/TrajectoryTester.traj";
+    uint64_t sizes[2] = {};
+    for(uint32_t encoding = kTrajectoryRaw; encoding <= kTrajectoryDelta; encoding++)
+    {
+        const TrajectoryObserver kObserver = run(static_cast<ETrajectoryEncoding>(encoding), 4);
+        ASSERT_FALSE(kObserver.fTicks.empty());
+        sizes[encoding] = ReadFile(kPath).size();
+
+        TrajectoryParser parser;
+        EXPECT_TRUE(TrajectoryParser::isTrajectory(kPath));
+        ASSERT_TRUE(parser.open(kPath));
+        EXPECT_EQ(encoding, parser.getEncoding());
+        EXPECT_EQ(kObserver.fTicks, parser.getTicks());
+        EXPECT_EQ((kObserver.fTicks.size() + 3) / 4, parser.getChunks().size());
+
+        // in order, backwards and jumping between chunks all give the same frames
+        for(uint32_t i = 0; i < kObserver.fTicks.size(); i++) compare(parser, kObserver, i);
+        for(uint32_t i = kObserver.fTicks.size(); i > 0; i--) compare(parser, kObserver, i - 1);
+        for(uint32_t i = 0; i < kObserver.fTicks.size(); i++) compare(parser, kObserver, (i * 7) % kObserver.fTicks.size());
+
+        TrajectoryFrame frame;
+        EXPECT_FALSE(parser.readTick(0, frame));
+        EXPECT_FALSE(parser.readTick(kObserver.fTicks.back() + 1, frame));
+    }
+    EXPECT_LT(sizes[kTrajectoryDelta] * 2, sizes[kTrajectoryRaw]);
+}
+
+TEST_F(TrajectoryTester, Invalid)
+{
+    const std::string kPath = "outputfiles/testoutputs/TrajectoryTester.traj";
+    const std::string kCorruptPath = "outputfiles/testoutputs/TrajectoryTester-Corrupt.traj";
+    TrajectoryParser parser;
+
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(parser.open("outputfiles/testoutputs/TrajectoryTester-Missing.traj"));
+    EXPECT_FALSE(parser.open("inputfiles/testinputs/test13.xml"));
+    EXPECT_FALSE(TrajectoryParser::isTrajectory("inputfiles/testinputs/test13.xml"));
+
+    const TrajectoryObserver kObserver = run(kTrajectoryDelta, 4);
+    ASSERT_LT(8u, kObserver.fTicks.size());
+    const std::string kTrajectory = ReadFile(kPath);
+    TrajectoryHeader header;
+    std::memcpy(&header, kTrajectory.data(), sizeof(header));
+
+    WriteFile(kCorruptPath, kTrajectory.substr(0, kTrajectory.size() - 1));
+    EXPECT_FALSE(parser.open(kCorruptPath));
+
+    // a trajectory that is still written has no tables yet
+    TrajectoryHeader unfinished = header;
+    unfinished.fSize = 0;
+    WriteFile(kCorruptPath, std::string(reinterpret_cast<const char*>(&unfinished), sizeof(unfinished)) + kTrajectory.substr(sizeof(unfinished)));
+    EXPECT_FALSE(parser.open(kCorruptPath));
+
+    TrajectoryHeader version = header;
+    version.fVersion = TrajectoryExporter::fgkVersion + 1;
+    WriteFile(kCorruptPath, std::string(reinterpret_cast<const char*>(&version), sizeof(version)) + kTrajectory.substr(sizeof(version)));
+    EXPECT_FALSE(parser.open(kCorruptPath));
+
+    TrajectoryHeader chunks = header;
+    chunks.fNumChunks++;
+    WriteFile(kCorruptPath, std::string(reinterpret_cast<const char*>(&chunks), sizeof(chunks)) + kTrajectory.substr(sizeof(chunks)));
+    EXPECT_FALSE(parser.open(kCorruptPath));
+    TrajectoryFrame frame;
+    EXPECT_FALSE(parser.readTick(kObserver.fTicks[0], frame));
+
+    // a block with more vehicles than it has bytes is only found when it is read, the other chunks can still be read
+    std::string block = kTrajectory;
+    TrajectoryChunk second;
+    std::memcpy(&second, kTrajectory.data() + header.fChunksOffset + sizeof(TrajectoryChunk), sizeof(second));
+    TrajectoryBlock corrupt;
+    std::memcpy(&corrupt, block.data() + second.fOffset, sizeof(corrupt));
+    corrupt.fCount = corrupt.fBytes;
+    std::memcpy(&block[second.fOffset], &corrupt, sizeof(corrupt));
+    WriteFile(kCorruptPath, block);
+    ASSERT_TRUE(parser.open(kCorruptPath));
+    EXPECT_FALSE(parser.readTick(kObserver.fTicks[4], frame));
+    EXPECT_TRUE(parser.readTick(kObserver.fTicks[8], frame));
+    EXPECT_TRUE(parser.readTick(kObserver.fTicks[0], frame));
+    testing::internal::GetCapturedStderr();
+}
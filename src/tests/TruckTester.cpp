@@ -25,7 +25,7 @@ TEST_F(TruckTester, move1)
     const Zone* zone = new Zone(0, 100);
     Road road("E19", NULL, 5000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
     road.enqueue(vehicle);
-    vehicle->move(0,0, &road);
+    vehicle->move(0,0, &road, 0);
 
     ASSERT_EQ(vehicle->getPosition(), vehicle->getMaxAcceleration());
     ASSERT_EQ(vehicle->getVelocity(), vehicle->getMaxAcceleration());
@@ -38,7 +38,7 @@ TEST_F(TruckTester, move2)
     const Zone* zone = new Zone(0, 30);
     Road road("E19", NULL, 5000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
     road.enqueue(vehicle);
-    vehicle->move(0, 0, &road);
+    vehicle->move(0, 0, &road, 0);
 
     ASSERT_EQ(vehicle->getPosition(), 25);
     ASSERT_EQ(vehicle->getVelocity(), 25);
@@ -51,7 +51,7 @@ TEST_F(TruckTester, move3)
     const Zone* zone = new Zone(0, 30);
     Road road("E19", NULL, 5000, 1, std::vector<const Zone*>(1, zone), std::vector<const BusStop*>(), std::vector<const TrafficLight*>());
     road.enqueue(vehicle);
-    vehicle->move(0, 0, &road);
+    vehicle->move(0, 0, &road, 0);
 
 
     ASSERT_EQ(vehicle->getPosition(), 1);
@@ -8,6 +8,8 @@
 //============================================================================
 #include "Utils.h"
 #include <fstream>
+#include <gtest/gtest.h>
+#include "../parsers/NetworkParser.h"
 
 // source: Serge Demeyer - TicTactToe in C++, Ansi-style
 bool FileCompare(const std::string &leftFileName, const std::string &rightFileName) {
@@ -36,3 +38,24 @@ bool FileCompare(const std::string &leftFileName, const std::string &rightFileNa
     rightFile.close();
     return result;
 }
+
+std::string ReadFile(const std::string &fileName) {
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void WriteFile(const std::string &fileName, const std::string &data) {
+    std::ofstream file(fileName.c_str(), std::ios::binary);
+    file.write(data.data(), data.size());
+}
+
+Network *ParseTestNetwork(const std::string &fileName) {
+    NetworkParser parser;
+    return parser.parseFile("inputfiles/testinputs/" + fileName);
+}
+
+std::string RunSimulation(Network *network, ISimulationObserver *observer, const std::string &name) {
+    testing::internal::CaptureStdout();
+    network->startSimulation(observer, "testoutputs/" + name + "-Simple", "testoutputs/" + name + "-Impression");
+    return testing::internal::GetCapturedStdout();
+}
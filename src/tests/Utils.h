@@ -10,9 +10,22 @@
 #define SIMULATION_UTILS_H
 
 #include <string>
+#include "../datatypes/Network.h"
 
 bool FileCompare(const std::string &leftFileName, const std::string &rightFileName);
 
+// the bytes of the file, empty if it can not be read
+std::string ReadFile(const std::string &fileName);
+
+// replaces the file with data
+void WriteFile(const std::string &fileName, const std::string &data);
+
+// parses inputfiles/testinputs/fileName, NULL if it is no valid network
+Network *ParseTestNetwork(const std::string &fileName);
+
+// runs the simulation until it stops, the simple and impression output go to outputfiles/testoutputs/name-Simple.txt
+// and outputfiles/testoutputs/name-Impression.txt. Returns what the simulation printed.
+std::string RunSimulation(Network *network, ISimulationObserver *observer, const std::string &name);
 
 
 #endif //SIMULATION_UTILS_H